@@ -2,6 +2,7 @@
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 #include <Swoosh/EmbedGLSL.h>
+#include "SegueTargets.h"
 
 using namespace swoosh;
 
@@ -70,9 +71,23 @@ namespace {
 template<int cols, int rows>
 class CheckerboardCustom : public Segue {
 private:
-  sf::Texture* temp, * temp2;
-  sf::Shader shader;
-  bool loaded;
+  /**
+   * @brief Compiled once for each board size
+   */
+  static sf::Shader& GetShader() {
+    static sf::Shader shader;
+    static bool loaded = false;
+
+    if (!loaded) {
+      SegueTargets::LoadShader(shader, ::CHECKERBOARD_FRAG_SHADER);
+      shader.setUniform("cols", cols);
+      shader.setUniform("rows", rows);
+      shader.setUniform("smoothness", 0.09f);
+      loaded = true;
+    }
+
+    return shader;
+  }
 
 public:
   virtual void onDraw(sf::RenderTexture& surface) {
@@ -80,93 +95,33 @@ public:
     double duration = getDuration().asMilliseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
 
-    this->drawLastActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-#ifdef __ANDROID__
-    if (!loaded) {
-        temp = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
-        temp->flip(true);
-    }
-#else
-    temp = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
-#endif
-
-    sf::Sprite sprite(*temp);
-
-    surface.clear(sf::Color::Transparent);
-    this->drawNextActivity(surface);
+    sf::RenderTexture& last = SegueTargets::First(surface);
+    this->drawLastActivity(last);
+    last.display(); // flip and ready the buffer
 
-    surface.display(); // flip and ready the buffer
-
-#ifdef __ANDROID__
-if(!loaded) {
-    temp2 = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    temp2->flip(true);
-    loaded = true;
-}
-#else
-    temp2 = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
-#endif
+    sf::RenderTexture& next = SegueTargets::Second(surface);
+    this->drawNextActivity(next);
+    next.display(); // flip and ready the buffer
 
+    sf::Shader& shader = GetShader();
     shader.setUniform("progress", (float)alpha);
-    shader.setUniform("texture2", *temp2);
-    shader.setUniform("texture", *temp);
+    shader.setUniform("texture2", next.getTexture());
+    shader.setUniform("texture", last.getTexture());
+
+    sf::Sprite sprite(last.getTexture());
 
     sf::RenderStates states;
     states.shader = &shader;
 
     surface.draw(sprite, states);
-
-#ifndef __ANDROID__
-    delete temp;
-    delete temp2;
-#endif
   }
 
   CheckerboardCustom(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
     /* ... */
-    temp = nullptr;
-    temp2 = nullptr;
-
-    // only used on mobile hardware
-    loaded = false;
-
-#ifdef __ANDROID__
-    shader.loadFromMemory("uniform mat4 viewMatrix;\n"
-                          "uniform mat4 projMatrix;\n"
-                          "uniform mat4 textMatrix;\n"
-                          " \n"
-                          "attribute vec2 position;\n"
-                          "attribute vec4 color;\n"
-                          "attribute vec2 texCoord;\n"
-                          "\n"
-                          "varying vec4 vColor;\n"
-                          "varying vec2 vTexCoord;\n"
-                          " \n"
-                          "void main()\n"
-                          "{\n"
-                          "    gl_Position = projMatrix * viewMatrix * vec4(position, 0.0, 1.0);\n"
-                          "    vColor = color;\n"
-                          "    vTexCoord = (textMatrix * vec4(texCoord.xy, 0.0, 1.0)).xy;\n"
-                          "}", ::CHECKERBOARD_FRAG_SHADER );
-
-#else
-    shader.loadFromMemory(::CHECKERBOARD_FRAG_SHADER, sf::Shader::Fragment);
-#endif
-
-    shader.setUniform("cols", cols);
-    shader.setUniform("rows", rows);
-    shader.setUniform("smoothness", 0.09f);
+    GetShader();
   }
 
-  virtual ~CheckerboardCustom() {
-#ifdef __ANDROID__
-      if(temp) delete temp;
-      if(temp2) delete temp2;
-#endif
-  }
+  virtual ~CheckerboardCustom() { ; }
 };
 
 using Checkerboard = CheckerboardCustom<10, 10>;
@@ -2,6 +2,7 @@
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 #include <Swoosh/EmbedGLSL.h>
+#include "SegueTargets.h"
 
 using namespace swoosh;
 
@@ -88,8 +89,21 @@ namespace {
 template<int percent_power> // divided by 100 to yeild %
 class CrossZoomCustom : public Segue {
 private:
-  sf::Texture* temp;
-  sf::Shader shader;
+  /**
+   * @brief Compiled once for each strength
+   */
+  static sf::Shader& GetShader() {
+    static sf::Shader shader;
+    static bool loaded = false;
+
+    if (!loaded) {
+      shader.loadFromMemory(::CROSSZOOM_FRAG_SHADER, sf::Shader::Fragment);
+      shader.setUniform("strength", (float)percent_power/100.0f);
+      loaded = true;
+    }
+
+    return shader;
+  }
 
 public:
   virtual void onDraw(sf::RenderTexture& surface) {
@@ -97,25 +111,20 @@ public:
     double duration = getDuration().asMilliseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
 
-    this->drawLastActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-    if (temp) delete temp;
-    temp = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
-
-    sf::Sprite sprite(*temp);
+    sf::RenderTexture& last = SegueTargets::First(surface);
+    this->drawLastActivity(last);
+    last.display(); // flip and ready the buffer
 
-    surface.clear(sf::Color::Transparent);
-    this->drawNextActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-    sf::Texture* temp2 = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
+    sf::RenderTexture& next = SegueTargets::Second(surface);
+    this->drawNextActivity(next);
+    next.display(); // flip and ready the buffer
 
+    sf::Shader& shader = GetShader();
     shader.setUniform("progress", (float)alpha);
-    shader.setUniform("texture2", *temp2);
-    shader.setUniform("texture", *temp);
+    shader.setUniform("texture2", next.getTexture());
+    shader.setUniform("texture", last.getTexture());
+
+    sf::Sprite sprite(last.getTexture());
 
     sf::RenderStates states;
     states.shader = &shader;
@@ -125,11 +134,7 @@ public:
 
   CrossZoomCustom(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
     /* ... */
-    temp = nullptr;
-
-    shader.loadFromMemory(::CROSSZOOM_FRAG_SHADER, sf::Shader::Fragment);
-    shader.setUniform("strength", (float)percent_power/100.0f);
-
+    GetShader();
   }
 
   virtual ~CrossZoomCustom() { ; }
@@ -2,6 +2,7 @@
 #include <Swoosh/EmbedGLSL.h>
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
+#include "SegueTargets.h"
 
 using namespace swoosh;
 
@@ -106,8 +107,21 @@ namespace {
 template<int direction>
 class DiamondTileSwipe : public Segue {
 private:
-  sf::Texture* temp;
-  sf::Shader shader;
+  /**
+   * @brief Compiled once for each direction
+   */
+  static sf::Shader& GetShader() {
+    static sf::Shader shader;
+    static bool loaded = false;
+
+    if (!loaded) {
+      SegueTargets::LoadShader(shader, ::DIAMOND_SHADER);
+      shader.setUniform("direction", direction);
+      loaded = true;
+    }
+
+    return shader;
+  }
 
 public:
   virtual void onDraw(sf::RenderTexture& surface) {
@@ -115,27 +129,21 @@ public:
     double duration = getDuration().asMilliseconds();
     double alpha = ease::wideParabola(elapsed, duration, 1.0);
 
+    sf::RenderTexture& target = SegueTargets::First(surface);
+
     if (elapsed < duration * 0.5)
-      this->drawLastActivity(surface);
+      this->drawLastActivity(target);
     else
-      this->drawNextActivity(surface);
+      this->drawNextActivity(target);
 
-    surface.display(); // flip and ready the buffer
+    target.display(); // flip and ready the buffer
 
-    if (temp) delete temp;
-
-    temp = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
-
-#ifdef __ANDROID__
-    temp->flip(true);
-#endif
-
-    sf::Sprite sprite(*temp);
-
-    shader.setUniform("texture", *temp);
-    shader.setUniform("direction", direction);
+    sf::Shader& shader = GetShader();
+    shader.setUniform("texture", target.getTexture());
     shader.setUniform("time", (float)alpha);
 
+    sf::Sprite sprite(target.getTexture());
+
     sf::RenderStates states;
     states.shader = &shader;
 
@@ -144,30 +152,8 @@ public:
 
   DiamondTileSwipe(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
     /* ... */
-    temp = nullptr;
-
-#ifdef __ANDROID__
-    shader.loadFromMemory("uniform mat4 viewMatrix;\n"
-                        "uniform mat4 projMatrix;\n"
-                        "uniform mat4 textMatrix;\n"
-                        " \n"
-                        "attribute vec2 position;\n"
-                        "attribute vec4 color;\n"
-                        "attribute vec2 texCoord;\n"
-                        "\n"
-                        "varying vec4 vColor;\n"
-                        "varying vec2 vTexCoord;\n"
-                        " \n"
-                        "void main()\n"
-                        "{\n"
-                        "    gl_Position = projMatrix * viewMatrix * vec4(position, 0.0, 1.0);\n"
-                        "    vColor = color;\n"
-                        "    vTexCoord = (textMatrix * vec4(texCoord.xy, 0.0, 1.0)).xy;\n"
-                        "}", ::DIAMOND_SHADER);
-#else
-    shader.loadFromMemory(::DIAMOND_SHADER, sf::Shader::Fragment);
-#endif
+    GetShader();
   }
 
-  virtual ~DiamondTileSwipe() { if (temp) { delete temp; } }
+  virtual ~DiamondTileSwipe() { ; }
 };
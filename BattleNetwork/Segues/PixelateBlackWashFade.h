@@ -1,6 +1,7 @@
 #pragma once
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
+#include "SegueTargets.h"
 #include <Swoosh/EmbedGLSL.h>
 
 using namespace swoosh;
@@ -53,12 +54,20 @@ namespace {
 
 class PixelateBlackWashFade : public Segue {
 private:
-    sf::Shader shader;
-    float factor;
-    bool loaded;
-    bool nextScreen;
+    /**
+     * @brief Compiled the first time a PixelateBlackWashFade is made
+     */
+    static sf::Shader& GetShader() {
+        static sf::Shader shader;
+        static bool loaded = false;
 
-    sf::Texture *temp;
+        if (!loaded) {
+            SegueTargets::LoadShader(shader, ::PIXELATE_SHADER);
+            loaded = true;
+        }
+
+        return shader;
+    }
 
 public:
     virtual void onDraw(sf::RenderTexture &surface) {
@@ -66,33 +75,21 @@ public:
         double duration = getDuration().asMilliseconds();
         double alpha = ease::wideParabola(elapsed, duration, 1.0);
 
+        sf::RenderTexture& target = SegueTargets::First(surface);
+
         if (elapsed <= duration * 0.5)
-            this->drawLastActivity(surface);
-        else {
-            if (loaded && !nextScreen) {
-                loaded = false;
-                nextScreen = true;
-            }
-
-            this->drawNextActivity(surface);
-        }
+            this->drawLastActivity(target);
+        else
+            this->drawNextActivity(target);
 
-        surface.display();
+        target.display();
 
-#ifdef __ANDROID__
-        if (!loaded) {
-            temp = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
-            temp->flip(true);
-            loaded = true;
-        }
-#else
-        temp = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
-#endif
+        sf::Shader& shader = GetShader();
+        shader.setUniform("texture", target.getTexture());
+        shader.setUniform("pixel_threshold", (float) alpha / 15.0f);
 
-        sf::Sprite sprite(*temp);
+        sf::Sprite sprite(target.getTexture());
 
-        shader.setUniform("texture", *temp);
-        shader.setUniform("pixel_threshold", (float) alpha / 15.0f);
         sf::RenderStates states;
         states.shader = &shader;
 
@@ -114,38 +111,8 @@ public:
 
     PixelateBlackWashFade(sf::Time duration, Activity *last, Activity *next) : Segue(duration, last,
                                                                                      next) {
-        loaded = nextScreen = false;
-
-#ifdef __ANDROID__
-        shader.loadFromMemory("uniform mat4 viewMatrix;\n"
-                              "uniform mat4 projMatrix;\n"
-                              "uniform mat4 textMatrix;\n"
-                              " \n"
-                              "attribute vec2 position;\n"
-                              "attribute vec4 color;\n"
-                              "attribute vec2 texCoord;\n"
-                              "\n"
-                              "varying vec4 vColor;\n"
-                              "varying vec2 vTexCoord;\n"
-                              " \n"
-                              "void main()\n"
-                              "{\n"
-                              "    gl_Position = projMatrix * viewMatrix * vec4(position, 0.0, 1.0);\n"
-                              "    vColor = color;\n"
-                              "    vTexCoord = (textMatrix * vec4(texCoord.xy, 0.0, 1.0)).xy;\n"
-                              "}", ::PIXELATE_SHADER);
-
-#else
-        shader.loadFromMemory(::PIXELATE_SHADER, sf::Shader::Fragment);
-#endif
+        GetShader();
     }
 
-    virtual ~PixelateBlackWashFade() {
-#ifdef __ANDROID__
-        if (temp) {
-            delete temp;
-        }
-#endif
-    }
+    virtual ~PixelateBlackWashFade() { ; }
 };
-
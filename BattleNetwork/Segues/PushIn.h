@@ -1,15 +1,12 @@
 #pragma once
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
+#include "SegueTargets.h"
 
 using namespace swoosh;
 
 template<int direction>
 class PushIn : public Segue {
-private:
-    sf::Texture temp, temp2;
-    bool loaded;
-
 public:
 
     virtual void onDraw(sf::RenderTexture& surface) {
@@ -17,21 +14,12 @@ public:
         double duration = getDuration().asMilliseconds();
         double alpha = ease::linear(elapsed, duration, 1.0);
 
-        surface.clear(this->getLastActivityBGColor());
-        this->drawLastActivity(surface);
-
-        surface.display(); // flip and ready the buffer
+        sf::RenderTexture& last = SegueTargets::First(surface, this->getLastActivityBGColor());
+        this->drawLastActivity(last);
 
-#ifdef __ANDROID__
-        if(!loaded) {
-                temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-                temp.flip(true);
-        }
-#else
-        temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-#endif
+        last.display(); // flip and ready the buffer
 
-        sf::Sprite left(temp);
+        sf::Sprite left(last.getTexture());
 
         int lr = 0;
         int ud = 0;
@@ -43,24 +31,12 @@ public:
 
         left.setPosition((float)(lr * alpha * left.getTexture()->getSize().x), (float)(ud * alpha * left.getTexture()->getSize().y));
 
-        surface.clear(this->getNextActivityBGColor());
-
-        this->drawNextActivity(surface);
-
-        surface.display(); // flip and ready the buffer
-
+        sf::RenderTexture& next = SegueTargets::Second(surface, this->getNextActivityBGColor());
+        this->drawNextActivity(next);
 
-#ifdef __ANDROID__
-        if(!loaded) {
-                temp2 = sf::Texture(surface.getTexture());
-                temp2.flip(true);
-                loaded = true; // both textures are loaded by now
-        }
-#else
-       temp2 = sf::Texture(surface.getTexture());
-#endif
+        next.display(); // flip and ready the buffer
 
-        sf::Sprite right(temp2);
+        sf::Sprite right(next.getTexture());
 
         right.setPosition((float)(-lr * (1.0-alpha) * right.getTexture()->getSize().x), (float)(-ud * (1.0-alpha) * right.getTexture()->getSize().y));
 
@@ -70,7 +46,6 @@ public:
 
     PushIn(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
         /* ... */
-        loaded = false;
     }
 
     virtual ~PushIn() { }
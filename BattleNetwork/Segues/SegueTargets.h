@@ -0,0 +1,89 @@
+#pragma once
+#include <string>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+
+/**
+ * @class SegueTargets
+ * @author mav
+ * @date 10/19/20
+ * @brief A pair of render targets shared by every segue for the life of the program
+ *
+ * Segues draw the last activity into First() and the next activity into Second()
+ * and give the textures of those targets straight to their sprites and shaders.
+ * Nothing is copied or allocated per frame. The targets are only recreated when the
+ * surface changes size.
+ *
+ * Only one segue draws at a time so every segue can share the same pair.
+ */
+class SegueTargets {
+public:
+  /**
+   * @brief Target for the last activity, sized to the surface and cleared
+   * @param surface the surface the segue will draw into at the end
+   * @param color clear color
+   * @return sf::RenderTexture&
+   */
+  static sf::RenderTexture& First(const sf::RenderTexture& surface, const sf::Color& color = sf::Color::Transparent) {
+    return Prepare(0, surface, color);
+  }
+
+  /**
+   * @brief Target for the next activity, sized to the surface and cleared
+   * @param surface the surface the segue will draw into at the end
+   * @param color clear color
+   * @return sf::RenderTexture&
+   */
+  static sf::RenderTexture& Second(const sf::RenderTexture& surface, const sf::Color& color = sf::Color::Transparent) {
+    return Prepare(1, surface, color);
+  }
+
+  /**
+   * @brief Compile a segue fragment shader. Adds the vertex shader mobile hardware needs.
+   * @param shader shader to load
+   * @param frag fragment shader source
+   * @return true if the shader compiled
+   *
+   * Segues keep one shader per type in a function-local static and only call this once.
+   */
+  static const bool LoadShader(sf::Shader& shader, const std::string& frag) {
+#ifdef __ANDROID__
+    return shader.loadFromMemory("uniform mat4 viewMatrix;\n"
+                                 "uniform mat4 projMatrix;\n"
+                                 "uniform mat4 textMatrix;\n"
+                                 " \n"
+                                 "attribute vec2 position;\n"
+                                 "attribute vec4 color;\n"
+                                 "attribute vec2 texCoord;\n"
+                                 "\n"
+                                 "varying vec4 vColor;\n"
+                                 "varying vec2 vTexCoord;\n"
+                                 " \n"
+                                 "void main()\n"
+                                 "{\n"
+                                 "    gl_Position = projMatrix * viewMatrix * vec4(position, 0.0, 1.0);\n"
+                                 "    vColor = color;\n"
+                                 "    vTexCoord = (textMatrix * vec4(texCoord.xy, 0.0, 1.0)).xy;\n"
+                                 "}", frag);
+#else
+    return shader.loadFromMemory(frag, sf::Shader::Fragment);
+#endif
+  }
+
+private:
+  static sf::RenderTexture& Prepare(int index, const sf::RenderTexture& surface, const sf::Color& color) {
+    static sf::RenderTexture targets[2];
+
+    sf::RenderTexture& target = targets[index];
+
+    if (target.getSize() != surface.getSize()) {
+      target.create(surface.getSize().x, surface.getSize().y);
+    }
+
+    // Activities draw with the same view they would use on the surface
+    target.setView(surface.getView());
+    target.clear(color);
+
+    return target;
+  }
+};
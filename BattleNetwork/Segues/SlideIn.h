@@ -1,14 +1,12 @@
 #pragma once
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
+#include "SegueTargets.h"
 
 using namespace swoosh;
 
 template<int direction>
 class SlideIn : public Segue {
-private:
-  sf::Texture* temp;
-
 public:
 
   virtual void onDraw(sf::RenderTexture& surface) {
@@ -16,14 +14,12 @@ public:
     double duration = getDuration().asMilliseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
 
-    this->drawLastActivity(surface);
-
-    surface.display(); // flip and ready the buffer
+    sf::RenderTexture& last = SegueTargets::First(surface);
+    this->drawLastActivity(last);
 
-    if (temp) delete temp;
-    temp = new sf::Texture(surface.getTexture()); // Make a copy of the source texture
+    last.display(); // flip and ready the buffer
 
-    sf::Sprite left(*temp); 
+    sf::Sprite left(last.getTexture());
 
     int lr = 0;
     int ud = 0;
@@ -33,12 +29,11 @@ public:
     if (direction == 2) ud = -1;
     if (direction == 3) ud = 1;
 
-    surface.clear();
-
-    this->drawNextActivity(surface);
+    sf::RenderTexture& next = SegueTargets::Second(surface);
+    this->drawNextActivity(next);
 
-    surface.display(); // flip and ready the buffer
-    sf::Sprite right(surface.getTexture());
+    next.display(); // flip and ready the buffer
+    sf::Sprite right(next.getTexture());
 
     right.setPosition(-lr * (1-alpha) * right.getTexture()->getSize().x, -ud * (1-alpha) * right.getTexture()->getSize().y);
 
@@ -51,7 +46,6 @@ public:
 
   SlideIn(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) { 
     /* ... */ 
-    temp = nullptr;
   }
 
   virtual ~SlideIn() { ; }
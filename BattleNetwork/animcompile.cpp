@@ -0,0 +1,115 @@
+/*! \brief Compiles every .animation file under a directory into .animb files
+ *
+ * Built as the BattleNetworkAnimationCompiler target. Run it from the BattleNetwork
+ * directory, optionally with the directories to compile. The default is resources.
+ *
+ * Each compiled file is read back and checked against the text file. The time to
+ * load every file as text and as compiled is printed at the end as CSV:
+ *   format,files,bytes,ms
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bnAnimation.h"
+
+namespace {
+  /**
+   * @brief True if both sets of frame lists hold the same frames and points
+   */
+  const bool IsSame(std::map<std::string, FrameList>& a, std::map<std::string, FrameList>& b) {
+    if (a.size() != b.size()) return false;
+
+    for (auto& [state, list] : a) {
+      auto other = b.find(state);
+
+      if (other == b.end() || list.GetFrameCount() != other->second.GetFrameCount()) return false;
+
+      for (size_t i = 0; i < list.GetFrameCount(); i++) {
+        const Frame& x = list.GetFrame((int)i);
+        const Frame& y = other->second.GetFrame((int)i);
+
+        if (x.duration != y.duration || x.subregion != y.subregion || x.applyOrigin != y.applyOrigin
+          || x.origin != y.origin || x.points != y.points) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Milliseconds to load every path with load
+   */
+  double Time(const std::vector<std::string>& paths, bool (*load)(const std::string&)) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (const std::string& path : paths) {
+      load(path);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+  }
+}
+
+int main(int argc, char** argv) {
+  std::vector<std::string> roots;
+
+  for (int i = 1; i < argc; i++) {
+    roots.push_back(argv[i]);
+  }
+
+  if (roots.empty()) {
+    roots.push_back("resources");
+  }
+
+  std::vector<std::string> paths;
+  std::error_code error;
+  uintmax_t textBytes = 0, compiledBytes = 0;
+  unsigned failed = 0;
+
+  for (const std::string& root : roots) {
+    for (auto& entry : std::filesystem::recursive_directory_iterator(root, error)) {
+      if (entry.path().extension() != ANIMATION_EXTENSION) continue;
+
+      std::string path = entry.path().generic_string();
+
+      std::map<std::string, FrameList> text, compiled;
+      Animation::LoadText(path, text);
+
+      if (!Animation::Compile(path) || !Animation::LoadCompiled(path, compiled) || !IsSame(text, compiled)) {
+        std::cerr << "failed to compile " << path << std::endl;
+        failed++;
+        continue;
+      }
+
+      paths.push_back(path);
+      textBytes += std::filesystem::file_size(path, error);
+      compiledBytes += std::filesystem::file_size(Animation::CompiledPath(path), error);
+    }
+  }
+
+  double textMs = Time(paths, [](const std::string& path) {
+    std::map<std::string, FrameList> out;
+    Animation::LoadText(path, out);
+    return !out.empty();
+  });
+
+  double compiledMs = Time(paths, [](const std::string& path) {
+    std::map<std::string, FrameList> out;
+    return Animation::LoadCompiled(path, out);
+  });
+
+  std::cout << "format,files,bytes,ms" << std::endl;
+  std::cout << "text," << paths.size() << "," << textBytes << "," << textMs << std::endl;
+  std::cout << "compiled," << paths.size() << "," << compiledBytes << "," << compiledMs << std::endl;
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,641 @@
+/*! \brief Battle simulation and content loading benchmarks
+ *
+ * Built as the BattleNetworkBench target. Run it from the BattleNetwork
+ * directory so resources/ can be found.
+ *
+ * Prints one CSV row per scenario on stdout:
+ *   scenario,ops,ns_per_op,allocs_per_op,bytes_per_op
+ *
+ * Allocations are counted by replacing the global operator new, so every
+ * allocation made while an op runs is included.
+ *
+ * Pass one or more names to only run scenarios whose name contains one of them.
+ *
+ * The script scenarios clear the compiled script cache under cache/scripts.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "bnTextureResourceManager.h"
+#include "bnShaderResourceManager.h"
+#include "bnAudioResourceManager.h"
+#include "bnNaviRegistration.h"
+#include "bnQueueNaviRegistration.h"
+#include "bnBattleContext.h"
+#include "bnBattleServer.h"
+#include "bnField.h"
+#include "bnTile.h"
+#include "bnMettaur.h"
+#include "bnVulcan.h"
+#include "bnBees.h"
+#include "bnAlphaBossFight.h"
+#include "bnMetalManBossFight.h"
+#include "bnAnimation.h"
+#include "bnPA.h"
+#include "bnChip.h"
+#include "bnChipLibrary.h"
+#include "bnTextBox.h"
+#include "bnScriptResourceManager.h"
+#include "bnScriptedCharacter.h"
+#include "bnLogger.h"
+
+// GBA draws 60 frames in one seconds
+#define FIXED_TIME_STEP 1.0f/60.0f
+
+namespace {
+  std::atomic<unsigned long long> allocCount(0), allocBytes(0);
+}
+
+void* operator new(std::size_t size) {
+  allocCount.fetch_add(1, std::memory_order_relaxed);
+  allocBytes.fetch_add(size, std::memory_order_relaxed);
+
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+  std::vector<std::string> filters;
+
+  const bool IsSelected(const std::string& name) {
+    if (filters.empty()) return true;
+
+    for (const std::string& f : filters) {
+      if (name.find(f) != std::string::npos) return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Run op up to ops times and print the cost of one op
+   * @param name scenario name
+   * @param ops number of times to run op
+   * @param op returns false to stop early
+   *
+   * A tenth of the ops are run first and not measured.
+   */
+  void Measure(const std::string& name, unsigned ops, const std::function<bool()>& op) {
+    for (unsigned i = 0; i < ops / 10; i++) {
+      if (!op()) break;
+    }
+
+    unsigned long long count = allocCount.load();
+    unsigned long long bytes = allocBytes.load();
+    unsigned done = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (done < ops && op()) {
+      done++;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    count = allocCount.load() - count;
+    bytes = allocBytes.load() - bytes;
+
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double n = done ? (double)done : 1.0;
+
+    std::cout << name << "," << done << "," << ns / n << "," << count / n << "," << bytes / n << std::endl;
+  }
+
+  /**
+   * @brief Field update with mettaurs filling the field from the left. Each side targets the other.
+   */
+  void FieldUpdateMettaurs(int count) {
+    std::string name = "field_update_mettaurs_" + std::to_string(count);
+    if (!IsSelected(name)) return;
+
+    BattleContext context(1);
+    context.Bind();
+
+    Field* field = new Field(6, 3);
+    field->SetBattleActive(true);
+
+    for (int i = 0; i < count && i < 18; i++) {
+      int x = (i % 6) + 1;
+      int y = (i / 6) + 1;
+
+      Mettaur* met = new Mettaur();
+      met->SetTeam(x <= 3 ? Team::RED : Team::BLUE);
+      met->SetHealth(9999);
+      field->AddEntity(*met, x, y);
+    }
+
+    Measure(name, 3600, [field]() {
+      field->Update(FIXED_TIME_STEP);
+      field->GetEventBus().Dispatch();
+      return true;
+    });
+
+    delete field;
+    context.Unbind();
+  }
+
+  /**
+   * @brief Field update after blue steals two of red's columns. The columns go back once their cooldown ends.
+   */
+  void FieldUpdateStolen() {
+    std::string name = "field_update_stolen";
+    if (!IsSelected(name)) return;
+
+    BattleContext context(1);
+    context.Bind();
+
+    Field* field = new Field(6, 3);
+    field->SetBattleActive(true);
+
+    Mettaur* met = new Mettaur();
+    met->SetTeam(Team::BLUE);
+    met->SetHealth(9999);
+    field->AddEntity(*met, 5, 2);
+
+    for (int y = 1; y <= 3; y++) {
+      field->SetAt(2, y, Team::BLUE);
+      field->SetAt(3, y, Team::BLUE);
+    }
+
+    Measure(name, 3600, [field]() {
+      field->Update(FIXED_TIME_STEP);
+      field->GetEventBus().Dispatch();
+      return true;
+    });
+
+    delete field;
+    context.Unbind();
+  }
+
+  /**
+   * @brief Find every enemy character on a field of 18 mettaurs
+   * @param buffered if true the query writes into a buffer kept between ops
+   */
+  void FieldFindEntities(bool buffered) {
+    std::string name = buffered ? "field_find_entities_buffer" : "field_find_entities";
+    if (!IsSelected(name)) return;
+
+    BattleContext context(1);
+    context.Bind();
+
+    Field* field = new Field(6, 3);
+
+    for (int i = 0; i < 18; i++) {
+      Mettaur* met = new Mettaur();
+      met->SetTeam((i % 6) < 3 ? Team::RED : Team::BLUE);
+      field->AddEntity(*met, (i % 6) + 1, (i / 6) + 1);
+    }
+
+    auto query = [](Entity* e) { return e->GetTeam() == Team::BLUE; };
+    std::vector<Entity*> found;
+
+    Measure(name, 100000, [&]() {
+      if (buffered) {
+        field->FindEntities(found, query);
+      }
+      else {
+        found = field->FindEntities(query);
+      }
+
+      return found.size() == 9;
+    });
+
+    delete field;
+    context.Unbind();
+  }
+
+  /**
+   * @brief Red side fires a spell down every row on a timer at mettaurs that cannot die
+   * @param spawn makes one spell for the red team
+   * @param period frames between volleys
+   */
+  void SpellStorm(const std::string& name, const std::function<Spell*(Field*)>& spawn, unsigned period) {
+    if (!IsSelected(name)) return;
+
+    BattleContext context(1);
+    context.Bind();
+
+    Field* field = new Field(6, 3);
+    field->SetBattleActive(true);
+
+    for (int y = 1; y <= 3; y++) {
+      Mettaur* met = new Mettaur();
+      met->SetTeam(Team::BLUE);
+      met->SetHealth(999999);
+      field->AddEntity(*met, 5, y);
+    }
+
+    unsigned frame = 0;
+
+    Measure(name, 3600, [&]() {
+      if (frame++ % period == 0) {
+        for (int y = 1; y <= 3; y++) {
+          Spell* spell = spawn(field);
+          spell->SetDirection(Direction::RIGHT);
+          field->AddEntity(*spell, 1, y);
+        }
+      }
+
+      field->Update(FIXED_TIME_STEP);
+      field->GetEventBus().Dispatch();
+      return true;
+    });
+
+    delete field;
+    context.Unbind();
+  }
+
+  /**
+   * @brief A full battle against a boss with the server bot playing. One op is one frame.
+   */
+  void BossFight(const std::string& name, const std::function<Mob*(Field*)>& buildMob) {
+    if (!IsSelected(name) || NAVIS.Size() == 0) return;
+
+    BattleContext context(1);
+    context.Load(0, buildMob);
+
+    Measure(name, 3600, [&context]() {
+      if (context.IsOver()) return false;
+
+      BattleServer::Drive(context);
+      context.Step(FIXED_TIME_STEP);
+      return true;
+    });
+  }
+
+  /**
+   * @brief Load every animation file under resources. One op is one file.
+   * @param cached if false the parse cache is cleared before every load
+   */
+  void AnimationReload(bool cached) {
+    std::string name = cached ? "animation_reload_all_cached" : "animation_reload_all";
+    if (!IsSelected(name)) return;
+
+    std::vector<std::string> paths;
+    std::error_code error;
+
+    for (auto& entry : std::filesystem::recursive_directory_iterator("resources", error)) {
+      if (entry.path().extension() == ".animation") {
+        paths.push_back(entry.path().generic_string());
+      }
+    }
+
+    if (paths.empty()) return;
+
+    Animation animation;
+    size_t next = 0;
+
+    Measure(name, (unsigned)paths.size() * 5, [&]() {
+      if (!cached) {
+        Animation::ClearCache();
+      }
+
+      animation = Animation(paths[next++ % paths.size()]);
+      return true;
+    });
+  }
+
+  /**
+   * @brief Write a script to the temp directory and register it
+   * @param name of the script and its file
+   * @param source lua source
+   * @return name of the script
+   */
+  const std::string WriteBenchScript(const std::string& name, const std::string& source) {
+    std::string path = (std::filesystem::temp_directory_path() / ("obn_" + name + ".lua")).generic_string();
+    std::ofstream(path) << source;
+
+    ScriptResourceManager::FileMeta meta;
+    meta.type = ScriptMetaType::CHARACTER_SCRIPT;
+    meta.path = path;
+    meta.name = name;
+    SCRIPTS.AddToPaths(meta);
+
+    return name;
+  }
+
+  /**
+   * @brief A character script with a small update hook and many functions for the parser
+   */
+  const std::string WriteBenchScript() {
+    static std::string name;
+
+    if (!name.empty()) return name;
+
+    std::string source =
+      "function on_update(view, commands)\n"
+      "  view.frames = (view.frames or 0) + 1\n"
+      "  if view.health < view.maxHealth then\n"
+      "    commands:EndTurn()\n"
+      "  end\n"
+      "end\n";
+
+    for (int i = 0; i < 200; i++) {
+      source += "function helper_" + std::to_string(i) + "(a, b)\n"
+                "  local t = { a, b, " + std::to_string(i) + " }\n"
+                "  return t[1] * t[3] + t[2]\n"
+                "end\n";
+    }
+
+    name = WriteBenchScript("bench_character", source);
+    return name;
+  }
+
+  /**
+   * @brief The mettaur AI as a script. Idles on its turn, lines up with its target and sends a wave.
+   */
+  const std::string WriteMettaurScript() {
+    static std::string name;
+
+    if (!name.empty()) return name;
+
+    name = WriteBenchScript("bench_mettaur",
+      "name = 'Mettaur'\n"
+      "texturePath = 'resources/mobs/mettaur/mettaur.png'\n"
+      "animationPath = 'resources/mobs/mettaur/mettaur.animation'\n"
+      "health = 40\n"
+      "height = 60\n"
+      "animations = { 'IDLE', 'MOVING', 'ATTACK' }\n"
+      "\n"
+      "local IDLE, MOVING, ATTACK = 1, 2, 3\n"
+      "local UP, DOWN, LEFT = Battle.Direction.UP, Battle.Direction.DOWN, Battle.Direction.LEFT\n"
+      "local WAVE = Battle.Spell.WAVE\n"
+      "\n"
+      "local function idle(view, commands)\n"
+      "  view.state = 'idle'\n"
+      "  view.cooldown = 0.5\n"
+      "  commands:Animate(IDLE)\n"
+      "end\n"
+      "\n"
+      "function on_update(view, commands)\n"
+      "  local state = view.state or 'idle'\n"
+      "\n"
+      "  if state == 'idle' then\n"
+      "    if not view.isMyTurn then return end\n"
+      "    view.cooldown = (view.cooldown or 0.5) - view.elapsed\n"
+      "    if view.cooldown < 0 then view.state = 'move' end\n"
+      "  elseif state == 'move' then\n"
+      "    if view.isMoving then return end\n"
+      "    if view.isBlocked then\n"
+      "      view.moved = false\n"
+      "      idle(view, commands)\n"
+      "      commands:EndTurn()\n"
+      "    elseif view.moved then\n"
+      "      view.moved = false\n"
+      "      idle(view, commands)\n"
+      "    elseif view.targetY < view.y then\n"
+      "      commands:Move(UP, MOVING)\n"
+      "      view.moved = true\n"
+      "    elseif view.targetY > view.y then\n"
+      "      commands:Move(DOWN, MOVING)\n"
+      "      view.moved = true\n"
+      "    else\n"
+      "      view.state = 'attack'\n"
+      "      commands:Animate(ATTACK)\n"
+      "      commands:Counter(3, 8)\n"
+      "    end\n"
+      "  elseif state == 'attack' then\n"
+      "    if view.isAnimating then return end\n"
+      "    commands:Spawn(WAVE, -1, 0, LEFT)\n"
+      "    idle(view, commands)\n"
+      "    commands:EndTurn()\n"
+      "  end\n"
+      "end\n");
+
+    return name;
+  }
+
+  /**
+   * @brief Load one script into a new environment
+   * @param cached if false the chunk cache is cleared before every load and the source is parsed
+   */
+  void ScriptLoad(bool cached) {
+    std::string name = cached ? "script_load_bytecode" : "script_load_source";
+    if (!IsSelected(name)) return;
+
+    const std::string script = WriteBenchScript();
+
+    Measure(name, 500, [&]() {
+      if (!cached) {
+        SCRIPTS.ClearChunkCache();
+      }
+
+      return SCRIPTS.ReloadScript(script);
+    });
+  }
+
+  /**
+   * @brief Update a character on the field. With a script its on_update hook runs every frame.
+   * @param scripted if false the character has no hooks. The difference is the cost of the hook.
+   */
+  void ScriptedCharacterUpdate(bool scripted) {
+    std::string name = scripted ? "script_character_update_hook" : "script_character_update_native";
+    if (!IsSelected(name)) return;
+
+    const std::string script = WriteBenchScript();
+
+    if (scripted && !SCRIPTS.ReloadScript(script)) return;
+
+    BattleContext context(1);
+    context.Bind();
+
+    Field* field = new Field(6, 3);
+    field->SetBattleActive(true);
+
+    ScriptedCharacter* character = new ScriptedCharacter(Character::Rank::_1);
+    character->SetTeam(Team::BLUE);
+    character->SetHealth(100);
+    field->AddEntity(*character, 5, 2);
+
+    if (scripted) {
+      character->SetScript(script);
+    }
+
+    Measure(name, 100000, [character]() {
+      character->Update(FIXED_TIME_STEP);
+      return true;
+    });
+
+    delete field;
+    context.Unbind();
+  }
+
+  /**
+   * @brief Ten mettaurs on the blue side attack a target that cannot die. One op is one frame.
+   * @param scripted if true the mettaurs are scripted characters running the mettaur script
+   */
+  void MettaurMob(bool scripted) {
+    std::string name = scripted ? "mob_mettaur_scripted_10" : "mob_mettaur_native_10";
+    if (!IsSelected(name)) return;
+
+    const std::string script = WriteMettaurScript();
+
+    if (scripted && !SCRIPTS.ReloadScript(script)) return;
+
+    BattleContext context(1);
+    context.Bind();
+
+    Field* field = new Field(6, 3);
+    field->SetBattleActive(true);
+
+    ScriptedCharacter* target = new ScriptedCharacter(Character::Rank::_1);
+    target->SetTeam(Team::RED);
+    target->SetHealth(999999);
+    field->AddEntity(*target, 2, 2);
+
+    // Ten do not fit on nine tiles. The last one shares a tile.
+    for (int i = 0; i < 10; i++) {
+      Character* met = nullptr;
+
+      if (scripted) {
+        ScriptedCharacter* character = new ScriptedCharacter(Character::Rank::_1);
+        character->SetScript(script);
+        character->SetTarget(target);
+        met = character;
+      }
+      else {
+        Mettaur* native = new Mettaur();
+        native->SetTarget(target);
+        met = native;
+      }
+
+      met->SetTeam(Team::BLUE);
+      met->SetHealth(9999);
+      field->AddEntity(*met, 4 + (i % 3), 1 + (i / 3) % 3);
+    }
+
+    Measure(name, 3600, [field]() {
+      field->Update(FIXED_TIME_STEP);
+      field->GetEventBus().Dispatch();
+      return true;
+    });
+
+    delete field;
+    context.Unbind();
+  }
+
+  /**
+   * @brief Match a hand of 5 chips that ends in a program advance
+   */
+  void FindPA() {
+    std::string name = "pa_find";
+    if (!IsSelected(name)) return;
+
+    PA programAdvance;
+    programAdvance.LoadPA();
+
+    Chip hand[5] = {
+      Chip(1, 0, 'A', 10, Element::NONE, "Recov10", "", "", 1),
+      Chip(2, 0, 'B', 40, Element::NONE, "Cannon", "", "", 1),
+      Chip(3, 0, 'A', 40, Element::NONE, "Cannon", "", "", 1),
+      Chip(4, 0, 'B', 40, Element::NONE, "Cannon", "", "", 1),
+      Chip(5, 0, 'C', 40, Element::NONE, "Cannon", "", "", 1)
+    };
+
+    Chip* input[5] = { &hand[0], &hand[1], &hand[2], &hand[3], &hand[4] };
+
+    Measure(name, 100000, [&]() {
+      programAdvance.FindPA(input, 5);
+      return true;
+    });
+  }
+
+  /**
+   * @brief Parse resources/database/library.txt
+   */
+  void ChipLibraryLoad() {
+    std::string name = "chip_library_load";
+    if (!IsSelected(name)) return;
+
+    Measure(name, 50, []() {
+      ChipLibrary library;
+      return true;
+    });
+  }
+
+  /**
+   * @brief Break a long message into lines for a dialog sized textbox
+   */
+  void TextBoxFormat() {
+    std::string name = "textbox_format_long";
+    if (!IsSelected(name)) return;
+
+    std::string message;
+
+    for (int i = 0; i < 20; i++) {
+      message += "This is a very long message that keeps going so that the textbox has to break it into many lines. ";
+    }
+
+    TextBox textbox(280, 40);
+
+    Measure(name, 1000, [&]() {
+      textbox.SetMessage(message);
+      return true;
+    });
+  }
+}
+
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; i++) {
+    filters.push_back(argv[i]);
+  }
+
+  // Battles do not need to be heard
+  AUDIO.EnableAudio(false);
+
+  std::atomic<int> progress(0);
+  TEXTURES.LoadAllTextures(progress);
+  SHADERS.LoadAllShaders(progress);
+
+  QueuNaviRegistration();
+  NAVIS.LoadAllNavis(progress);
+
+  std::cout << "scenario,ops,ns_per_op,allocs_per_op,bytes_per_op" << std::endl;
+
+  FieldUpdateMettaurs(1);
+  FieldUpdateMettaurs(6);
+  FieldUpdateMettaurs(18);
+  FieldUpdateStolen();
+  FieldFindEntities(false);
+  FieldFindEntities(true);
+
+  SpellStorm("spell_storm_vulcan", [](Field* field) { return new Vulcan(field, Team::RED, 10); }, 4);
+  SpellStorm("spell_storm_bees", [](Field* field) { return new Bees(field, Team::RED, 5); }, 30);
+
+  BossFight("boss_alpha", [](Field* field) { return AlphaBossFight(field).Build(); });
+  BossFight("boss_metalman", [](Field* field) { return MetalManBossFight(field).Build(); });
+
+  AnimationReload(false);
+  AnimationReload(true);
+  FindPA();
+  ChipLibraryLoad();
+  TextBoxFormat();
+  ScriptLoad(false);
+  ScriptLoad(true);
+  ScriptedCharacterUpdate(false);
+  ScriptedCharacterUpdate(true);
+  MettaurMob(false);
+  MettaurMob(true);
+
+  return EXIT_SUCCESS;
+}
@@ -3,6 +3,9 @@
 #include "bnEntity.h"
 #include "bnAgent.h"
 #include "bnNoState.h"
+#include "bnBattleSnapshot.h"
+#include <typeinfo>
+#include <type_traits>
 /**
  * @class AI
  * @author mav
@@ -20,12 +23,32 @@
 template<typename CharacterT>
 class AI : public Agent {
 private:
+  using StateFactory = AIState<CharacterT>*(*)();
+
   AIState<CharacterT>* stateMachine; /*!< State machine responsible for state management */
   CharacterT* ref; /*!< AI of this instance */
   bool isUpdating; /*!< Safely ignore any extra Update() requests */
   AIState<CharacterT>* queuedState;
   int priorityLevel; 
   bool priorityLocked;
+  const std::type_info* stateType, *queuedType; /*!< type of the current and queued state */
+  StateFactory stateFactory, queuedFactory; /*!< make the states again on a snapshot restore. Null if the state needs arguments. */
+
+  template<typename U>
+  static AIState<CharacterT>* MakeState() {
+    return new U();
+  }
+
+  template<typename U>
+  static StateFactory FactoryOf() {
+    if constexpr (std::is_default_constructible<U>::value) {
+      return &MakeState<U>;
+    }
+    else {
+      return nullptr;
+    }
+  }
+
 public:
   // Used for SFINAE events that require characters with AI
   using IsUsingAI = CharacterT;
@@ -36,6 +59,8 @@ public:
    */
   AI(CharacterT* _ref) : Agent() { 
     stateMachine = queuedState = nullptr; 
+    stateType = queuedType = nullptr;
+    stateFactory = queuedFactory = nullptr;
     ref = _ref;
     isUpdating = false;
     priorityLocked = false;
@@ -80,6 +105,8 @@ public:
     if (change) {
       if (queuedState) { delete queuedState; }
       queuedState = new U();
+      queuedType = &typeid(U);
+      queuedFactory = FactoryOf<U>();
 
       priorityLevel = U::PriorityLevel;
     }
@@ -106,6 +133,8 @@ template<typename U, typename ...Args>
     if (change) {
       if (queuedState) { delete queuedState; }
       queuedState = new U(args...);
+      queuedType = &typeid(U);
+      queuedFactory = FactoryOf<U>();
 
       priorityLevel = U::PriorityLevel;
     }
@@ -130,19 +159,111 @@ template<typename U, typename ...Args>
 
         AIState<CharacterT>* oldState = stateMachine;
         stateMachine = queuedState;
+        stateType = queuedType;
+        stateFactory = queuedFactory;
         stateMachine->OnEnter(*ref);
         delete oldState;
         queuedState = nullptr;
+        queuedType = nullptr;
+        queuedFactory = nullptr;
       }
     }
     else {
       if (queuedState != nullptr) {
         stateMachine = queuedState;
+        stateType = queuedType;
+        stateFactory = queuedFactory;
         stateMachine->OnEnter(*ref);
         queuedState = nullptr;
+        queuedType = nullptr;
+        queuedFactory = nullptr;
       }
     }
 
     isUpdating = false;
   }
+
+  /**
+   * @brief Write the target, the current and queued state types and the current state's own data
+   * @param snapshot
+   *
+   * Characters with AI call this from SaveState() before the character saves itself.
+   */
+  void SaveAI(BattleSnapshot& snapshot) const {
+    Entity* target = this->GetTarget();
+
+    snapshot.Write(target ? target->GetID() : 0L);
+    snapshot.Write(stateType);
+    snapshot.Write(stateFactory);
+    snapshot.Write(queuedType);
+    snapshot.Write(queuedFactory);
+    snapshot.Write(priorityLevel);
+    snapshot.Write(priorityLocked);
+
+    size_t block = snapshot.BeginBlock();
+
+    if (stateMachine) {
+      stateMachine->SaveState(snapshot);
+    }
+
+    snapshot.EndBlock(block);
+  }
+
+  /**
+   * @brief Read back what SaveAI() wrote
+   * @param snapshot
+   *
+   * If the AI moved on to another state, the saved state is made again and entered
+   * so its animation callbacks are set. The character's LoadState() runs after this
+   * and puts the animation back where it was. States made with arguments cannot be
+   * made again and are left as they are.
+   */
+  void LoadAI(BattleSnapshot& snapshot) {
+    long targetID = 0;
+    const std::type_info* type = nullptr, *queued = nullptr;
+    StateFactory factory = nullptr, queuedMaker = nullptr;
+
+    snapshot.Read(targetID);
+    snapshot.Read(type);
+    snapshot.Read(factory);
+    snapshot.Read(queued);
+    snapshot.Read(queuedMaker);
+    snapshot.Read(priorityLevel);
+    snapshot.Read(priorityLocked);
+
+    this->SetTarget(snapshot.FindEntity(targetID));
+
+    if (type != stateType && (factory || !type)) {
+      if (stateMachine) {
+        delete stateMachine;
+      }
+
+      stateMachine = factory ? factory() : nullptr;
+      stateType = type;
+      stateFactory = factory;
+
+      if (stateMachine) {
+        stateMachine->OnEnter(*ref);
+      }
+    }
+
+    // A queued state has not been entered yet so a new one is the same
+    if (queued != queuedType) {
+      if (queuedState) {
+        delete queuedState;
+      }
+
+      queuedState = queuedMaker ? queuedMaker() : nullptr;
+      queuedType = queuedState ? queued : nullptr;
+      queuedFactory = queuedState ? queuedMaker : nullptr;
+    }
+
+    size_t end = snapshot.ReadBlock();
+
+    if (stateMachine && type == stateType) {
+      stateMachine->LoadState(snapshot);
+    }
+
+    snapshot.EndReadBlock(end);
+  }
 };
\ No newline at end of file
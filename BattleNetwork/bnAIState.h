@@ -6,6 +6,8 @@
 template<typename T>
 class AI;
 
+class BattleSnapshot;
+
 /**
  * @class AIState
  * @author mav
@@ -59,5 +61,17 @@ public:
    * @param context reference object
    */
   virtual void OnLeave(T& context) = 0;
+
+  /**
+   * @brief Write the state's timers and flags. See BattleSnapshot.
+   * @param snapshot
+   */
+  virtual void SaveState(BattleSnapshot& snapshot) const { ; }
+
+  /**
+   * @brief Read back the state written by SaveState() in the same order
+   * @param snapshot
+   */
+  virtual void LoadState(BattleSnapshot& snapshot) { ; }
 };
 
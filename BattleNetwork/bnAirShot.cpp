@@ -9,6 +9,7 @@
 #include "bnMettaur.h"
 #include "bnTextureResourceManager.h"
 #include "bnAudioResourceManager.h"
+#include "bnBattleContext.h"
 
 #define COOLDOWN 40.0f/1000.0f
 #define DAMAGE_COOLDOWN 50.0f/1000.0f
@@ -24,7 +25,7 @@ AirShot::AirShot(Field* _field, Team _team, int _damage) : Spell(_field, _team)
   hit = false;
   progress = 0.0f;
   hitHeight = 10.0f;
-  random = rand() % 20 - 20;
+  random = BattleContext::Rand() % 20 - 20;
   cooldown = 0.0f;
 
   SetDirection(Direction::RIGHT);
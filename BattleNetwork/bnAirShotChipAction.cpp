@@ -53,6 +53,7 @@ void AirShotChipAction::Execute() {
 
 AirShotChipAction::~AirShotChipAction()
 {
+  TEXTURES.ReleaseTexture(NODE_PATH);
 }
 
 void AirShotChipAction::OnUpdate(float _elapsed)
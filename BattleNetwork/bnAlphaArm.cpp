@@ -7,6 +7,7 @@
 #include "bnAudioResourceManager.h"
 #include <Swoosh/Ease.h>
 #include <cmath>
+#include "bnBattleContext.h"
 
 #define RESOURCE_PATH "resources/mobs/alpha/alpha.animation"
 
@@ -79,7 +80,7 @@ AlphaArm::AlphaArm(Field* _field, Team _team, AlphaArm::Type type)
     animComponent->SetAnimation("LEFT_CLAW_SWIPE");
     SetSlideTime(sf::seconds(0.13f)); // 8 frames in 60 seconds
     SetDirection(Direction::LEFT);
-    changeState = (rand() % 10 < 5) ? TileState::POISON : TileState::ICE;
+    changeState = (BattleContext::Rand() % 10 < 5) ? TileState::POISON : TileState::ICE;
     this->SetLayer(-1);
     break;
   }
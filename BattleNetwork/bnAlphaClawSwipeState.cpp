@@ -1,6 +1,7 @@
 #include "bnAlphaClawSwipeState.h"
 #include "bnAlphaCore.h"
 #include "bnAlphaArm.h"
+#include "bnBattleContext.h"
 
 AlphaClawSwipeState::AlphaClawSwipeState(bool goldenArmState) : AIState<AlphaCore>(), goldenArmState(goldenArmState) { 
   leftArm = rightArm = nullptr;
@@ -21,7 +22,7 @@ void AlphaClawSwipeState::OnEnter(AlphaCore& a) {
   }
 
   if (!last) {
-    last = a.GetField()->GetAt(1 + (rand() % 3), 1);
+    last = a.GetField()->GetAt(1 + (BattleContext::Rand() % 3), 1);
   }
 
   // spawn right claw
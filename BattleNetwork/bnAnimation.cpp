@@ -3,11 +3,99 @@ using sf::Sprite;
 using sf::IntRect;
 
 #include "bnAnimation.h"
-#include "bnFileUtil.h"
+#include "bnMappedFile.h"
+#include "bnVirtualFileSystem.h"
 #include "bnLogger.h"
 #include "bnEntity.h"
 #include <cmath>
+#include <algorithm>
 #include <chrono>
+#include <mutex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+  struct ParsedFile {
+    std::map<string, FrameList> animations;
+    std::filesystem::file_time_type writeTime; /*!< of the loose file when it was parsed */
+  };
+
+  std::mutex cacheMutex; /*!< guards parsedFiles */
+  std::map<string, ParsedFile> parsedFiles; /*!< every animation file parsed so far, by path */
+
+  /*
+  Files in the mounted pack never change and report no time. Loose files report
+  the newest of the text file and its compiled copy so an edit to either one is
+  read again by the next Reload().
+  */
+  std::filesystem::file_time_type SourceTime(const string& path) {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    if (VFS.Find(path, data, size) || VFS.Find(Animation::CompiledPath(path), data, size)) {
+      return std::filesystem::file_time_type();
+    }
+
+    std::error_code textError, compiledError;
+    auto textTime = std::filesystem::last_write_time(path, textError);
+    auto compiledTime = std::filesystem::last_write_time(Animation::CompiledPath(path), compiledError);
+
+    if (textError) textTime = std::filesystem::file_time_type();
+    if (compiledError) compiledTime = std::filesystem::file_time_type();
+
+    return std::max(textTime, compiledTime);
+  }
+
+  /*
+  Compiled animation file layout. Every field is 4 bytes and little endian
+  so every table stays aligned when the file is mapped.
+
+  CompiledHeader
+  CompiledName  [nameCount]   offset and length into the string bytes
+  CompiledState [stateCount]  each state owns a run of frames
+  CompiledFrame [frameCount]  each frame owns a run of points
+  CompiledPoint [pointCount]
+  char          [stringBytes] every state and point name once, not terminated
+  */
+  const char COMPILED_MAGIC[4] = { 'O', 'B', 'N', 'A' };
+
+  struct CompiledHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t nameCount, stateCount, frameCount, pointCount, stringBytes;
+  };
+
+  struct CompiledName {
+    std::uint32_t offset, length;
+  };
+
+  struct CompiledState {
+    std::uint32_t name, firstFrame, frameCount;
+  };
+
+  struct CompiledFrame {
+    float duration;
+    std::int32_t x, y, w, h;
+    float originx, originy;
+    std::uint32_t applyOrigin, firstPoint, pointCount;
+  };
+
+  struct CompiledPoint {
+    std::uint32_t name;
+    float x, y;
+  };
+
+  static_assert(sizeof(CompiledHeader) == 28 && sizeof(CompiledName) == 8 && sizeof(CompiledState) == 12
+    && sizeof(CompiledFrame) == 40 && sizeof(CompiledPoint) == 12, "compiled animation records must be packed");
+
+  template<typename T>
+  void Append(std::vector<char>& bytes, const T* records, size_t count) {
+    const char* begin = reinterpret_cast<const char*>(records);
+    bytes.insert(bytes.end(), begin, begin + (sizeof(T) * count));
+  }
+}
 
 Animation::Animation() : animator(), path("") {
   progress = 0;
@@ -39,6 +127,266 @@ Animation::~Animation() {
 }
 
 void Animation::Reload() {
+  progress = 0;
+
+  auto writeTime = SourceTime(path);
+
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto iter = parsedFiles.find(path);
+
+    // Only copy the parsed file if it has not been edited since
+    if (iter != parsedFiles.end() && iter->second.writeTime == writeTime) {
+      for (auto& state : iter->second.animations) {
+        animations[state.first] = state.second;
+      }
+
+      return;
+    }
+  }
+
+  ParsedFile parsed;
+  parsed.writeTime = writeTime;
+  LoadFile(path, parsed.animations);
+
+  for (auto& state : parsed.animations) {
+    animations[state.first] = state.second;
+  }
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  parsedFiles[path] = std::move(parsed);
+}
+
+const bool Animation::Preload(const string& path) {
+  auto writeTime = SourceTime(path);
+
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto iter = parsedFiles.find(path);
+
+    if (iter != parsedFiles.end() && iter->second.writeTime == writeTime) return false;
+  }
+
+  ParsedFile parsed;
+  parsed.writeTime = writeTime;
+  LoadFile(path, parsed.animations);
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  parsedFiles[path] = std::move(parsed);
+  return true;
+}
+
+void Animation::Evict(const string& path) {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  parsedFiles.erase(path);
+}
+
+void Animation::ClearCache() {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  parsedFiles.clear();
+}
+
+void Animation::LoadFile(const string& path, std::map<string, FrameList>& out) {
+#if OBN_COMPILED_ANIMATIONS
+  const char* packed = nullptr;
+  size_t packedSize = 0;
+
+  // The pack is built from one tree so its compiled copy always matches
+  if (VFS.Find(CompiledPath(path), packed, packedSize) && LoadCompiled(packed, packedSize, out)) {
+    return;
+  }
+
+  std::error_code error, textError;
+  auto compiledTime = std::filesystem::last_write_time(CompiledPath(path), error);
+  auto textTime = std::filesystem::last_write_time(path, textError);
+
+  // Use the compiled copy unless the text file was edited after it was made
+  if (!error && (textError || compiledTime >= textTime) && LoadCompiled(path, out)) {
+    return;
+  }
+#endif
+
+  LoadText(path, out);
+}
+
+void Animation::LoadText(const string& path, std::map<string, FrameList>& out) {
+  Parse(VFS.ReadString(path), out);
+}
+
+const string Animation::CompiledPath(const string& path) {
+  const string extension = ANIMATION_EXTENSION;
+
+  if (path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+    return path.substr(0, path.size() - extension.size()) + ANIMATION_COMPILED_EXTENSION;
+  }
+
+  return path + ANIMATION_COMPILED_EXTENSION;
+}
+
+const bool Animation::Compile(const string& path) {
+  std::map<string, FrameList> parsed;
+  LoadText(path, parsed);
+
+  std::vector<CompiledName> names;
+  std::vector<CompiledState> states;
+  std::vector<CompiledFrame> frames;
+  std::vector<CompiledPoint> points;
+  std::map<string, std::uint32_t> interned;
+  string strings;
+
+  auto intern = [&](const string& name) {
+    auto iter = interned.find(name);
+
+    if (iter != interned.end()) return iter->second;
+
+    std::uint32_t index = (std::uint32_t)names.size();
+    names.push_back(CompiledName{ (std::uint32_t)strings.size(), (std::uint32_t)name.size() });
+    strings += name;
+    interned.insert(std::make_pair(name, index));
+    return index;
+  };
+
+  for (auto& [state, list] : parsed) {
+    CompiledState compiledState{ intern(state), (std::uint32_t)frames.size(), (std::uint32_t)list.GetFrameCount() };
+    states.push_back(compiledState);
+
+    for (size_t i = 0; i < list.GetFrameCount(); i++) {
+      const Frame& frame = list.GetFrame((int)i);
+
+      CompiledFrame compiledFrame;
+      compiledFrame.duration = frame.duration;
+      compiledFrame.x = frame.subregion.left;
+      compiledFrame.y = frame.subregion.top;
+      compiledFrame.w = frame.subregion.width;
+      compiledFrame.h = frame.subregion.height;
+      compiledFrame.originx = frame.origin.x;
+      compiledFrame.originy = frame.origin.y;
+      compiledFrame.applyOrigin = frame.applyOrigin ? 1 : 0;
+      compiledFrame.firstPoint = (std::uint32_t)points.size();
+      compiledFrame.pointCount = (std::uint32_t)frame.points.size();
+      frames.push_back(compiledFrame);
+
+      for (auto& [label, point] : frame.points) {
+        points.push_back(CompiledPoint{ intern(label), point.x, point.y });
+      }
+    }
+  }
+
+  CompiledHeader header;
+  std::memcpy(header.magic, COMPILED_MAGIC, sizeof(header.magic));
+  header.version = ANIMATION_COMPILED_VERSION;
+  header.nameCount = (std::uint32_t)names.size();
+  header.stateCount = (std::uint32_t)states.size();
+  header.frameCount = (std::uint32_t)frames.size();
+  header.pointCount = (std::uint32_t)points.size();
+  header.stringBytes = (std::uint32_t)strings.size();
+
+  std::vector<char> bytes;
+  Append(bytes, &header, 1);
+  Append(bytes, names.data(), names.size());
+  Append(bytes, states.data(), states.size());
+  Append(bytes, frames.data(), frames.size());
+  Append(bytes, points.data(), points.size());
+  bytes.insert(bytes.end(), strings.begin(), strings.end());
+
+  std::FILE* file = std::fopen(CompiledPath(path).c_str(), "wb");
+
+  if (!file) return false;
+
+  bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+  std::fclose(file);
+
+  return written;
+}
+
+const bool Animation::LoadCompiled(const string& path, std::map<string, FrameList>& out) {
+  MappedFile file;
+
+  if (!file.Open(CompiledPath(path))) return false;
+
+  return LoadCompiled(file.GetData(), file.GetSize(), out);
+}
+
+const bool Animation::LoadCompiled(const char* data, size_t size, std::map<string, FrameList>& out) {
+  if (size < sizeof(CompiledHeader)) return false;
+
+  const CompiledHeader* header = reinterpret_cast<const CompiledHeader*>(data);
+
+  if (std::memcmp(header->magic, COMPILED_MAGIC, sizeof(COMPILED_MAGIC)) != 0 || header->version != ANIMATION_COMPILED_VERSION) {
+    return false;
+  }
+
+  size_t namesAt = sizeof(CompiledHeader);
+  size_t statesAt = namesAt + (sizeof(CompiledName) * (size_t)header->nameCount);
+  size_t framesAt = statesAt + (sizeof(CompiledState) * (size_t)header->stateCount);
+  size_t pointsAt = framesAt + (sizeof(CompiledFrame) * (size_t)header->frameCount);
+  size_t stringsAt = pointsAt + (sizeof(CompiledPoint) * (size_t)header->pointCount);
+
+  if (stringsAt + header->stringBytes != size) return false;
+
+  const CompiledName* names = reinterpret_cast<const CompiledName*>(data + namesAt);
+  const CompiledState* states = reinterpret_cast<const CompiledState*>(data + statesAt);
+  const CompiledFrame* frames = reinterpret_cast<const CompiledFrame*>(data + framesAt);
+  const CompiledPoint* points = reinterpret_cast<const CompiledPoint*>(data + pointsAt);
+  const char* strings = data + stringsAt;
+
+  // Check every index before touching out so a bad file changes nothing
+  for (std::uint32_t i = 0; i < header->nameCount; i++) {
+    if ((size_t)names[i].offset + names[i].length > header->stringBytes) return false;
+  }
+
+  for (std::uint32_t i = 0; i < header->stateCount; i++) {
+    if (states[i].name >= header->nameCount) return false;
+    if ((size_t)states[i].firstFrame + states[i].frameCount > header->frameCount) return false;
+  }
+
+  for (std::uint32_t i = 0; i < header->frameCount; i++) {
+    if ((size_t)frames[i].firstPoint + frames[i].pointCount > header->pointCount) return false;
+  }
+
+  for (std::uint32_t i = 0; i < header->pointCount; i++) {
+    if (points[i].name >= header->nameCount) return false;
+  }
+
+  // One string per name, not per frame or point
+  std::vector<string> interned;
+  interned.reserve(header->nameCount);
+
+  for (std::uint32_t i = 0; i < header->nameCount; i++) {
+    interned.emplace_back(strings + names[i].offset, names[i].length);
+  }
+
+  for (std::uint32_t i = 0; i < header->stateCount; i++) {
+    const CompiledState& state = states[i];
+    auto inserted = out.emplace(interned[state.name], FrameList());
+
+    if (!inserted.second) continue;
+
+    FrameList& list = inserted.first->second;
+    list.Reserve(state.frameCount);
+
+    for (std::uint32_t j = 0; j < state.frameCount; j++) {
+      const CompiledFrame& frame = frames[state.firstFrame + j];
+      IntRect rect(frame.x, frame.y, frame.w, frame.h);
+
+      if (frame.applyOrigin) {
+        list.Add(frame.duration, rect, sf::Vector2f(frame.originx, frame.originy));
+      }
+      else {
+        list.Add(frame.duration, rect);
+      }
+
+      for (std::uint32_t k = 0; k < frame.pointCount; k++) {
+        const CompiledPoint& point = points[frame.firstPoint + k];
+        list.SetPoint(interned[point.name], sf::Vector2f(point.x, point.y));
+      }
+    }
+  }
+
+  return true;
+}
+
+void Animation::Parse(const string& file, std::map<string, FrameList>& out) {
   int frameAnimationIndex = -1;
   vector<FrameList> frameLists;
   string currentState = "";
@@ -46,8 +394,7 @@ void Animation::Reload() {
   int currentWidth = 0;
   int currentHeight = 0;
   bool legacySupport = false;
-  progress = 0;
-  string data = FileUtil::Read(path);
+  string data = file;
   int endline = 0;
   do {
     endline = (int)data.find("\n");
@@ -63,7 +410,7 @@ void Animation::Reload() {
       if (!frameLists.empty()) {
         //std::cout << "animation total seconds: " << sf::seconds(currentAnimationDuration).asSeconds() << "\n";
         //std::cout << "animation name push " << currentState << endl;
-        animations.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
+        out.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
         currentAnimationDuration = 0.0f;
       }
       string state = ValueOf("state", line);
@@ -142,7 +489,7 @@ void Animation::Reload() {
 
   // One more addAnimation to do if file is good
   if (frameAnimationIndex >= 0) {
-    animations.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
+    out.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
   }
 }
 
@@ -193,6 +540,11 @@ void Animation::SyncTime(float newTime)
   progress = newTime;
 }
 
+const float Animation::GetProgress() const
+{
+  return progress;
+}
+
 void Animation::SetFrame(int frame, sf::Sprite& target)
 {
   if(path.empty() || animations.empty() || animations.find(currAnimation) == animations.end()) return;
@@ -11,6 +11,13 @@ using std::string;
 using std::to_string;
 
 #define ANIMATION_EXTENSION ".animation"
+#define ANIMATION_COMPILED_EXTENSION ".animb"
+#define ANIMATION_COMPILED_VERSION 1
+
+// Set to 0 to always parse the text files even if compiled files are next to them
+#ifndef OBN_COMPILED_ANIMATIONS
+#define OBN_COMPILED_ANIMATIONS 1
+#endif
 
 /**
  * @class Animation
@@ -44,11 +51,17 @@ using std::to_string;
  * ```
  *
  * etc.
+ *
+ * A compiled copy of the file with the extension .animb is loaded instead when it is
+ * not older than the text file. Compiled files keep the same data in flat arrays with
+ * every state and point name stored once. They are memory mapped and read in place.
+ * When a resource pack holds the compiled copy it is always used.
+ * Make them with the BattleNetworkAnimationCompiler tool.
  */
 class Animation {
 public:
 
-  auto GetMode() {
+  auto GetMode() const {
     return animator.GetMode();
   }
 
@@ -77,6 +90,9 @@ public:
    * @brief Reads file at path set by constructor, parses lines, and populates FrameList with data
 
      Effectively same as calling Load()
+     Each file is only parsed once. Later calls for the same path copy the parsed FrameLists
+     unless the loose file was edited since, in which case it is read again.
+     States in the file replace states of the same name.
    */
   void Reload();
  
@@ -100,6 +116,12 @@ public:
    */
   void SyncTime(float newTime);
 
+  /**
+   * @brief Get the animation elapsed counter
+   * @return progress in seconds into the current animation
+   */
+  const float GetProgress() const;
+
   /**
    * @brief Sets progress to 0 and updates sprite. Same as a call to Update(0, target).
    * @param target
@@ -173,6 +195,53 @@ public:
 
   void SyncAnimation(Animation& other);
 
+  /**
+   * @brief Parse a file so the next Reload() of that path does not read it. Safe from any thread.
+   * @param path relative path from application to file
+   * @return true if the file was parsed, false if it was already parsed and not edited since
+   */
+  static const bool Preload(const string& path);
+
+  /**
+   * @brief Forget one parsed file. The next Reload() of that path reads the file again.
+   * @param path relative path from application to file
+   */
+  static void Evict(const string& path);
+
+  /**
+   * @brief Forget every parsed file. The next Reload() of each path reads the file again.
+   */
+  static void ClearCache();
+
+  /**
+   * @brief Parse a text animation file and write its compiled copy next to it
+   * @param path relative path from application to the text file
+   * @return true if the compiled file was written
+   */
+  static const bool Compile(const string& path);
+
+  /**
+   * @brief Read the compiled copy of an animation file
+   * @param path relative path from application to the text file
+   * @param out FrameLists by state name. Existing states are kept.
+   * @return false if there is no compiled copy or it is not valid. out is not changed.
+   */
+  static const bool LoadCompiled(const string& path, std::map<string, FrameList>& out);
+
+  /**
+   * @brief Read and parse the text animation file from the pack or from disk
+   * @param path relative path from application to file
+   * @param out FrameLists by state name. Existing states are kept.
+   */
+  static void LoadText(const string& path, std::map<string, FrameList>& out);
+
+  /**
+   * @brief Path of the compiled copy of an animation file
+   * @param path relative path from application to the text file
+   * @return path with ANIMATION_COMPILED_EXTENSION in place of ANIMATION_EXTENSION
+   */
+  static const string CompiledPath(const string& path);
+
 private:
   /**
    * @brief Strips the key-value from a file format
@@ -180,7 +249,30 @@ private:
    * @param _line string input
    * @return value as string or empty string
    */
-  string ValueOf(string _key, string _line);
+  static string ValueOf(string _key, string _line);
+
+  /**
+   * @brief Parses the contents of an animation file
+   * @param file contents of the file
+   * @param out FrameLists by state name. Existing states are kept.
+   */
+  static void Parse(const string& file, std::map<string, FrameList>& out);
+
+  /**
+   * @brief Reads a compiled animation already in memory
+   * @param data first byte of the compiled file
+   * @param size of the compiled file
+   * @param out FrameLists by state name. Existing states are kept.
+   * @return false if the data is not valid. out is not changed.
+   */
+  static const bool LoadCompiled(const char* data, size_t size, std::map<string, FrameList>& out);
+
+  /**
+   * @brief Load the compiled copy if it is up to date, otherwise parse the text file
+   * @param path relative path from application to the text file
+   * @param out FrameLists by state name
+   */
+  static void LoadFile(const string& path, std::map<string, FrameList>& out);
 protected:
   Animator animator; /*!< Internal animator to delegate most of the work to */
   string path; /*!< Path to the animation file */
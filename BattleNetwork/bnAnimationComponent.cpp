@@ -7,6 +7,7 @@ using sf::IntRect;
 #include "bnLogger.h"
 #include "bnEntity.h"
 #include "bnCharacter.h"
+#include "bnBattleSnapshot.h"
 
 AnimationComponent::AnimationComponent(Entity* _entity) : Component(_entity) {
   speed = 1.0;
@@ -152,3 +153,35 @@ void AnimationComponent::SetFrame(const int index)
 {
   animation.SetFrame(index, *GetOwner());
 }
+
+void AnimationComponent::SaveState(BattleSnapshot& snapshot) const
+{
+  snapshot.Write(animation.GetAnimationString());
+  snapshot.Write(animation.GetProgress());
+  snapshot.Write(animation.GetMode());
+  snapshot.Write(speed);
+}
+
+void AnimationComponent::LoadState(BattleSnapshot& snapshot)
+{
+  std::string state;
+  float progress = 0;
+  char playbackMode = 0;
+
+  snapshot.Read(state);
+  snapshot.Read(progress);
+  snapshot.Read(playbackMode);
+  snapshot.Read(speed);
+
+  if (state != animation.GetAnimationString()) {
+    animation.SetAnimation(state);
+  }
+
+  animation << playbackMode;
+  animation.SyncTime(progress);
+
+  if (GetOwner()) {
+    // Apply the frame without advancing
+    animation.Update(0, *GetOwner(), speed);
+  }
+}
@@ -39,6 +39,21 @@ public:
    * @param BattleScene& unused
    */
   void Inject(BattleScene&) { ; }
+
+  /**
+   * @brief Writes the animation name, progress, mode, and speed
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Restores the animation and refreshes the owner's sprite
+   * 
+   * Callbacks are closures and cannot be saved. If the animation name
+   * changed since the snapshot, the callbacks of the current animation are dropped.
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
   
   /**
    * @brief Reconstructs the animation object
@@ -124,6 +124,23 @@ public:
     totalDuration += dur;
   }
 
+  /**
+   * @brief Make room for count frames so adding them does not reallocate
+   * @param count
+   */
+  void Reserve(size_t count) {
+    frames.reserve(count);
+  }
+
+  /**
+   * @brief Sets a point on the last frame without copying the name
+   * @param name of the point. Must already be upper case.
+   * @param point location of the point
+   */
+  void SetPoint(const std::string& name, sf::Vector2f point) {
+    frames.back().points[name] = point;
+  }
+
   /**
   * @brief sets the (x,y) location for a point and assigns a name
   * @param name of the new point 
@@ -254,7 +271,7 @@ public:
    * @brief Get the current playback mode
    * @return char
    */
-  char GetMode() { return playbackMode;  }
+  char GetMode() const { return playbackMode;  }
   
   const sf::Vector2f GetPoint(const std::string& pointName);
   
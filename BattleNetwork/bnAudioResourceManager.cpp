@@ -1,5 +1,18 @@
 #include "bnAudioResourceManager.h"
 #include "bnLogger.h"
+#include "bnVirtualFileSystem.h"
+#include <algorithm>
+
+namespace {
+  // Cues played with AudioPriority::HIGHEST in battle. They are decoded when the
+  // bank loads and never evicted so they never wait on the decoder.
+  const AudioType HIGHEST_PRIORITY_CUES[] = {
+    AudioType::GUN,
+    AudioType::COUNTER,
+    AudioType::CHIP_CHOOSE,
+    AudioType::CHIP_CANCEL
+  };
+}
 
 AudioResourceManager& AudioResourceManager::GetInstance() {
   static AudioResourceManager instance;
@@ -21,13 +34,23 @@ AudioResourceManager::AudioResourceManager() {
     sources[i] = sf::SoundBuffer();
   }
 
+  compressed = new std::vector<char>[AudioType::AUDIO_TYPE_SIZE];
+  pinned = new bool[AudioType::AUDIO_TYPE_SIZE];
+
+  for (int i = 0; i < AUDIO_TYPE_SIZE; i++) {
+    pinned[i] = false;
+  }
+
+  useSoundBank = false;
+  bankStats.budgetBytes = AUDIO_SOUND_BANK_BUDGET_BYTES;
+
   channelVolume = streamVolume = 100; //SFML default
 }
 
 
 AudioResourceManager::~AudioResourceManager() {
   // Stop playing everything 
-  stream.stop();
+  stream.Stop();
 
   for (int i = 0; i < NUM_OF_CHANNELS; i++) {
     channels[i].buffer.stop();
@@ -36,6 +59,8 @@ AudioResourceManager::~AudioResourceManager() {
   // Free memory
   delete[] channels;
   delete[] sources;
+  delete[] compressed;
+  delete[] pinned;
 }
 
 void AudioResourceManager::EnableAudio(bool status) {
@@ -54,7 +79,43 @@ void AudioResourceManager::EnableAudio(bool status) {
   }
 }
 
+void AudioResourceManager::EnableSoundBank(bool enabled, size_t budget) {
+  std::lock_guard<std::mutex> lock(bankMutex);
+  useSoundBank = enabled;
+  bankStats.budgetBytes = budget;
+}
+
+void AudioResourceManager::PinSource(AudioType type) {
+  if (type < AudioType(0) || type >= AudioType::AUDIO_TYPE_SIZE) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(bankMutex);
+
+  if (pinned[type]) return;
+
+  pinned[type] = true;
+
+  // Pinned samples are no longer candidates for eviction
+  recentlyUsed.remove(type);
+
+  // If the compressed data is already here, decode it now so it never plays late
+  if (useSoundBank && sources[type].getSampleCount() == 0 && !compressed[type].empty()) {
+    DecodeSource(type);
+  }
+}
+
+const SoundBankStats AudioResourceManager::GetSoundBankStats() const {
+  std::lock_guard<std::mutex> lock(bankMutex);
+  return bankStats;
+}
+
 void AudioResourceManager::LoadAllSources(std::atomic<int> &status) {
+  // Pinned before loading so each is decoded as soon as its data is read
+  for (AudioType type : HIGHEST_PRIORITY_CUES) {
+    PinSource(type);
+  }
+
   LoadSource(AudioType::APPEAR, "resources/sfx/appear.ogg"); status++;
   LoadSource(AudioType::AREA_GRAB, "resources/sfx/area_grab.ogg"); status++;
   LoadSource(AudioType::AREA_GRAB_TOUCHDOWN, "resources/sfx/area_grab_touchdown.ogg"); status++;
@@ -100,10 +161,48 @@ void AudioResourceManager::LoadAllSources(std::atomic<int> &status) {
   LoadSource(AudioType::NEW_GAME, "resources/sfx/new_game.ogg"); status++;
   LoadSource(AudioType::TEXT, "resources/sfx/text.ogg"); status++;
   LoadSource(AudioType::SHINE, "resources/sfx/shine.ogg"); status++;
+
+  if (useSoundBank) {
+    const SoundBankStats stats = GetSoundBankStats();
+
+    Logger::GetMutex()->lock();
+    Logger::Logf("Sound bank: %u KiB compressed, %u KiB decoded", (unsigned)(stats.compressedBytes / 1024), (unsigned)(stats.residentBytes / 1024));
+    Logger::GetMutex()->unlock();
+  }
 }
 
 void AudioResourceManager::LoadSource(AudioType type, const std::string& path) {
-  if (!sources[type].loadFromFile(path)) {
+  if (useSoundBank) {
+    // Read outside the lock so sounds can play while the file loads
+    std::vector<char> data;
+    bool read = VFS.Read(path, data);
+
+    if (!read) {
+      Logger::GetMutex()->lock();
+      Logger::Logf("Failed loading audio: %s\n", path.c_str());
+      Logger::GetMutex()->unlock();
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(bankMutex);
+
+      bankStats.compressedBytes -= compressed[type].size();
+      compressed[type].swap(data);
+      bankStats.compressedBytes += compressed[type].size();
+
+      if (pinned[type]) {
+        DecodeSource(type);
+      }
+    }
+
+    Logger::GetMutex()->lock();
+    Logger::Logf("Banked audio: %s", path.c_str());
+    Logger::GetMutex()->unlock();
+    return;
+  }
+
+  if (!VFS.Load(sources[type], path)) {
 
     Logger::GetMutex()->lock();
     Logger::Logf("Failed loading audio: %s\n", path.c_str());
@@ -117,6 +216,85 @@ void AudioResourceManager::LoadSource(AudioType type, const std::string& path) {
   }
 }
 
+bool AudioResourceManager::DecodeSource(AudioType type) {
+  size_t before = sources[type].getSampleCount() * sizeof(sf::Int16);
+
+  if (!sources[type].loadFromMemory(compressed[type].data(), compressed[type].size())) {
+    Logger::GetMutex()->lock();
+    Logger::Logf("Failed decoding banked audio: %i", (int)type);
+    Logger::GetMutex()->unlock();
+    return false;
+  }
+
+  bankStats.residentBytes -= before;
+  bankStats.residentBytes += sources[type].getSampleCount() * sizeof(sf::Int16);
+
+  return true;
+}
+
+const bool AudioResourceManager::IsSourcePlaying(AudioType type) const {
+  for (int i = 0; i < NUM_OF_CHANNELS; i++) {
+    if (channels[i].buffer.getBuffer() == &sources[type] && channels[i].buffer.getStatus() == sf::SoundSource::Status::Playing) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void AudioResourceManager::EvictSources() {
+  // Walk from the least recently used sample. Skip samples still on a channel
+  // because freeing their buffer would cut them off mid-play.
+  auto iter = recentlyUsed.end();
+
+  while (bankStats.residentBytes > bankStats.budgetBytes && iter != recentlyUsed.begin()) {
+    --iter;
+
+    AudioType type = *iter;
+
+    // Never evict the sample we are about to play
+    if (iter == recentlyUsed.begin() || IsSourcePlaying(type)) {
+      continue;
+    }
+
+    bankStats.residentBytes -= sources[type].getSampleCount() * sizeof(sf::Int16);
+    sources[type] = sf::SoundBuffer();
+    bankStats.evictions++;
+
+    iter = recentlyUsed.erase(iter);
+  }
+}
+
+bool AudioResourceManager::FetchSource(AudioType type) {
+  if (!useSoundBank) return true;
+
+  if (pinned[type]) {
+    bankStats.hits++;
+    return sources[type].getSampleCount() > 0;
+  }
+
+  auto iter = std::find(recentlyUsed.begin(), recentlyUsed.end(), type);
+
+  if (iter != recentlyUsed.end()) {
+    bankStats.hits++;
+
+    // Most recently used goes to the front
+    recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, iter);
+    return true;
+  }
+
+  bankStats.misses++;
+
+  if (compressed[type].empty() || !DecodeSource(type)) {
+    return false;
+  }
+
+  recentlyUsed.push_front(type);
+  EvictSources();
+
+  return true;
+}
+
 int AudioResourceManager::Play(AudioType type, AudioPriority priority) {
   if (!isEnabled) { return -1; }
 
@@ -124,6 +302,13 @@ int AudioResourceManager::Play(AudioType type, AudioPriority priority) {
     return -1;
   }
 
+  // Held until the sample is on a channel so it cannot be evicted in between
+  std::lock_guard<std::mutex> lock(bankMutex);
+
+  if (!FetchSource(type)) {
+    return -1;
+  }
+
   // Annoying sound check. Make sure duplicate sounds are played only by a given amount of offset from the last time it was played.
   // This prevents amplitude stacking when duplicate sounds are played on the same frame...
   // NOTE: an audio queue would be a better place for this check. Then play() those sounds that pass the queue filter.
@@ -200,31 +385,30 @@ int AudioResourceManager::Play(AudioType type, AudioPriority priority) {
   return -1;
 }
 
-int AudioResourceManager::Stream(std::string path, bool loop, sf::Music::TimeSpan span) {
+int AudioResourceManager::Stream(std::string path, bool loop, sf::Music::TimeSpan span, float crossfade) {
   if (!isEnabled) { return -1; }
 
-  // stop previous stream if any 
-  stream.stop();
-
-  if (!stream.openFromFile(path))
-    return -1; // error
+  return stream.Play(path, loop, span, crossfade);
+}
 
-  stream.play();
-  stream.setLoop(loop);
+void AudioResourceManager::PrefetchStream(const std::string& path) {
+  stream.Prefetch(path);
+}
 
-  if(loop) {
-    stream.setLoopPoints(span);
-  }
+void AudioResourceManager::StopStream(float fadeOut) {
+  stream.Stop(fadeOut);
+}
 
-  return 0;
+void AudioResourceManager::UpdateStream(float elapsed) {
+  stream.Update(elapsed);
 }
 
-void AudioResourceManager::StopStream() {
-  stream.stop();
+const MusicStreamStats AudioResourceManager::GetStreamStats() const {
+  return stream.GetStats();
 }
 
 void AudioResourceManager::SetStreamVolume(float volume) {
-  stream.setVolume(volume);
+  stream.SetVolume(volume);
   streamVolume = volume;
 }
 
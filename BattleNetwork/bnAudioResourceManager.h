@@ -4,7 +4,11 @@
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/Music.hpp>
 #include "bnAudioType.h"
+#include "bnMusicStreamer.h"
 #include <atomic>
+#include <vector>
+#include <list>
+#include <mutex>
 
 // For more retro experience, decrease available channels.
 #define NUM_OF_CHANNELS 10
@@ -13,6 +17,10 @@
 // Allows duplicate audio samples to play in X ms apart from eachother
 #define AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS 58 // 58ms = ~3.5 frames
 
+// When the sound bank is enabled, this is how many bytes of decoded PCM may stay resident
+// Pinned samples count towards the total but are never evicted
+#define AUDIO_SOUND_BANK_BUDGET_BYTES (2*1024*1024) // 2 MiB = ~11 secs of 44.1kHz stereo
+
 /**
   * @class AudioPriority
   * @brief Each priority describes how or if a playing sample should be interrupted
@@ -29,6 +37,19 @@ enum class AudioPriority : int {
   HIGHEST
 };
 
+/**
+ * @struct SoundBankStats
+ * @brief Counters reported by the sound bank cache
+ */
+struct SoundBankStats {
+  unsigned hits{ 0 };          /*!< Play() found the sample already decoded */
+  unsigned misses{ 0 };        /*!< Play() had to decode the sample first */
+  unsigned evictions{ 0 };     /*!< Decoded samples dropped to stay under budget */
+  size_t compressedBytes{ 0 }; /*!< Bytes of compressed audio kept in memory */
+  size_t residentBytes{ 0 };   /*!< Bytes of decoded PCM currently in memory */
+  size_t budgetBytes{ 0 };     /*!< Max bytes of decoded PCM allowed */
+};
+
 /**
  * @class AudioResourceManager
  * @author mav
@@ -61,6 +82,30 @@ public:
    * @param path path to audio sample
    */
   void LoadSource(AudioType type, const std::string& path);
+
+  /**
+   * @brief Keep compressed audio in memory and decode samples when first played
+   * 
+   * Decoded samples are kept in a least-recently-used cache no larger than budget bytes.
+   * Must be called before LoadAllSources()
+   * @param enabled if false, every sample is decoded at load time (default)
+   * @param budget max bytes of decoded PCM to keep resident
+   */
+  void EnableSoundBank(bool enabled, size_t budget = AUDIO_SOUND_BANK_BUDGET_BYTES);
+
+  /**
+   * @brief Pinned samples are decoded at load time and never evicted from the sound bank
+   * @param type audio to pin
+   *
+   * Cues played with AudioPriority::HIGHEST are pinned by LoadAllSources()
+   */
+  void PinSource(AudioType type);
+
+  /**
+   * @brief Query the sound bank counters
+   * @return SoundBankStats
+   */
+  const SoundBankStats GetSoundBankStats() const;
   
   /**
    * @brief Play a sound with an audio priority
@@ -69,8 +114,41 @@ public:
    * @return -1 if could not play, otherwise 0
    */
   int Play(AudioType type, AudioPriority priority = AudioPriority::LOW);
-  int Stream(std::string path, bool loop = false, sf::Music::TimeSpan span = sf::Music::TimeSpan());
-  void StopStream();
+
+  /**
+   * @brief Stream music. Uses the prefetched track if PrefetchStream() was called with this path
+   * @param path path to music file
+   * @param loop if true, loop the track
+   * @param span loop points. Only used if loop is true
+   * @param crossfade seconds to fade from the playing stream to this one. 0 swaps immediately
+   * @return -1 if could not play, otherwise 0
+   */
+  int Stream(std::string path, bool loop = false, sf::Music::TimeSpan span = sf::Music::TimeSpan(), float crossfade = 0.f);
+
+  /**
+   * @brief Open a music file on a background thread so a later Stream() call does not block
+   * @param path path to music file
+   */
+  void PrefetchStream(const std::string& path);
+
+  /**
+   * @brief Stop the stream
+   * @param fadeOut seconds to fade out. 0 stops immediately
+   */
+  void StopStream(float fadeOut = 0.f);
+
+  /**
+   * @brief Steps stream crossfades. Call once per frame
+   * @param elapsed in seconds
+   */
+  void UpdateStream(float elapsed);
+
+  /**
+   * @brief Query how long stream switches have blocked the caller
+   * @return MusicStreamStats
+   */
+  const MusicStreamStats GetStreamStats() const;
+
   void SetStreamVolume(float volume);
   void SetChannelVolume(float volume);
 
@@ -83,9 +161,40 @@ private:
     AudioPriority priority;
   };
 
+  /**
+   * @brief Decodes the sample if needed and marks it as most recently used
+   *
+   * Call with the bank locked and keep it locked until the sample is set on a channel.
+   * @param type audio to fetch
+   * @return true if the sample is ready to play
+   */
+  bool FetchSource(AudioType type);
+
+  /**
+   * @brief Decodes compressed data into sources[type]. Call with the bank locked.
+   * @return true if successful
+   */
+  bool DecodeSource(AudioType type);
+
+  /**
+   * @brief Drops least recently used samples until decoded PCM fits in the budget
+   */
+  void EvictSources();
+
+  /**
+   * @brief Check if any channel is currently playing this sample
+   */
+  const bool IsSourcePlaying(AudioType type) const;
+
   Channel* channels;
   sf::SoundBuffer* sources;
-  sf::Music stream;
+  std::vector<char>* compressed; /*!< Encoded file data per sample when sound bank is on */
+  bool* pinned;
+  std::list<AudioType> recentlyUsed; /*!< Front is most recently used */
+  SoundBankStats bankStats;
+  mutable std::mutex bankMutex; /*!< guards the bank. Sources load on another thread while the game plays sounds. */
+  bool useSoundBank;
+  MusicStreamer stream;
   float channelVolume;
   float streamVolume;
   bool isEnabled;
@@ -3,6 +3,7 @@
 #include "bnShaderResourceManager.h"
 #include "bnTextureResourceManager.h"
 #include "bnSmartShader.h"
+#include "bnBackgroundRegistry.h"
 
 #include <cmath>
 
@@ -46,46 +47,21 @@ protected:
   }
 
   /**
-   * @brief Given the single texture's size creates geometry to fill the screen
+   * @brief Given the single texture's size uses geometry that fills the screen
    * @param textureSize size of the texture you want to fill the screen with
+   *
+   * Geometry is shared through BACKGROUNDS and only built the first time these sizes are used
    */
   void FillScreen(sf::Vector2u textureSize) {
-    // How many times can the texture fit in (width,height)?
-    unsigned occuranceX = (unsigned)std::ceil(((float)width / (float)textureSize.x));
-    unsigned occuranceY = (unsigned)std::ceil(((float)height / (float)textureSize.y));
-
-    occuranceX = std::max(occuranceX, (unsigned)1);
-    occuranceY = std::max(occuranceY, (unsigned)1);
-
-    vertices.resize(occuranceX * occuranceY * (unsigned)6);
-
+    geometry = BACKGROUNDS.GetGeometry(textureSize, width, height);
     textureRect = sf::IntRect(0, 0, textureSize.x, textureSize.y);
 
-    for (unsigned int i = 0; i < occuranceX; ++i) {
-      for (unsigned int j = 0; j < occuranceY; ++j) {
-        // get a pointer to the current tile's quad
-        sf::Vertex* quad = &vertices[(i + j * occuranceX) * 6];
-
-        // define its 4 corners
-        quad[0].position = sf::Vector2f((float)(i * textureSize.x * 2), (float)((j + 1) * textureSize.y * 2));
-        quad[1].position = sf::Vector2f((float)(i * textureSize.x * 2), (float)(j * textureSize.y * 2));
-        quad[2].position = sf::Vector2f((float)((i + 1) * textureSize.x * 2), (float)((j + 1) * textureSize.y * 2));
-
-        quad[3].position = sf::Vector2f((float)(i * textureSize.x * 2), (float)(j * textureSize.y * 2));
-        quad[4].position = sf::Vector2f((float)((i + 1) * textureSize.x * 2), (float)((j + 1) * textureSize.y * 2));
-        quad[5].position = sf::Vector2f((float)((i + 1) * textureSize.x * 2), (float)(j * textureSize.y * 2));
-
-        // define its 4 texture coordinates
-        quad[0].texCoords = sf::Vector2f(0, (float)textureSize.y);
-        quad[1].texCoords = sf::Vector2f(0, 0);
-        quad[2].texCoords = sf::Vector2f((float)textureSize.x, (float)textureSize.y);
-
-        quad[3].texCoords = sf::Vector2f(0, 0);
-        quad[4].texCoords = sf::Vector2f((float)textureSize.x, (float)textureSize.y);
-        quad[5].texCoords = sf::Vector2f((float)textureSize.x, 0);
-      }
-
-      textureRect = sf::IntRect(0, 0, textureSize.x, textureSize.y);
+    if (color != sf::Color::White) {
+      // Tinted backgrounds need their own copy of the new geometry
+      tinted.clear();
+      sf::Color tint = color;
+      color = sf::Color::White;
+      setColor(tint);
     }
   }
 
@@ -96,11 +72,10 @@ public:
    * @param width of screen
    * @param height of screen
    */
-  Background(sf::Texture& ref, int width, int height) : offset(0,0), textureRect(0, 0, width, height), width(width), height(height), texture(ref) {
-      texture = ref;
+  Background(sf::Texture& ref, int width, int height) : offset(0,0), textureRect(0, 0, width, height), width(width), height(height), texture(ref), color(sf::Color::White) {
       texture.setRepeated(true);
 
-      vertices.setPrimitiveType(sf::Triangles);
+      tinted.setPrimitiveType(sf::Triangles);
 
       sf::Vector2u textureSize = ref.getSize();
 
@@ -109,6 +84,15 @@ public:
       textureWrap = SHADERS.GetShader(ShaderType::TEXEL_TEXTURE_WRAP);
   }
 
+  /**
+   * @brief Constructs background from a texture file shared by every background that uses it
+   * @param path to the texture. Loaded once for the life of the program.
+   * @param width of screen
+   * @param height of screen
+   */
+  Background(const std::string& path, int width, int height) : Background(BACKGROUNDS.GetTexture(path), width, height) {
+  }
+
   ~Background() { ;  }
   
   /**
@@ -132,17 +116,20 @@ public:
 
     sf::Vector2u size = texture.getSize();
 
-    textureWrap->setUniform("x", (float)textureRect.left / (float)size.x);
-    textureWrap->setUniform("y", (float)textureRect.top / (float)size.y);
-    textureWrap->setUniform("w", (float)textureRect.width / (float)size.x);
-    textureWrap->setUniform("h", (float)textureRect.height / (float)size.y);
-    textureWrap->setUniform("offsetx", (float)(offset.x));
-    textureWrap->setUniform("offsety", (float)(offset.y));
+    BackgroundWrap wrap;
+    wrap.x = (float)textureRect.left / (float)size.x;
+    wrap.y = (float)textureRect.top / (float)size.y;
+    wrap.w = (float)textureRect.width / (float)size.x;
+    wrap.h = (float)textureRect.height / (float)size.y;
+    wrap.offsetx = (float)(offset.x);
+    wrap.offsety = (float)(offset.y);
+
+    BACKGROUNDS.UploadWrap(*textureWrap, wrap);
 
     states.shader = textureWrap;
 
-    // draw the vertex array
-    target.draw(vertices, states);
+    // draw the shared vertex array unless this background is tinted
+    target.draw(color == sf::Color::White ? *geometry : tinted, states);
   }
 
   /**
@@ -151,13 +138,26 @@ public:
    * @param color
    */
   void setColor(sf::Color color) {
-    for (int i = 0; i < vertices.getVertexCount(); i++) {
-      vertices[i].color = color;
+    if (this->color == color) return;
+
+    this->color = color;
+
+    if (color == sf::Color::White) return;
+
+    // Copy the shared geometry once. Later colors only touch this copy.
+    if (tinted.getVertexCount() == 0) {
+      tinted = *geometry;
+    }
+
+    for (size_t i = 0; i < tinted.getVertexCount(); i++) {
+      tinted[i].color = color;
     }
   }
 
 protected:
-  sf::VertexArray vertices; /*!< Geometry */
+  std::shared_ptr<const sf::VertexArray> geometry; /*!< Geometry shared with every background of the same size */
+  sf::VertexArray tinted; /*!< Own copy of the geometry once setColor() is used */
+  sf::Color color; /*!< Vertex color. White draws the shared geometry. */
   sf::Texture& texture; /*!< Texture aka spritesheet if animated */
   sf::IntRect textureRect; /*!< Frame of the animation if applicable */
   sf::Vector2f offset; /*!< Offset of the frame in pixels */
@@ -0,0 +1,104 @@
+#include <cmath>
+#include <algorithm>
+
+#include "bnBackgroundRegistry.h"
+#include "bnTextureResourceManager.h"
+
+BackgroundRegistry& BackgroundRegistry::GetInstance() {
+  static BackgroundRegistry instance;
+  return instance;
+}
+
+sf::Texture& BackgroundRegistry::GetTexture(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto iter = textures.find(path);
+
+  if (iter != textures.end()) {
+    return *iter->second;
+  }
+
+  // Keep the reference forever so trimming the texture cache never drops it
+  sf::Texture* texture = TEXTURES.LoadTextureFromFile(path);
+  texture->setRepeated(true);
+
+  textures.insert(std::make_pair(path, texture));
+
+  return *texture;
+}
+
+std::shared_ptr<const sf::VertexArray> BackgroundRegistry::GetGeometry(sf::Vector2u tileSize, int width, int height) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  GeometryKey key = std::make_tuple(tileSize.x, tileSize.y, width, height);
+  auto iter = geometry.find(key);
+
+  if (iter != geometry.end()) {
+    return iter->second;
+  }
+
+  // How many times can the texture fit in (width,height)?
+  unsigned occuranceX = (unsigned)std::ceil(((float)width / (float)tileSize.x));
+  unsigned occuranceY = (unsigned)std::ceil(((float)height / (float)tileSize.y));
+
+  occuranceX = std::max(occuranceX, (unsigned)1);
+  occuranceY = std::max(occuranceY, (unsigned)1);
+
+  auto vertices = std::make_shared<sf::VertexArray>(sf::Triangles, occuranceX * occuranceY * (unsigned)6);
+
+  for (unsigned int i = 0; i < occuranceX; ++i) {
+    for (unsigned int j = 0; j < occuranceY; ++j) {
+      // get a pointer to the current tile's quad
+      sf::Vertex* quad = &(*vertices)[(i + j * occuranceX) * 6];
+
+      // define its 4 corners
+      quad[0].position = sf::Vector2f((float)(i * tileSize.x * 2), (float)((j + 1) * tileSize.y * 2));
+      quad[1].position = sf::Vector2f((float)(i * tileSize.x * 2), (float)(j * tileSize.y * 2));
+      quad[2].position = sf::Vector2f((float)((i + 1) * tileSize.x * 2), (float)((j + 1) * tileSize.y * 2));
+
+      quad[3].position = sf::Vector2f((float)(i * tileSize.x * 2), (float)(j * tileSize.y * 2));
+      quad[4].position = sf::Vector2f((float)((i + 1) * tileSize.x * 2), (float)((j + 1) * tileSize.y * 2));
+      quad[5].position = sf::Vector2f((float)((i + 1) * tileSize.x * 2), (float)(j * tileSize.y * 2));
+
+      // define its 4 texture coordinates
+      quad[0].texCoords = sf::Vector2f(0, (float)tileSize.y);
+      quad[1].texCoords = sf::Vector2f(0, 0);
+      quad[2].texCoords = sf::Vector2f((float)tileSize.x, (float)tileSize.y);
+
+      quad[3].texCoords = sf::Vector2f(0, 0);
+      quad[4].texCoords = sf::Vector2f((float)tileSize.x, (float)tileSize.y);
+      quad[5].texCoords = sf::Vector2f((float)tileSize.x, 0);
+    }
+  }
+
+  geometry.insert(std::make_pair(key, vertices));
+
+  return vertices;
+}
+
+void BackgroundRegistry::UploadWrap(sf::Shader& shader, const BackgroundWrap& wrap) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Another shader or a fresh one: nothing is known about its uniforms
+  bool all = uploadedTo != &shader;
+
+  if (all || wrap.x != uploaded.x) shader.setUniform("x", wrap.x);
+  if (all || wrap.y != uploaded.y) shader.setUniform("y", wrap.y);
+  if (all || wrap.w != uploaded.w) shader.setUniform("w", wrap.w);
+  if (all || wrap.h != uploaded.h) shader.setUniform("h", wrap.h);
+  if (all || wrap.offsetx != uploaded.offsetx) shader.setUniform("offsetx", wrap.offsetx);
+  if (all || wrap.offsety != uploaded.offsety) shader.setUniform("offsety", wrap.offsety);
+
+  uploadedTo = &shader;
+  uploaded = wrap;
+}
+
+const unsigned BackgroundRegistry::GetTextureCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return (unsigned)textures.size();
+}
+
+const unsigned BackgroundRegistry::GetGeometryCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return (unsigned)geometry.size();
+}
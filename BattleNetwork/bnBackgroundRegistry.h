@@ -0,0 +1,89 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+/*! \brief Values the texel texture wrap shader reads. Compared before every upload. */
+struct BackgroundWrap {
+  float x{ 0 }, y{ 0 }, w{ 0 }, h{ 0 };
+  float offsetx{ 0 }, offsety{ 0 };
+
+  const bool operator==(const BackgroundWrap& rhs) const {
+    return x == rhs.x && y == rhs.y && w == rhs.w && h == rhs.h && offsetx == rhs.offsetx && offsety == rhs.offsety;
+  }
+
+  const bool operator!=(const BackgroundWrap& rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+/**
+ * @class BackgroundRegistry
+ * @author mav
+ * @date 10/19/20
+ * @brief Textures and screen filling geometry shared by every background
+ *
+ * Each background texture is loaded once and held for the rest of the program, so
+ * TrimTextures() at the end of a battle does not throw it away and the next battle
+ * or menu with the same background does not touch the disk.
+ *
+ * Geometry only depends on the tile size and the screen size. Backgrounds with the
+ * same sizes draw the same vertex array.
+ *
+ * Every background draws with the same wrap shader. The registry remembers the last
+ * values sent to it and only uploads uniforms that changed.
+ */
+class BackgroundRegistry {
+public:
+  /**
+   * @brief If this is the first call, initializes the registry.
+   * @return Returns reference to the background registry.
+   */
+  static BackgroundRegistry& GetInstance();
+
+  /**
+   * @brief Load a background texture the first time and return the same one after
+   * @param path Relative path to the application
+   * @return sf::Texture& set to repeat. Lives until the program ends.
+   */
+  sf::Texture& GetTexture(const std::string& path);
+
+  /**
+   * @brief Triangles that repeat a tile over the screen. Made once per set of sizes.
+   * @param tileSize size of one tile in the texture
+   * @param width of screen
+   * @param height of screen
+   * @return shared vertex array. Vertex colors are white.
+   */
+  std::shared_ptr<const sf::VertexArray> GetGeometry(sf::Vector2u tileSize, int width, int height);
+
+  /**
+   * @brief Send wrap values to the shader. Only uniforms that changed are uploaded.
+   * @param shader the wrap shader
+   * @param wrap values to send
+   */
+  void UploadWrap(sf::Shader& shader, const BackgroundWrap& wrap);
+
+  /**
+   * @brief Number of textures and geometries made so far
+   */
+  const unsigned GetTextureCount() const;
+  const unsigned GetGeometryCount() const;
+
+private:
+  BackgroundRegistry() = default;
+  ~BackgroundRegistry() = default;
+
+  using GeometryKey = std::tuple<unsigned, unsigned, int, int>;
+
+  mutable std::mutex mutex;
+  std::map<std::string, sf::Texture*> textures; /*!< one reference held per path */
+  std::map<GeometryKey, std::shared_ptr<const sf::VertexArray>> geometry;
+  sf::Shader* uploadedTo{ nullptr }; /*!< shader the last wrap values were sent to */
+  BackgroundWrap uploaded; /*!< last values sent */
+};
+
+#define BACKGROUNDS BackgroundRegistry::GetInstance()
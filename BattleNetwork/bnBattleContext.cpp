@@ -0,0 +1,201 @@
+#include <cstdlib>
+
+#include "bnBattleContext.h"
+#include "bnEngine.h"
+#include "bnField.h"
+#include "bnMob.h"
+#include "bnPlayer.h"
+#include "bnPlayerIdleState.h"
+#include "bnPlayerControlledState.h"
+#include "bnAgent.h"
+#include "bnNaviRegistration.h"
+#include "bnMobRegistration.h"
+#include "bnTraitState.h"
+
+namespace {
+  thread_local BattleContext* current = nullptr; /*!< set by Bind() */
+}
+
+BattleContext::BattleContext(unsigned seed) :
+  rng(seed),
+  entityIDs(0),
+  componentIDs(0),
+  field(nullptr),
+  mob(nullptr),
+  player(nullptr),
+  camera(sf::View(sf::Vector2f(240, 160), sf::Vector2f(480, 320))),
+  frame(0),
+  isBattleStarted(false),
+  isPlayerDeleted(false),
+  previous(nullptr)
+{
+}
+
+BattleContext::~BattleContext() {
+  // Entities being deleted can still reach for the context
+  Bind();
+
+  if (mob) {
+    delete mob;
+  }
+
+  // The field deletes every entity still on it, including the player
+  if (field) {
+    delete field;
+  }
+
+  // Nothing from this battle is left to take a turn or be counted
+  TraitState::ResetAll();
+
+  Unbind();
+}
+
+void BattleContext::Load(int naviIndex, int mobIndex) {
+  Load(naviIndex, [mobIndex](Field* field) { return MOBS.At(mobIndex).BuildMob(field); });
+}
+
+void BattleContext::Load(int naviIndex, const std::function<Mob*(Field*)>& buildMob) {
+  Bind();
+
+  // Turn orders and instance counts left by the last battle on this thread
+  TraitState::ResetAll();
+
+  field = new Field(6, 3);
+  CharacterDeleteListener::Subscribe(*field);
+
+  mob = buildMob(field);
+
+  player = NAVIS.At(naviIndex).BuildNavi();
+  player->ChangeState<PlayerIdleState>();
+  field->AddEntity(*player, 2, 2);
+
+  Unbind();
+}
+
+void BattleContext::Step(float elapsed) {
+  if (IsOver()) return;
+
+  Bind();
+
+  if (!isBattleStarted) {
+    if (mob->NextMobReady()) {
+      Mob::MobData* data = mob->GetNextMob();
+
+      Agent* cast = dynamic_cast<Agent*>(data->mob);
+
+      // Some entities have AI and need targets
+      if (cast) {
+        cast->SetTarget(player);
+      }
+
+      field->AddEntity(*data->mob, data->tileX, data->tileY);
+    }
+    else if (mob->IsSpawningDone()) {
+      mob->DefaultState();
+      player->ChangeState<PlayerControlledState>();
+      field->SetBattleActive(true);
+      isBattleStarted = true;
+    }
+  }
+
+  field->Update(elapsed);
+  field->GetEventBus().Dispatch();
+
+  input.frame = ++frame;
+
+  Unbind();
+}
+
+const bool BattleContext::IsOver() const {
+  if (isPlayerDeleted || frame >= BATTLE_CONTEXT_MAX_FRAMES) return true;
+
+  return isBattleStarted && mob->IsCleared();
+}
+
+const BattleContext::Result BattleContext::GetResult() const {
+  Result result;
+  result.playerWon = !isPlayerDeleted && isBattleStarted && mob->IsCleared();
+  result.timedOut = !result.playerWon && !isPlayerDeleted && frame >= BATTLE_CONTEXT_MAX_FRAMES;
+  result.frames = frame;
+  result.health = player ? player->GetHealth() : 0;
+  return result;
+}
+
+InputFrame& BattleContext::GetInput() {
+  return input;
+}
+
+Field* BattleContext::GetField() {
+  return field;
+}
+
+Player* BattleContext::GetPlayer() {
+  return player;
+}
+
+void BattleContext::SetPlayer(Player* player) {
+  this->player = player;
+  isPlayerDeleted = (player == nullptr);
+}
+
+const int BattleContext::NextRand() {
+  return (int)(rng() % ((unsigned)RAND_MAX + 1u));
+}
+
+const long BattleContext::NextEntityID() {
+  return ++entityIDs;
+}
+
+const long BattleContext::NextComponentID() {
+  return ++componentIDs;
+}
+
+const long BattleContext::GetLastEntityID() const {
+  return entityIDs;
+}
+
+void BattleContext::SetLastEntityID(long ID) {
+  entityIDs = ID;
+}
+
+void BattleContext::OnDeleteEvent(Character& pending) {
+  if (!isPlayerDeleted && player == &pending) {
+    isPlayerDeleted = true;
+    player = nullptr;
+  }
+
+  // Find any AI using this character as a target and free that pointer
+  field->ForEachEntity([pendingPtr = &pending](Entity* in) {
+    auto agent = dynamic_cast<Agent*>(in);
+
+    if (agent && agent->GetTarget() == pendingPtr) {
+      agent->FreeTarget();
+    }
+  });
+
+  mob->Forget(pending);
+}
+
+BattleContext* BattleContext::Current() {
+  return current;
+}
+
+int BattleContext::Rand() {
+  return current ? current->NextRand() : rand();
+}
+
+void BattleContext::Bind() {
+  previous = current;
+  current = this;
+
+  InputManager::BindThreadFrame(&input);
+  Engine::BindThreadCamera(&camera);
+}
+
+void BattleContext::Unbind() {
+  current = previous;
+  previous = nullptr;
+
+  InputManager::BindThreadFrame(current ? &current->input : nullptr);
+  Engine::BindThreadCamera(current ? &current->camera : nullptr);
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include <random>
+#include <functional>
+
+#include "bnInputManager.h"
+#include "bnCamera.h"
+#include "bnCharacterDeleteListener.h"
+
+class Field;
+class Mob;
+class Player;
+
+// Battles that are still going after this many frames end in a timeout. 5 minutes at 60 Hz.
+#define BATTLE_CONTEXT_MAX_FRAMES (60*60*5)
+
+/**
+ * @class BattleContext
+ * @author mav
+ * @date 10/19/20
+ * @brief Everything one battle needs that used to be global
+ *
+ * Each context owns its field, mob and player, its own entity and component ID
+ * counters, a seeded random number generator, the input frame the player reads and
+ * a camera for screen shake. Textures, shaders and the navi and mob registries stay
+ * shared. They are only read, except for the per-shader uniform tables, which
+ * SmartShader guards with a lock.
+ *
+ * A context is bound to the thread that steps it. While it is bound, new entities and
+ * components take their IDs from the context, BattleContext::Rand() draws from its
+ * generator, INPUT reads its input frame and ENGINE.GetCamera() returns its camera.
+ * Nothing changes for the game itself, which never binds a context.
+ *
+ * Statics that battle code keeps between frames are thread local, so a context must
+ * run from Load() to the end on one thread. Trait state is reset by Load() and by
+ * the destructor so that battles run one after another on a thread start clean.
+ */
+class BattleContext : public CharacterDeleteListener {
+public:
+  /*! \brief How the battle ended */
+  struct Result {
+    bool playerWon{ false };
+    bool timedOut{ false };
+    unsigned frames{ 0 };
+    int health{ 0 }; /*!< player health left */
+  };
+
+  /**
+   * @param seed seeds Rand() for this battle
+   */
+  BattleContext(unsigned seed);
+
+  /**
+   * @brief Deletes the field, mob and player
+   */
+  ~BattleContext();
+
+  BattleContext(const BattleContext& rhs) = delete;
+
+  /**
+   * @brief Build the field, the mob and a fresh navi from the registries
+   * @param naviIndex index into NAVIS
+   * @param mobIndex index into MOBS
+   */
+  void Load(int naviIndex, int mobIndex);
+
+  /**
+   * @brief Build the field and a fresh navi and fight a mob that is not in the registry
+   * @param naviIndex index into NAVIS
+   * @param buildMob builds the mob on the field it is given
+   */
+  void Load(int naviIndex, const std::function<Mob*(Field*)>& buildMob);
+
+  /**
+   * @brief Simulate one frame of the battle
+   * @param elapsed in seconds
+   *
+   * Spawns the mob first. The battle starts once every enemy is on the field.
+   */
+  void Step(float elapsed);
+
+  /**
+   * @brief True if a side was deleted or the frame limit was reached
+   */
+  const bool IsOver() const;
+
+  /**
+   * @brief How the battle ended so far
+   * @return Result
+   */
+  const Result GetResult() const;
+
+  /**
+   * @brief The input frame the player reads. Fill it in before each Step().
+   * @return InputFrame&
+   */
+  InputFrame& GetInput();
+
+  Field* GetField();
+  Player* GetPlayer();
+
+  /**
+   * @brief Put back a player deleted after a snapshot. Used by BattleSnapshot::Restore().
+   * @param player or null if the player was already deleted when the snapshot was made
+   */
+  void SetPlayer(Player* player);
+
+  /**
+   * @brief Draw from the battle's generator
+   * @return value between 0 and RAND_MAX
+   */
+  const int NextRand();
+
+  const long NextEntityID();
+  const long NextComponentID();
+
+  /**
+   * @brief Last entity ID handed out. Saved by BattleSnapshot.
+   */
+  const long GetLastEntityID() const;
+  void SetLastEntityID(long ID);
+
+  /**
+   * @brief Marks the player lost or removes the enemy from the mob
+   * @param pending
+   */
+  void OnDeleteEvent(Character& pending) override;
+
+  /**
+   * @brief Context bound to this thread
+   * @return BattleContext* or null if none
+   */
+  static BattleContext* Current();
+
+  /**
+   * @brief Random number for battle code
+   * @return value between 0 and RAND_MAX
+   *
+   * Uses the bound context's generator. Falls back to rand() so that seeded
+   * replays of regular battles play back the same way.
+   */
+  static int Rand();
+
+  /**
+   * @brief Make this the current context and redirect input and camera to it
+   *
+   * Load() and Step() bind for you. Bind by hand to work on the field directly.
+   */
+  void Bind();
+
+  /**
+   * @brief Put back whatever was bound before Bind()
+   */
+  void Unbind();
+
+private:
+  std::mt19937 rng;
+  long entityIDs, componentIDs;
+  Field* field;
+  Mob* mob;
+  Player* player;
+  Camera camera;
+  InputFrame input;
+  unsigned frame;
+  bool isBattleStarted, isPlayerDeleted;
+  BattleContext* previous; /*!< context that was bound before Bind() */
+};
@@ -0,0 +1,99 @@
+#include "bnBattleEventBus.h"
+#include "bnCharacter.h"
+
+BattleEventBus::BattleEventBus() : keep(nullptr), isDispatching(false) {
+}
+
+BattleEventBus::~BattleEventBus() {
+  for (auto& e : deletes) {
+    delete e.pending;
+  }
+
+  for (Character* c : graveyard) {
+    delete c;
+  }
+}
+
+void BattleEventBus::Post(ChipUsePublisher& publisher, const Chip& chip, Character& user) {
+  chipUses.push_back(ChipUseEvent{ &publisher, chip, &user });
+}
+
+void BattleEventBus::Post(CounterHitPublisher& publisher, Character& victim, Character& aggressor) {
+  counterHits.push_back(CounterHitEvent{ &publisher, &victim, &aggressor });
+}
+
+void BattleEventBus::Post(CharacterDeletePublisher& publisher, Character& pending) {
+  deletes.push_back(DeleteEvent{ &publisher, &pending });
+}
+
+void BattleEventBus::Dispatch() {
+  if (isDispatching) return;
+
+  isDispatching = true;
+  frame = Counters();
+
+  // Listeners can post more events. Swap the arrays so new posts land in the empty ones.
+  while (!chipUses.empty() || !counterHits.empty() || !deletes.empty()) {
+    chipUsesOut.swap(chipUses);
+    counterHitsOut.swap(counterHits);
+    deletesOut.swap(deletes);
+
+    for (auto& e : chipUsesOut) {
+      e.publisher->Broadcast(e.chip, *e.user);
+      frame.listenerCalls += (unsigned)e.publisher->GetListenerCount();
+    }
+
+    for (auto& e : counterHitsOut) {
+      e.publisher->Broadcast(*e.victim, *e.aggressor);
+      frame.listenerCalls += (unsigned)e.publisher->GetListenerCount();
+    }
+
+    for (auto& e : deletesOut) {
+      e.publisher->Broadcast(*e.pending);
+      frame.listenerCalls += (unsigned)e.publisher->GetListenerCount();
+      graveyard.push_back(e.pending);
+    }
+
+    frame.chipUses += (unsigned)chipUsesOut.size();
+    frame.counterHits += (unsigned)counterHitsOut.size();
+    frame.characterDeletes += (unsigned)deletesOut.size();
+
+    chipUsesOut.clear();
+    counterHitsOut.clear();
+    deletesOut.clear();
+  }
+
+  for (Character* c : graveyard) {
+    if (keep) {
+      keep->push_back(c);
+    }
+    else {
+      delete c;
+    }
+  }
+
+  graveyard.clear();
+
+  total.chipUses += frame.chipUses;
+  total.counterHits += frame.counterHits;
+  total.characterDeletes += frame.characterDeletes;
+  total.listenerCalls += frame.listenerCalls;
+
+  isDispatching = false;
+}
+
+void BattleEventBus::KeepDeleted(std::vector<Entity*>* keep) {
+  this->keep = keep;
+}
+
+const size_t BattleEventBus::GetPendingCount() const {
+  return chipUses.size() + counterHits.size() + deletes.size();
+}
+
+const BattleEventBus::Counters BattleEventBus::GetFrameCounters() const {
+  return frame;
+}
+
+const BattleEventBus::Counters BattleEventBus::GetTotalCounters() const {
+  return total;
+}
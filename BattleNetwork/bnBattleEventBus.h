@@ -0,0 +1,129 @@
+#pragma once
+#include <vector>
+
+#include "bnChip.h"
+#include "bnCharacterDeletePublisher.h"
+#include "bnChipUsePublisher.h"
+#include "bnCounterHitPublisher.h"
+
+class Entity;
+class Character;
+
+/**
+ * @class BattleEventBus
+ * @author mav
+ * @date 10/19/20
+ * @brief Queues battle events during the field update and delivers them in one batch
+ *
+ * Tiles and characters post events while the field is updating instead of
+ * calling listeners from the middle of the update loop. BattleScene calls
+ * Dispatch() once the field is done. Each event type has its own array, and
+ * the arrays are reused between frames.
+ *
+ * Dispatch order is chip use, then counter hits, then deletes. Listeners may
+ * post more events while being dispatched. Those are delivered in the same call.
+ *
+ * Characters posted for deletion are already off the field. The bus owns
+ * them and frees them after every event has been delivered, so the
+ * references given to listeners stay valid for the whole dispatch.
+ */
+class BattleEventBus {
+public:
+  /*! \brief Events delivered by a dispatch */
+  struct Counters {
+    unsigned chipUses{ 0 };
+    unsigned counterHits{ 0 };
+    unsigned characterDeletes{ 0 };
+    unsigned listenerCalls{ 0 }; /*!< listeners notified across all types */
+  };
+
+  BattleEventBus();
+
+  /**
+   * @brief Frees any characters that were posted but never dispatched
+   */
+  ~BattleEventBus();
+
+  BattleEventBus(const BattleEventBus& rhs) = delete;
+
+  /**
+   * @brief Queue a chip use. The chip is copied.
+   * @param publisher who to broadcast from
+   * @param chip
+   * @param user
+   */
+  void Post(ChipUsePublisher& publisher, const Chip& chip, Character& user);
+
+  /**
+   * @brief Queue a counter hit
+   * @param publisher who to broadcast from
+   * @param victim
+   * @param aggressor
+   */
+  void Post(CounterHitPublisher& publisher, Character& victim, Character& aggressor);
+
+  /**
+   * @brief Queue a delete and take ownership of the character
+   * @param publisher who to broadcast from
+   * @param pending character removed from the field. Deleted after the dispatch.
+   */
+  void Post(CharacterDeletePublisher& publisher, Character& pending);
+
+  /**
+   * @brief Deliver everything that was posted and free deleted characters
+   *
+   * Does nothing if called again from inside a listener.
+   */
+  void Dispatch();
+
+  /**
+   * @brief Hand deleted characters to a list instead of freeing them
+   * @param keep list that takes the characters after each dispatch, or null to free them again
+   *
+   * Field::KeepDeleted() uses this so a snapshot can bring the characters back.
+   */
+  void KeepDeleted(std::vector<Entity*>* keep);
+
+  /**
+   * @brief Number of events waiting to be dispatched
+   */
+  const size_t GetPendingCount() const;
+
+  /**
+   * @brief Events delivered by the last Dispatch()
+   * @return Counters
+   */
+  const Counters GetFrameCounters() const;
+
+  /**
+   * @brief Events delivered since the bus was made
+   * @return Counters
+   */
+  const Counters GetTotalCounters() const;
+
+private:
+  struct ChipUseEvent {
+    ChipUsePublisher* publisher;
+    Chip chip;
+    Character* user;
+  };
+
+  struct CounterHitEvent {
+    CounterHitPublisher* publisher;
+    Character* victim;
+    Character* aggressor;
+  };
+
+  struct DeleteEvent {
+    CharacterDeletePublisher* publisher;
+    Character* pending;
+  };
+
+  std::vector<ChipUseEvent> chipUses, chipUsesOut; /*!< posted and being dispatched */
+  std::vector<CounterHitEvent> counterHits, counterHitsOut;
+  std::vector<DeleteEvent> deletes, deletesOut;
+  std::vector<Character*> graveyard; /*!< freed at the end of Dispatch() */
+  std::vector<Entity*>* keep; /*!< takes the graveyard instead if set */
+  bool isDispatching;
+  Counters frame, total;
+};
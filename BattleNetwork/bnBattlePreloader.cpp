@@ -0,0 +1,93 @@
+#include <SFML/System/Clock.hpp>
+
+#include "bnBattlePreloader.h"
+#include "bnAnimation.h"
+#include "bnLogger.h"
+
+namespace {
+  sf::Clock requestClock; /*!< restarted by MarkBattleRequested() */
+  bool isRequestPending = false;
+  std::atomic<unsigned> totalParsed(0); /*!< files parsed by every preloader */
+
+  /*! Animations every battle loads no matter the navi or mob */
+  const char* BATTLE_ANIMATIONS[] = {
+    "resources/tiles/tiles.animation",
+    "resources/mobs/mob_move.animation",
+    "resources/mobs/mob_explosion.animation",
+    "resources/mobs/boss_shine.animation"
+  };
+}
+
+BattlePreloader::BattlePreloader() : isDone(false), stop(false), parsed(0) {
+}
+
+BattlePreloader::~BattlePreloader() {
+  Stop();
+}
+
+void BattlePreloader::Start(const std::vector<std::string>& paths) {
+#if OBN_PRELOAD_BATTLE
+  // The worker only reads paths, so it must be done with the old list first
+  Stop();
+
+  this->paths = paths;
+  this->paths.insert(this->paths.end(), std::begin(BATTLE_ANIMATIONS), std::end(BATTLE_ANIMATIONS));
+
+  isDone = false;
+  stop = false;
+  parsed = 0;
+
+  worker = std::thread(&BattlePreloader::Run, this);
+#endif
+}
+
+void BattlePreloader::Stop() {
+  stop = true;
+
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+const bool BattlePreloader::IsDone() const {
+  return isDone;
+}
+
+const unsigned BattlePreloader::GetParsedCount() const {
+  return parsed;
+}
+
+void BattlePreloader::MarkBattleRequested() {
+  requestClock.restart();
+  isRequestPending = true;
+}
+
+void BattlePreloader::MarkFirstBattleFrame() {
+  if (!isRequestPending) return;
+
+  isRequestPending = false;
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Time to first battle frame: %.2f ms (%u animation files preloaded)",
+    requestClock.getElapsedTime().asMicroseconds() / 1000.0, totalParsed.load());
+  Logger::GetMutex()->unlock();
+}
+
+void BattlePreloader::Run() {
+  sf::Clock clock;
+
+  for (auto& path : paths) {
+    if (stop) break;
+
+    if (Animation::Preload(path)) {
+      parsed++;
+      totalParsed++;
+    }
+  }
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Preloaded %u animation files for battle: %.2f ms", parsed.load(), clock.getElapsedTime().asMicroseconds() / 1000.0);
+  Logger::GetMutex()->unlock();
+
+  isDone = true;
+}
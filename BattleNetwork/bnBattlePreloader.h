@@ -0,0 +1,77 @@
+#pragma once
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Set to 0 to build the battle without any preparation and compare time to first battle frame
+#ifndef OBN_PRELOAD_BATTLE
+#define OBN_PRELOAD_BATTLE 1
+#endif
+
+/**
+ * @class BattlePreloader
+ * @author mav
+ * @date 10/19/20
+ * @brief Parses battle content on a worker thread while the player is choosing a mob
+ *
+ * The selected navi's and mob's animation files and the few every battle uses are
+ * parsed into the shared animation cache, so building the mob, the navi and the
+ * battle UI on the frame of the transition only copies frame lists instead of reading
+ * and parsing files. Files are read through VFS like every other load.
+ *
+ * The mob and BattleScene are still made on the main thread. Turn order and instance
+ * counting traits register characters per thread, and the scene creates GL objects
+ * that belong to the thread that draws.
+ *
+ * MarkBattleRequested() and MarkFirstBattleFrame() log the time from confirming a mob
+ * to the first frame the battle draws.
+ */
+class BattlePreloader {
+public:
+  BattlePreloader();
+
+  /**
+   * @brief Stops the worker early if it is still running
+   */
+  ~BattlePreloader();
+
+  BattlePreloader(const BattlePreloader& rhs) = delete;
+
+  /**
+   * @brief Start parsing the battle's files on the worker
+   * @param paths animation files of the selected navi and mob
+   *
+   * Stops the worker first if it is still parsing for another selection.
+   */
+  void Start(const std::vector<std::string>& paths);
+
+  /**
+   * @brief True once every file has been parsed
+   */
+  const bool IsDone() const;
+
+  /**
+   * @brief Files parsed by the worker so far
+   */
+  const unsigned GetParsedCount() const;
+
+  /**
+   * @brief Call when the player confirms a battle
+   */
+  static void MarkBattleRequested();
+
+  /**
+   * @brief Call when the battle draws. Logs the time since MarkBattleRequested() the first time.
+   */
+  static void MarkFirstBattleFrame();
+
+private:
+  void Stop();
+  void Run();
+
+  std::thread worker;
+  std::vector<std::string> paths; /*!< files the worker parses */
+  std::atomic<bool> isDone, stop;
+  std::atomic<unsigned> parsed;
+};
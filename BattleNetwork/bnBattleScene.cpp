@@ -11,6 +11,8 @@
 #include "bnJudgeTreeBackground.h"
 #include "bnPlayerHealthUI.h"
 #include "bnPaletteSwap.h"
+#include "bnReplayManager.h"
+#include "bnBattlePreloader.h"
 
 // Android only headers
 #include "Android/bnTouchArea.h"
@@ -18,6 +20,8 @@
 #include "Segues/WhiteWashFade.h"
 #include "Segues/PixelateBlackWashFade.h"
 
+#define CUSTOM_BAR_TEXTURE_PATH "resources/ui/custom.png"
+
 // modals like chip cust and battle reward slide in 12px per frame for 10 frames. 60 frames = 1 sec
 // modal slide moves 120px in 1/6th of a second
 // Per 1 second that is 6*120px in 6*1/6 of a sec = 720px in 1 sec
@@ -28,6 +32,20 @@
 // If x = 20 frames, then we want a combo hit threshold of 20/60 = 0.3 seconds
 #define COMBO_HIT_THRESHOLD_SECONDS 20.0f/60.0f
 
+/**
+ * @brief Draw order for entities on the same row
+ * 
+ * Entities on the same layer have no defined order between them,
+ * so group them by shader to avoid switching shader programs between draws
+ */
+static bool DrawOrder(Entity* a, Entity* b) {
+  if (a->GetLayer() != b->GetLayer()) {
+    return a->GetLayer() > b->GetLayer();
+  }
+
+  return std::less<sf::Shader*>()(a->GetShader().Get(), b->GetShader().Get());
+}
+
 BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player, Mob* mob, ChipFolder* folder) :
         swoosh::Activity(&controller),
         player(player),
@@ -58,6 +76,20 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
     Logger::Log(std::string("Warning: Mob was empty when battle started. Mob Type: ") + typeid(mob).name());
   }
 
+  // Open the battle music in the background while the segue plays
+  // so onStart() does not wait on the file
+  if (mob->HasCustomMusicPath()) {
+    AUDIO.PrefetchStream(mob->GetCustomMusicPath());
+  }
+  else if (!mob->IsBoss()) {
+    AUDIO.PrefetchStream("resources/loops/loop_battle.ogg");
+  }
+  else {
+    AUDIO.PrefetchStream("resources/loops/loop_boss_battle.ogg");
+  }
+
+  AUDIO.PrefetchStream("resources/loops/enemy_deleted.ogg");
+
   /*
   Set Scene*/
   field = mob->GetField();
@@ -180,7 +212,7 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
   pauseLabel->setPosition(sf::Vector2f(240.f, 160.f));
 
   // CHIP CUST GRAPHICS
-  customBarTexture = TEXTURES.LoadTextureFromFile("resources/ui/custom.png");
+  customBarTexture = TEXTURES.LoadTextureFromFile(CUSTOM_BAR_TEXTURE_PATH);
   customBarSprite.setTexture(*customBarTexture);
   customBarSprite.setOrigin(customBarSprite.getLocalBounds().width / 2, 0);
   customBarPos = sf::Vector2f(240.f, 0.f);
@@ -265,8 +297,20 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
 
 BattleScene::~BattleScene()
 {
+  // Saves the replay if this battle was recorded
+  REPLAYS.EndBattle();
+
   components.clear();
   scenenodes.clear();
+
+  TEXTURES.ReleaseTexture(CUSTOM_BAR_TEXTURE_PATH);
+
+  // Free chip textures nobody else is holding. Backgrounds keep theirs for the next battle.
+  TEXTURES.TrimTextures();
+
+  const TextureCacheStats stats = TEXTURES.GetCacheStats();
+  Logger::Logf("Texture cache: %u hits, %u misses (%u prefetched), %u textures resident, %u KB",
+    stats.hits, stats.misses, stats.prefetchHits, stats.resident, (unsigned)(stats.bytesResident / 1024));
 }
 
 // What to do if we inject a chip publisher, subscribe it to the main listener
@@ -309,9 +353,9 @@ void BattleScene::Eject(Component * other)
 void BattleScene::ProcessNewestComponents()
 {
   // effectively returns all of them
-  auto entities = field->FindEntities([](Entity* e) { return true; });
+  field->FindEntities(entityBuffer, [](Entity* e) { return true; });
 
-  for (auto e : entities) {
+  for (auto e : entityBuffer) {
     if (e->components.size() > 0) {
       // update the ledger
       // Injects usually removes the owner so this step proceeds the lastComponentID update
@@ -411,14 +455,12 @@ void BattleScene::OnDeleteEvent(Character & pending)
   }
 
   // Find any AI using this character as a target and free that pointer  
-  field->FindEntities([pendingPtr = &pending](Entity* in) {
+  field->ForEachEntity([pendingPtr = &pending](Entity* in) {
     auto agent = dynamic_cast<Agent*>(in);
 
     if (agent && agent->GetTarget() == pendingPtr) {
       agent->FreeTarget();
     }
-
-    return false;
   });
 
   Logger::Logf("Deleting %s from battle", pending.GetName().c_str());
@@ -426,6 +468,9 @@ void BattleScene::OnDeleteEvent(Character & pending)
 }
 
 void BattleScene::onUpdate(double elapsed) {
+  // Record this frame's input or replace it with the recorded input
+  REPLAYS.Step();
+
   this->elapsed = elapsed;
 
   shineAnimation.Update((float)elapsed, shine);
@@ -613,6 +658,9 @@ void BattleScene::onUpdate(double elapsed) {
     field->Update((float)elapsed);
   } 
 
+  // Deliver deletes, counters, and enemy chip use from this frame in one place
+  field->GetEventBus().Dispatch();
+
   int newMobSize = mob->GetRemainingMobCount();
 
   if (lastMobSize != newMobSize) {
@@ -686,6 +734,8 @@ void BattleScene::onUpdate(double elapsed) {
 }
 
 void BattleScene::onDraw(sf::RenderTexture& surface) {
+  BattlePreloader::MarkFirstBattleFrame();
+
   ENGINE.SetRenderSurface(surface);
 
   ENGINE.Clear();
@@ -703,7 +753,7 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
   // First tile pass: draw the tiles
   Battle::Tile* tile = nullptr;
 
-  auto allTiles = field->FindTiles([](Battle::Tile* tile) { return true; });
+  field->FindTiles(allTiles, [](Battle::Tile* tile) { return true; });
   auto tilesIter = allTiles.begin();
 
   while (tilesIter != allTiles.end()) {
@@ -751,8 +801,8 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
     if (lastRow != (*tilesIter)->GetY()) {
       lastRow = (*tilesIter)->GetY();
 
-      // Ensure all entities are sorted by layer
-      std::sort(entitiesOnRow.begin(), entitiesOnRow.end(), [](Entity* a, Entity*b) -> bool { return a->GetLayer() > b->GetLayer(); });
+      // Ensure all entities are sorted by layer and then by shader
+      std::sort(entitiesOnRow.begin(), entitiesOnRow.end(), DrawOrder);
 
       // draw this row
       for (auto entity : entitiesOnRow) {
@@ -781,13 +831,7 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
       //iceShader.setUniform("w", tile->GetWidth() - 8.f);
       //iceShader.setUniform("h", tile->GetHeight()*0.8f);
 
-      Entity* entity = nullptr;
-
-      auto allEntities = tile->FindEntities([](Entity* e) { return true; });
-      auto entitiesIter = allEntities.begin();
-
-      while (entitiesIter != allEntities.end()) {
-          entity = (*entitiesIter);
+      tile->ForEachEntity([&ui, &entitiesOnRow](Entity* entity) {
         if (!entity->IsDeleted()) {
           auto uic = entity->GetComponentsDerivedFrom<UIComponent>();
 
@@ -797,12 +841,9 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
             ui.insert(ui.begin(), uic.begin(), uic.end());
           }
 
-          entitiesOnRow.push_back(*entitiesIter);
-
+          entitiesOnRow.push_back(entity);
         }
-
-          entitiesIter++;
-      }
+      });
 
       /*if (tile->GetState() == TileState::LAVA) {
         heatShader.setUniform("x", tile->getPosition().x - tile->getTexture()->getSize().x + 3.0f);
@@ -848,8 +889,8 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
   }
 
   // Last row needs to be drawn now that the loop is over
-  // Ensure all entities are sorted by layer
-  std::sort(entitiesOnRow.begin(), entitiesOnRow.end(), [](Entity* a, Entity*b) -> bool { return a->GetLayer() > b->GetLayer(); });
+  // Ensure all entities are sorted by layer and then by shader
+  std::sort(entitiesOnRow.begin(), entitiesOnRow.end(), DrawOrder);
 
   // draw this row
   for (auto entity : entitiesOnRow) {
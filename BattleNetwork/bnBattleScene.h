@@ -147,6 +147,10 @@ private:
   // Other components
   std::vector<Component*> components; /*!< Components injected into the scene */
 
+  // Field queries write into these every frame and keep their capacity
+  std::vector<Entity*> entityBuffer; /*!< Every entity on the field */
+  std::vector<Battle::Tile*> allTiles; /*!< Every tile on the field */
+
   /*
   Background for scene*/
   Background* background; /*!< Custom backgrounds provided by Mob data */
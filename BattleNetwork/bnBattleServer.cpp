@@ -0,0 +1,164 @@
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <SFML/System.hpp>
+
+#include "bnBattleServer.h"
+#include "bnBattleContext.h"
+#include "bnNaviRegistration.h"
+#include "bnMobRegistration.h"
+#include "bnLogger.h"
+
+namespace {
+  // Frames the bot holds the buster before letting go
+  const unsigned CHARGE_FRAMES = 90;
+
+  /*! \brief Per worker totals. Added into the report once the worker is done. */
+  struct WorkerTotals {
+    unsigned wins{ 0 };
+    unsigned losses{ 0 };
+    unsigned timeouts{ 0 };
+    unsigned long long frames{ 0 };
+  };
+}
+
+BattleServer::BattleServer(unsigned threads) : threads(threads) {
+  if (this->threads == 0) {
+    this->threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+const BattleServer::Report BattleServer::Run(unsigned battles, unsigned seed) {
+  Report report;
+  report.battles = battles;
+  report.threads = threads;
+
+  const unsigned navis = NAVIS.Size();
+  const unsigned mobs = MOBS.Size();
+
+  if (battles == 0 || navis == 0 || mobs == 0) return report;
+
+  std::atomic<unsigned> next(0);
+  std::vector<WorkerTotals> totals(threads);
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+
+  const float step = 1.0f / 60.0f;
+
+  sf::Clock clock;
+
+  for (unsigned t = 0; t < threads; t++) {
+    workers.emplace_back([&, t]() {
+      WorkerTotals& out = totals[t];
+
+      for (unsigned n = next++; n < battles; n = next++) {
+        BattleContext context(seed + n * 7919u);
+        context.Load((int)(n % navis), (int)(n % mobs));
+
+        while (!context.IsOver()) {
+          Drive(context);
+          context.Step(step);
+        }
+
+        BattleContext::Result result = context.GetResult();
+        out.frames += result.frames;
+
+        if (result.playerWon) {
+          out.wins++;
+        }
+        else if (result.timedOut) {
+          out.timeouts++;
+        }
+        else {
+          out.losses++;
+        }
+      }
+    });
+  }
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  report.seconds = clock.getElapsedTime().asSeconds();
+
+  for (const WorkerTotals& out : totals) {
+    report.wins += out.wins;
+    report.losses += out.losses;
+    report.timeouts += out.timeouts;
+    report.frames += out.frames;
+  }
+
+  report.battlesPerSecond = report.seconds > 0 ? battles / report.seconds : 0;
+
+  return report;
+}
+
+void BattleServer::Drive(BattleContext& context) {
+  static const int shoot = InputManager::GetActionIndex("Shoot");
+  static const int moves[4] = {
+    InputManager::GetActionIndex("Move Up"),
+    InputManager::GetActionIndex("Move Down"),
+    InputManager::GetActionIndex("Move Left"),
+    InputManager::GetActionIndex("Move Right")
+  };
+
+  InputFrame& input = context.GetInput();
+
+  // Held buttons carry over. Presses and releases only last one frame.
+  input.pressed.reset();
+  input.released.reset();
+
+  for (int move : moves) {
+    if (input.held[move]) {
+      input.held[move] = false;
+      input.released[move] = true;
+    }
+  }
+
+  if (input.frame % (CHARGE_FRAMES + 1) == 0) {
+    input.pressed[shoot] = true;
+    input.held[shoot] = true;
+  }
+  else if (input.frame % (CHARGE_FRAMES + 1) == CHARGE_FRAMES) {
+    input.held[shoot] = false;
+    input.released[shoot] = true;
+  }
+
+  if (context.NextRand() % 20 == 0) {
+    int move = moves[context.NextRand() % 4];
+    input.pressed[move] = true;
+    input.held[move] = true;
+  }
+}
+
+void BattleServer::RunBenchmark(unsigned battles) {
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned seed = 1;
+
+  std::cout << "threads,battles,wins,losses,timeouts,frames,seconds,battles_per_sec" << std::endl;
+
+  // Powers of two, then every core even if that is not a power of two
+  std::vector<unsigned> counts;
+
+  for (unsigned threads = 1; threads < cores; threads *= 2) {
+    counts.push_back(threads);
+  }
+
+  counts.push_back(cores);
+
+  for (unsigned threads : counts) {
+    BattleServer server(threads);
+    Report report = server.Run(battles, seed);
+
+    std::cout << report.threads << "," << report.battles << "," << report.wins << ","
+      << report.losses << "," << report.timeouts << "," << report.frames << ","
+      << report.seconds << "," << report.battlesPerSecond << std::endl;
+  }
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Battle server benchmark: %u battles per run, up to %u threads", battles, cores);
+  Logger::GetMutex()->unlock();
+}
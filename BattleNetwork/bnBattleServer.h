@@ -0,0 +1,64 @@
+#pragma once
+
+class BattleContext;
+
+/**
+ * @class BattleServer
+ * @author mav
+ * @date 10/19/20
+ * @brief Runs many headless battles at once on a pool of worker threads
+ *
+ * Workers take the next battle number from a shared counter, then load and step that
+ * battle to the end before taking another one. Battles never share a field, IDs or
+ * random numbers, so no locks are taken while stepping except by scripted characters,
+ * which share one lua state. Each battle runs on a single worker because the thread
+ * local state it binds cannot move between threads.
+ *
+ * Battle n uses navi n and mob n, wrapping around the registries, and is seeded
+ * from the server seed and n. The same seed gives the same results no matter how
+ * many threads run them.
+ */
+class BattleServer {
+public:
+  /*! \brief Totals of one Run() */
+  struct Report {
+    unsigned battles{ 0 };
+    unsigned threads{ 0 };
+    unsigned wins{ 0 };
+    unsigned losses{ 0 };
+    unsigned timeouts{ 0 };
+    unsigned long long frames{ 0 }; /*!< frames simulated across every battle */
+    double seconds{ 0 };
+    double battlesPerSecond{ 0 };
+  };
+
+  /**
+   * @param threads worker count. 0 uses one per hardware thread.
+   */
+  BattleServer(unsigned threads = 0);
+
+  /**
+   * @brief Run battles until all of them are over
+   * @param battles how many to run
+   * @param seed seeds each battle's generator along with its number
+   * @return Report
+   */
+  const Report Run(unsigned battles, unsigned seed);
+
+  /**
+   * @brief Fill in the player's input for the next frame
+   * @param context battle to drive
+   *
+   * Charges and releases the buster and moves at random.
+   */
+  static void Drive(BattleContext& context);
+
+  /**
+   * @brief Run the same battles on 1 thread up to every hardware thread and print the throughput as CSV
+   * @param battles battles per run
+   */
+  static void RunBenchmark(unsigned battles);
+
+private:
+  unsigned threads;
+};
@@ -0,0 +1,728 @@
+#include "bnBattleSnapshot.h"
+#include "bnField.h"
+#include "bnTile.h"
+#include "bnEntity.h"
+#include "bnCharacter.h"
+#include "bnSpell.h"
+#include "bnObstacle.h"
+#include "bnArtifact.h"
+#include "bnMettaur.h"
+#include "bnPlayer.h"
+#include "bnMob.h"
+#include "bnLogger.h"
+#include "bnBattleContext.h"
+#include <algorithm>
+
+BattleSnapshot::BattleSnapshot(size_t capacity) : buffer(capacity), length(0), cursor(0) {
+}
+
+BattleSnapshot::~BattleSnapshot() {
+}
+
+void BattleSnapshot::Save(Field& field, Mob* mob) {
+  length = 0;
+  stats = Stats();
+
+  // Entities deleted before now are not in this snapshot. Keep the ones deleted from here on.
+  field.ClearGraveyard();
+  field.KeepDeleted(true);
+
+  Gather(field);
+
+  // Battles running in a BattleContext count their own IDs
+  BattleContext* context = BattleContext::Current();
+  Write(context ? context->GetLastEntityID() : Entity::numOfIDs);
+  Write(field.width);
+  Write(field.height);
+  Write(field.isBattleActive);
+
+  // Every entity Restore() needs, so it can check them all before changing anything
+  Write((uint32_t)live.size());
+
+  for (auto& l : live) {
+    Write(l.ID);
+  }
+
+  Write(mob != nullptr);
+
+  if (mob) {
+    Write((uint32_t)mob->spawn.size());
+
+    for (Mob::MobData* data : mob->spawn) {
+      Write(data->mob->GetID());
+      Write(data->tileX);
+      Write(data->tileY);
+      Write(data->index);
+    }
+
+    Write((uint32_t)(mob->iter - mob->spawn.begin()));
+    Write(mob->nextReady);
+  }
+
+  bool hasPlayer = context && context->GetField() == &field;
+  Write(hasPlayer);
+
+  if (hasPlayer) {
+    Player* player = context->GetPlayer();
+    Write(player ? player->GetID() : 0L);
+  }
+
+  for (auto& l : live) {
+    Write(l.ID);
+
+    size_t block = BeginBlock();
+    l.entity->SaveState(*this);
+    EndBlock(block);
+  }
+
+  Write((uint32_t)field.pending.size());
+
+  for (auto& next : field.pending) {
+    Write(next.x);
+    Write(next.y);
+    Write(next.ID);
+    Write(next.entity_type);
+  }
+
+  for (Battle::Tile& next : field.tiles) {
+    Battle::Tile* tile = &next;
+
+    Write(tile->team);
+    Write(tile->state);
+    Write(tile->elapsed);
+    Write(tile->teamCooldown);
+    Write(tile->brokenCooldown);
+    Write(tile->flickerTeamCooldown);
+    Write(tile->totalElapsed);
+    Write(tile->willHighlight);
+    Write(tile->highlightMode);
+    Write(tile->isBattleActive);
+    Write(tile->elapsedBurnTime);
+    Write(tile->burncycle);
+
+    // Buckets are written in order so iteration order is the same after a restore
+    Write((uint32_t)tile->entities.size());
+    for (Entity* e : tile->entities) Write(e->GetID());
+
+    Write((uint32_t)tile->spells.size());
+    for (Spell* s : tile->spells) Write(s->GetID());
+
+    Write((uint32_t)tile->characters.size());
+    for (Character* c : tile->characters) Write(c->GetID());
+
+    Write((uint32_t)tile->artifacts.size());
+    for (Artifact* a : tile->artifacts) Write(a->GetID());
+
+    Write((uint32_t)tile->reserved.size());
+    for (long ID : tile->reserved) Write(ID);
+
+    Write((uint32_t)tile->queuedSpells.size());
+    for (long ID : tile->queuedSpells) Write(ID);
+
+    Write((uint32_t)tile->taggedSpells.size());
+    for (long ID : tile->taggedSpells) Write(ID);
+  }
+
+  stats.bytes = length;
+  stats.entities = (unsigned)live.size();
+}
+
+const bool BattleSnapshot::Restore(Field& field, Mob* mob) {
+  stats = Stats();
+
+  if (IsEmpty()) return false;
+
+  // Deletes still on the bus go to the graveyard so they can be brought back
+  field.GetEventBus().Dispatch();
+
+  cursor = 0;
+
+  Gather(field);
+
+  int width = 0, height = 0;
+  long lastID = 0;
+  bool isBattleActive = false;
+
+  Read(lastID);
+  Read(width);
+  Read(height);
+  Read(isBattleActive);
+
+  if (width != field.width || height != field.height) {
+    Logger::Log("BattleSnapshot: cannot restore a snapshot of a different field");
+    live.clear();
+    return false;
+  }
+
+  auto isBuried = [&field](long ID) {
+    return std::find_if(field.graveyard.begin(), field.graveyard.end(), [ID](Entity* e) { return e->GetID() == ID; }) != field.graveyard.end();
+  };
+
+  uint32_t count = 0;
+  Read(count);
+
+  savedIDs.clear();
+
+  for (uint32_t i = 0; i < count; i++) {
+    long ID = 0;
+    Read(ID);
+    savedIDs.push_back(ID);
+
+    if (!Find(ID) && !isBuried(ID)) {
+      stats.missing++;
+    }
+  }
+
+  bool hasMob = false;
+  uint32_t spawnIndex = 0;
+  bool nextReady = true;
+
+  Read(hasMob);
+
+  mobEntries.clear();
+
+  if (hasMob) {
+    Read(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+      MobEntry entry;
+
+      Read(entry.ID);
+      Read(entry.tileX);
+      Read(entry.tileY);
+      Read(entry.index);
+
+      mobEntries.push_back(entry);
+
+      long ID = entry.ID;
+
+      // Enemies that have not spawned yet are only known to the mob
+      bool waiting = mob && std::find_if(mob->spawn.begin(), mob->spawn.end(), [ID](Mob::MobData* d) { return d->mob->GetID() == ID; }) != mob->spawn.end();
+
+      if (mob && !waiting && !Find(ID) && !isBuried(ID)) {
+        stats.missing++;
+      }
+    }
+
+    Read(spawnIndex);
+    Read(nextReady);
+  }
+
+  // Nothing has been changed yet. A snapshot that cannot be restored in full is not restored at all.
+  if (stats.missing > 0) {
+    Logger::GetMutex()->lock();
+    Logger::Logf("BattleSnapshot: %u saved entities no longer exist. Nothing was restored.", stats.missing);
+    Logger::GetMutex()->unlock();
+
+    live.clear();
+    return false;
+  }
+
+  Revive(field);
+
+  field.isBattleActive = isBattleActive;
+
+  bool hasPlayer = false;
+  long playerID = 0;
+
+  Read(hasPlayer);
+
+  if (hasPlayer) {
+    Read(playerID);
+  }
+
+  Read(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    long ID = 0;
+    Read(ID);
+
+    size_t end = ReadBlock();
+
+    if (Live* l = Find(ID)) {
+      l->entity->LoadState(*this);
+      stats.entities++;
+    }
+
+    EndReadBlock(end);
+  }
+
+  // After LoadState() so entities made by AI states entering again go too
+  RemoveUnsaved(field, mob);
+
+  BattleContext* context = BattleContext::Current();
+
+  if (context) {
+    context->SetLastEntityID(lastID);
+  }
+  else {
+    Entity::numOfIDs = lastID;
+  }
+
+  if (hasPlayer && context && context->GetField() == &field) {
+    context->SetPlayer(dynamic_cast<Player*>(FindCharacter(playerID)));
+  }
+
+  if (hasMob && mob) {
+    std::vector<Mob::MobData*> spawn;
+
+    for (auto& entry : mobEntries) {
+      long ID = entry.ID;
+      auto kept = std::find_if(mob->spawn.begin(), mob->spawn.end(), [ID](Mob::MobData* d) { return d->mob->GetID() == ID; });
+
+      if (kept != mob->spawn.end()) {
+        spawn.push_back(*kept);
+        mob->spawn.erase(kept);
+      }
+      else {
+        // Forgotten when it was deleted. The character is back on the field.
+        spawn.push_back(new Mob::MobData{ FindCharacter(ID), entry.tileX, entry.tileY, entry.index });
+      }
+    }
+
+    for (Mob::MobData* data : mob->spawn) {
+      delete data;
+    }
+
+    mob->spawn.swap(spawn);
+    mob->iter = mob->spawn.begin() + std::min((size_t)spawnIndex, mob->spawn.size());
+    mob->nextReady = nextReady;
+  }
+
+  Read(count);
+
+  field.pending.clear();
+
+  for (uint32_t i = 0; i < count; i++) {
+    int x = 0, y = 0;
+    long ID = 0;
+    Field::queueBucket::type type = Field::queueBucket::type::character;
+
+    Read(x);
+    Read(y);
+    Read(ID);
+    Read(type);
+
+    Live* l = Find(ID);
+
+    if (!l) continue;
+
+    switch (type) {
+    case Field::queueBucket::type::character:
+      if (l->character) field.pending.push_back(Field::queueBucket(x, y, *l->character));
+      break;
+    case Field::queueBucket::type::spell:
+      if (l->spell) field.pending.push_back(Field::queueBucket(x, y, *l->spell));
+      break;
+    case Field::queueBucket::type::obstacle:
+      // Obstacles are only in the spell bucket once on a tile
+      if (Obstacle* obst = dynamic_cast<Obstacle*>(l->entity)) field.pending.push_back(Field::queueBucket(x, y, *obst));
+      break;
+    case Field::queueBucket::type::artifact:
+      if (l->artifact) field.pending.push_back(Field::queueBucket(x, y, *l->artifact));
+      break;
+    }
+  }
+
+  for (Battle::Tile& next : field.tiles) {
+    Battle::Tile* tile = &next;
+
+    TileState state = tile->state;
+
+    Read(tile->team);
+    Read(tile->state);
+    Read(tile->elapsed);
+    Read(tile->teamCooldown);
+    Read(tile->brokenCooldown);
+    Read(tile->flickerTeamCooldown);
+    Read(tile->totalElapsed);
+    Read(tile->willHighlight);
+    Read(tile->highlightMode);
+    Read(tile->isBattleActive);
+    Read(tile->elapsedBurnTime);
+    Read(tile->burncycle);
+
+    if (state != tile->state) {
+      tile->RefreshTexture();
+    }
+
+    long ID = 0;
+
+    tile->entities.clear();
+    Read(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Read(ID);
+      Live* l = Find(ID);
+      if (l) tile->entities.push_back(l->entity);
+    }
+
+    tile->spells.clear();
+    Read(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Read(ID);
+      Live* l = Find(ID);
+      if (l && l->spell) tile->spells.push_back(l->spell);
+    }
+
+    tile->characters.clear();
+    Read(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Read(ID);
+      Live* l = Find(ID);
+      if (l && l->character) tile->characters.push_back(l->character);
+    }
+
+    tile->artifacts.clear();
+    Read(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Read(ID);
+      Live* l = Find(ID);
+      if (l && l->artifact) tile->artifacts.push_back(l->artifact);
+    }
+
+    tile->reserved.clear();
+    Read(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Read(ID);
+      tile->reserved.insert(ID);
+    }
+
+    tile->queuedSpells.clear();
+    Read(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Read(ID);
+      tile->queuedSpells.push_back(ID);
+    }
+
+    tile->taggedSpells.clear();
+    Read(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Read(ID);
+      tile->taggedSpells.push_back(ID);
+    }
+  }
+
+  live.clear();
+
+  // Tiles and teams were put back directly
+  field.RecountColumns();
+
+  stats.bytes = length;
+
+  return true;
+}
+
+void BattleSnapshot::Revive(Field& field) {
+  // Saved entities deleted since go back into the live set. Anything else in the graveyard was made after the snapshot.
+  for (Entity* e : field.graveyard) {
+    if (!IsSaved(e->GetID())) {
+      delete e;
+      continue;
+    }
+
+    Live l;
+    l.ID = e->GetID();
+    l.entity = e;
+    l.character = dynamic_cast<Character*>(e);
+    l.spell = dynamic_cast<Spell*>(e);
+    l.artifact = dynamic_cast<Artifact*>(e);
+    live.push_back(l);
+
+    stats.revived++;
+  }
+
+  field.graveyard.clear();
+
+  std::sort(live.begin(), live.end(), [](const Live& a, const Live& b) { return a.ID < b.ID; });
+}
+
+void BattleSnapshot::RemoveUnsaved(Field& field, Mob* mob) {
+  unsaved.clear();
+
+  for (Battle::Tile& next : field.tiles) {
+    for (Entity* e : next.entities) {
+      if (!IsSaved(e->GetID())) {
+        unsaved.push_back(std::make_pair(&next, e));
+      }
+    }
+  }
+
+  for (auto& next : field.pending) {
+    if (IsSaved(next.ID)) continue;
+
+    Entity* e = nullptr;
+
+    switch (next.entity_type) {
+    case Field::queueBucket::type::character: e = next.data.character; break;
+    case Field::queueBucket::type::spell:     e = next.data.spell; break;
+    case Field::queueBucket::type::obstacle:  e = next.data.obstacle; break;
+    case Field::queueBucket::type::artifact:  e = next.data.artifact; break;
+    }
+
+    unsaved.push_back(std::make_pair(&field.At(next.x, next.y), e));
+  }
+
+  for (auto& next : unsaved) {
+    Battle::Tile* tile = next.first;
+    Entity* e = next.second;
+
+    // Takes it out of the buckets, the column counts and the pending queue
+    tile->RemoveEntityByID(e->GetID());
+
+    // Listeners hear about characters the same way as when a tile deletes them
+    if (Character* character = dynamic_cast<Character*>(e)) {
+      if (mob) {
+        mob->Forget(*character);
+      }
+
+      field.GetEventBus().Post(field, *character);
+    }
+    else {
+      field.ReleaseEntity(e);
+    }
+
+    stats.removed++;
+  }
+
+  unsaved.clear();
+}
+
+const bool BattleSnapshot::IsSaved(long ID) const {
+  return std::binary_search(savedIDs.begin(), savedIDs.end(), ID);
+}
+
+const bool BattleSnapshot::IsEmpty() const {
+  return length == 0;
+}
+
+const BattleSnapshot::Stats BattleSnapshot::GetStats() const {
+  return stats;
+}
+
+void BattleSnapshot::Write(const std::string& value) {
+  Write((uint32_t)value.size());
+
+  if (value.empty()) return;
+
+  if (length + value.size() > buffer.size()) {
+    Grow(value.size());
+  }
+
+  std::memcpy(&buffer[length], value.data(), value.size());
+  length += value.size();
+}
+
+void BattleSnapshot::Read(std::string& value) {
+  uint32_t size = 0;
+  Read(size);
+
+  if (size == 0 || cursor + size > length) {
+    value.clear();
+    return;
+  }
+
+  value.assign(&buffer[cursor], size);
+  cursor += size;
+}
+
+const size_t BattleSnapshot::BeginBlock() {
+  size_t start = length;
+  Write((uint32_t)0);
+  return start;
+}
+
+void BattleSnapshot::EndBlock(size_t start) {
+  uint32_t size = (uint32_t)(length - start - sizeof(uint32_t));
+  std::memcpy(&buffer[start], &size, sizeof(uint32_t));
+}
+
+const size_t BattleSnapshot::ReadBlock() {
+  uint32_t size = 0;
+  Read(size);
+  return std::min(cursor + size, length);
+}
+
+void BattleSnapshot::EndReadBlock(size_t end) {
+  cursor = end;
+}
+
+Character* BattleSnapshot::FindCharacter(long ID) const {
+  if (ID == 0) return nullptr;
+
+  auto iter = std::lower_bound(live.begin(), live.end(), ID, [](const Live& l, long ID) { return l.ID < ID; });
+
+  if (iter == live.end() || iter->ID != ID) return nullptr;
+
+  return iter->character;
+}
+
+Entity* BattleSnapshot::FindEntity(long ID) const {
+  if (ID == 0) return nullptr;
+
+  auto iter = std::lower_bound(live.begin(), live.end(), ID, [](const Live& l, long ID) { return l.ID < ID; });
+
+  if (iter == live.end() || iter->ID != ID) return nullptr;
+
+  return iter->entity;
+}
+
+void BattleSnapshot::Gather(Field& field) {
+  live.clear();
+
+  for (Battle::Tile& next : field.tiles) {
+    Battle::Tile* tile = &next;
+
+    for (Entity* e : tile->entities) {
+      Live l; l.ID = e->GetID(); l.entity = e;
+      live.push_back(l);
+    }
+
+    for (Spell* s : tile->spells) {
+      Live l; l.ID = s->GetID(); l.spell = s;
+      live.push_back(l);
+    }
+
+    for (Character* c : tile->characters) {
+      Live l; l.ID = c->GetID(); l.character = c;
+      live.push_back(l);
+    }
+
+    for (Artifact* a : tile->artifacts) {
+      Live l; l.ID = a->GetID(); l.artifact = a;
+      live.push_back(l);
+    }
+  }
+
+  for (auto& next : field.pending) {
+    Live l; l.ID = next.ID;
+
+    switch (next.entity_type) {
+    case Field::queueBucket::type::character:
+      l.entity = l.character = next.data.character;
+      break;
+    case Field::queueBucket::type::spell:
+      l.entity = l.spell = next.data.spell;
+      break;
+    case Field::queueBucket::type::obstacle:
+      l.entity = l.character = next.data.obstacle;
+      l.spell = next.data.obstacle;
+      break;
+    case Field::queueBucket::type::artifact:
+      l.entity = l.artifact = next.data.artifact;
+      break;
+    }
+
+    live.push_back(l);
+  }
+
+  std::sort(live.begin(), live.end(), [](const Live& a, const Live& b) { return a.ID < b.ID; });
+
+  // Merge the bucket entries for each entity into one
+  size_t out = 0;
+
+  for (size_t i = 0; i < live.size(); i++) {
+    if (out > 0 && live[out - 1].ID == live[i].ID) {
+      Live& merged = live[out - 1];
+      if (live[i].entity) merged.entity = live[i].entity;
+      if (live[i].character) merged.character = live[i].character;
+      if (live[i].spell) merged.spell = live[i].spell;
+      if (live[i].artifact) merged.artifact = live[i].artifact;
+    }
+    else {
+      live[out++] = live[i];
+    }
+  }
+
+  live.resize(out);
+
+  // Every entity on a tile is in the entity bucket. Drop strays from the typed buckets.
+  live.erase(std::remove_if(live.begin(), live.end(), [](const Live& l) { return l.entity == nullptr; }), live.end());
+}
+
+BattleSnapshot::Live* BattleSnapshot::Find(long ID) {
+  auto iter = std::lower_bound(live.begin(), live.end(), ID, [](const Live& l, long ID) { return l.ID < ID; });
+
+  if (iter == live.end() || iter->ID != ID) return nullptr;
+
+  return &(*iter);
+}
+
+void BattleSnapshot::Grow(size_t bytes) {
+  size_t size = std::max(buffer.size() * 2, length + bytes);
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("BattleSnapshot: growing buffer from %u to %u bytes", (unsigned)buffer.size(), (unsigned)size);
+  Logger::GetMutex()->unlock();
+
+  buffer.resize(size);
+}
+
+void BattleSnapshot::RunBenchmark(unsigned frames) {
+  const float step = 1.0f / 60.0f;
+
+  Field* field = new Field(6, 3);
+  field->SetBattleActive(true);
+
+  // Fill every tile. Each side targets the other.
+  for (int y = 1; y <= 3; y++) {
+    for (int x = 1; x <= 6; x++) {
+      Mettaur* met = new Mettaur();
+      met->SetTeam(x <= 3 ? Team::RED : Team::BLUE);
+      field->AddEntity(*met, x, y);
+    }
+  }
+
+  BattleSnapshot snapshot;
+
+  // Let the field settle and size the buffers
+  for (unsigned f = 0; f < 60; f++) {
+    field->Update(step);
+    field->GetEventBus().Dispatch();
+  }
+
+  snapshot.Save(*field);
+  snapshot.Restore(*field);
+
+  sf::Int64 saveTotal = 0, saveMax = 0, restoreTotal = 0, restoreMax = 0;
+  size_t bytes = 0;
+  unsigned missing = 0, removed = 0, revived = 0;
+
+  sf::Clock clock;
+
+  // Roll back one frame every frame and play it again
+  for (unsigned f = 0; f < frames; f++) {
+    clock.restart();
+    snapshot.Save(*field);
+    sf::Int64 save = clock.getElapsedTime().asMicroseconds();
+
+    bytes = std::max(bytes, snapshot.GetStats().bytes);
+
+    field->Update(step);
+    field->GetEventBus().Dispatch();
+
+    clock.restart();
+    snapshot.Restore(*field);
+    sf::Int64 restore = clock.getElapsedTime().asMicroseconds();
+
+    missing += snapshot.GetStats().missing;
+    removed += snapshot.GetStats().removed;
+    revived += snapshot.GetStats().revived;
+
+    field->Update(step);
+    field->GetEventBus().Dispatch();
+
+    saveTotal += save;
+    restoreTotal += restore;
+    saveMax = std::max(saveMax, save);
+    restoreMax = std::max(restoreMax, restore);
+  }
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Battle snapshot benchmark: 18 mettaurs, %u frames, %u bytes", frames, (unsigned)bytes);
+  Logger::Logf("  save:    %.2f us avg, %lld us max", (double)saveTotal / (double)frames, (long long)saveMax);
+  Logger::Logf("  restore: %.2f us avg, %lld us max", (double)restoreTotal / (double)frames, (long long)restoreMax);
+  Logger::Logf("  %u entities brought back, %u rolled back, %u lost", revived, removed, missing);
+  Logger::GetMutex()->unlock();
+
+  delete field;
+}
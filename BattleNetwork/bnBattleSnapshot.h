@@ -0,0 +1,238 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+class Field;
+class Entity;
+class Character;
+class Spell;
+class Artifact;
+class Mob;
+
+namespace Battle {
+  class Tile;
+}
+
+// Bytes set aside when a snapshot is made. A full 6x3 field uses a fraction of this.
+#define BATTLE_SNAPSHOT_DEFAULT_CAPACITY (64*1024)
+
+/**
+ * @class BattleSnapshot
+ * @author mav
+ * @date 10/19/20
+ * @brief Saves and restores the state of a battle field into one contiguous buffer
+ *
+ * Save() writes the entity ID counter, the IDs of every entity on the field, the
+ * mob's enemies, each entity's SaveState() in ID order, the field's pending queue,
+ * and every tile's timers and entity buckets. Values are copied as raw bytes into a
+ * buffer that is allocated once and reused, so saving every frame does not allocate
+ * once the buffer is large enough.
+ *
+ * Save() also turns on Field::KeepDeleted(). Entities deleted after the snapshot wait
+ * in the field's graveyard instead of being freed, so Restore() can bring them back.
+ * Each Save() frees what the last one kept, so use one snapshot per field.
+ *
+ * Restore() first checks that every saved entity is on the field or in the graveyard.
+ * If one is not, nothing is changed and it returns false. Otherwise the saved entities
+ * read their own state back, the buckets are rebuilt in the saved order and the mob
+ * tracks the saved enemies again. Entities created after the snapshot are taken off
+ * their tiles. Characters among them are forgotten by the mob and posted to the event
+ * bus for deletion like any other deleted character.
+ *
+ * Characters with AI save their state machine with AI::SaveAI(). The saved state is
+ * entered again if the AI moved on, which sets its animation callbacks, and then
+ * reads back its own timers.
+ *
+ * The snapshot lives in memory only. Pointers to tiles are written as is because
+ * tiles live as long as the field.
+ */
+class BattleSnapshot {
+public:
+  /*! \brief Result of the last Save() or Restore() */
+  struct Stats {
+    size_t bytes{ 0 }; /*!< bytes used in the buffer */
+    unsigned entities{ 0 }; /*!< entities saved or restored */
+    unsigned missing{ 0 }; /*!< saved entities that no longer exist. Restore() changes nothing if any are. */
+    unsigned removed{ 0 }; /*!< entities removed because they were made after the snapshot */
+    unsigned revived{ 0 }; /*!< entities brought back from the graveyard */
+  };
+
+  /**
+   * @param capacity bytes to allocate up front
+   */
+  BattleSnapshot(size_t capacity = BATTLE_SNAPSHOT_DEFAULT_CAPACITY);
+  ~BattleSnapshot();
+
+  /**
+   * @brief Overwrite the snapshot with the current state of the field
+   * @param field
+   * @param mob fighting on the field, or null if there is none
+   */
+  void Save(Field& field, Mob* mob = nullptr);
+
+  /**
+   * @brief Put the field back to the state of the last Save()
+   * @param field must be the same field that was saved
+   * @param mob the same mob that was saved, or null
+   * @return true if the field was restored. False if a saved entity no longer exists.
+   */
+  const bool Restore(Field& field, Mob* mob = nullptr);
+
+  /**
+   * @brief True if nothing has been saved
+   */
+  const bool IsEmpty() const;
+
+  /**
+   * @brief Stats of the last Save() or Restore()
+   * @return Stats
+   */
+  const Stats GetStats() const;
+
+  /**
+   * @brief Append the bytes of a trivially copyable value
+   */
+  template<typename T>
+  void Write(const T& value);
+
+  /**
+   * @brief Append the length of the string followed by its characters
+   */
+  void Write(const std::string& value);
+
+  /**
+   * @brief Read a value written by Write()
+   */
+  template<typename T>
+  void Read(T& value);
+
+  /**
+   * @brief Read a string written by Write()
+   */
+  void Read(std::string& value);
+
+  /**
+   * @brief Reserve room for the size of the data that follows
+   * @return position to hand to EndBlock()
+   */
+  const size_t BeginBlock();
+
+  /**
+   * @brief Fill in the size reserved by BeginBlock()
+   * @param start value returned by BeginBlock()
+   */
+  void EndBlock(size_t start);
+
+  /**
+   * @brief Read the size of a block
+   * @return position of the end of the block
+   */
+  const size_t ReadBlock();
+
+  /**
+   * @brief Move to the end of the block whether or not all of it was read
+   * @param end value returned by ReadBlock()
+   */
+  void EndReadBlock(size_t end);
+
+  /**
+   * @brief Look up an entity on the field by ID. Only valid during Restore().
+   * @param ID
+   * @return Character* or null if the character no longer exists
+   */
+  Character* FindCharacter(long ID) const;
+
+  /**
+   * @brief Look up any entity on the field by ID. Only valid during Restore().
+   * @param ID
+   * @return Entity* or null if the entity no longer exists
+   */
+  Entity* FindEntity(long ID) const;
+
+  /**
+   * @brief Fill a field with mettaurs and log the cost of save and restore each frame
+   * @param frames number of 60 Hz frames to simulate
+   */
+  static void RunBenchmark(unsigned frames);
+
+private:
+  /*! \brief An entity on the field and each bucket it appears in */
+  struct Live {
+    long ID{ 0 };
+    Entity* entity{ nullptr };
+    Character* character{ nullptr };
+    Spell* spell{ nullptr };
+    Artifact* artifact{ nullptr };
+  };
+
+  /*! \brief An enemy the mob was tracking */
+  struct MobEntry {
+    long ID{ 0 };
+    int tileX{ 0 }, tileY{ 0 };
+    unsigned index{ 0 };
+  };
+
+  /**
+   * @brief Collect every entity on the field and in the pending queue, sorted by ID
+   */
+  void Gather(Field& field);
+
+  /**
+   * @brief Binary search the gathered entities
+   * @return Live* or null
+   */
+  Live* Find(long ID);
+
+  /**
+   * @brief Move the saved entities in the field's graveyard back into the live set and free the rest
+   */
+  void Revive(Field& field);
+
+  /**
+   * @brief Take every entity the snapshot does not know off the field
+   */
+  void RemoveUnsaved(Field& field, Mob* mob);
+
+  /**
+   * @brief True if the entity was on the field at Save(). Only valid during Restore().
+   */
+  const bool IsSaved(long ID) const;
+
+  void Grow(size_t bytes);
+
+  std::vector<char> buffer; /*!< preallocated storage */
+  size_t length; /*!< bytes written by the last Save() */
+  size_t cursor; /*!< read position during Restore() */
+  std::vector<Live> live; /*!< reused between calls */
+  std::vector<long> savedIDs; /*!< IDs written by Save(), sorted */
+  std::vector<MobEntry> mobEntries;
+  std::vector<std::pair<Battle::Tile*, Entity*>> unsaved; /*!< found by RemoveUnsaved() */
+  Stats stats;
+};
+
+template<typename T>
+inline void BattleSnapshot::Write(const T& value) {
+  static_assert(std::is_trivially_copyable<T>::value, "BattleSnapshot can only copy plain values");
+
+  if (length + sizeof(T) > buffer.size()) {
+    Grow(sizeof(T));
+  }
+
+  std::memcpy(&buffer[length], &value, sizeof(T));
+  length += sizeof(T);
+}
+
+template<typename T>
+inline void BattleSnapshot::Read(T& value) {
+  static_assert(std::is_trivially_copyable<T>::value, "BattleSnapshot can only copy plain values");
+
+  if (cursor + sizeof(T) > length) return;
+
+  std::memcpy(&value, &buffer[cursor], sizeof(T));
+  cursor += sizeof(T);
+}
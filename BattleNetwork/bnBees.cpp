@@ -128,9 +128,10 @@ void Bees::OnUpdate(float _elapsed) {
       return (e->GetTeam() != team && dynamic_cast<Character*>(e) && !dynamic_cast<Obstacle*>(e));
     };
 
-    auto list = field->FindEntities(query);
+    // Keep the closest match without collecting them
+    field->ForEachEntity([&](Entity* l) {
+      if (!query(l)) return;
 
-    for (auto l : list) {
       if (!target) { target = l; }
       else {
         // If the distance to one enemy is shorter than the other, target the shortest enemy path
@@ -141,7 +142,7 @@ void Bees::OnUpdate(float _elapsed) {
           target = l;
         }
       }
-    }
+    });
   }
   else if (leader) {
     // Follow the leader
@@ -17,6 +17,7 @@ BombChipAction::BombChipAction(Character * owner, int damage) : ChipAction(owner
 
 BombChipAction::~BombChipAction()
 {
+  TEXTURES.ReleaseTexture(PATH);
 }
 
 void BombChipAction::Execute() {
@@ -9,6 +9,7 @@
 #include "bnAudioResourceManager.h"
 
 #include "bnGear.h" 
+#include "bnBattleContext.h"
 
 #define COOLDOWN 40.0f/1000.0f
 
@@ -101,12 +102,12 @@ void Buster::Attack(Character* _entity) {
 
     if (!isCharged) {
       random = _entity->getLocalBounds().width / 2.0f;
-      random *= rand() % 2 == 0 ? -1.0f : 1.0f;
+      random *= BattleContext::Rand() % 2 == 0 ? -1.0f : 1.0f;
 
       hitHeight = (float)(std::floor(_entity->GetHeight()));
 
       if (hitHeight > 0) {
-        hitHeight = (float)(rand() % (int)hitHeight);
+        hitHeight = (float)(BattleContext::Rand() % (int)hitHeight);
       }
     }
   }
@@ -62,6 +62,8 @@ BusterChipAction::~BusterChipAction()
   if (attachment2) {
     delete attachment2;
   }
+
+  TEXTURES.ReleaseTexture(NODE_PATH);
 }
 
 void BusterChipAction::OnUpdate(float _elapsed)
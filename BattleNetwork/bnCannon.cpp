@@ -9,6 +9,7 @@
 #include "bnMettaur.h"
 #include "bnTextureResourceManager.h"
 #include "bnAudioResourceManager.h"
+#include "bnBattleContext.h"
 
 #define COOLDOWN 40.0f/1000.0f
 
@@ -18,7 +19,7 @@ Cannon::Cannon(Field* _field, Team _team, int _damage) : Spell(_field, _team){
   hit = false;
   progress = 0.0f;
 
-  random = rand() % 20 - 20;
+  random = BattleContext::Rand() % 20 - 20;
 
   if(_team == Team::RED) {
     SetDirection(Direction::RIGHT);
@@ -30,6 +30,7 @@ CannonChipAction::CannonChipAction(Character * owner, int damage) : ChipAction(o
 
 CannonChipAction::~CannonChipAction()
 {
+  TEXTURES.ReleaseTexture(CANNON_PATH);
 }
 
 void CannonChipAction::Execute() {
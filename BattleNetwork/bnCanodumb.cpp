@@ -79,4 +79,12 @@ void Canodumb::OnDelete() {
   this->ChangeState<ExplodeState<Canodumb>>(2);
 }
 
+void Canodumb::SaveState(BattleSnapshot& snapshot) const{
+  AI<Canodumb>::SaveAI(snapshot);
+  AnimatedCharacter::SaveState(snapshot);
+}
 
+void Canodumb::LoadState(BattleSnapshot& snapshot){
+  AI<Canodumb>::LoadAI(snapshot);
+  AnimatedCharacter::LoadState(snapshot);
+}
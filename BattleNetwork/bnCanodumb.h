@@ -36,6 +36,18 @@ public:
 
   const float GetHeight() const;
 
+  /**
+   * @brief Saves the AI and then the character
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back the state written by SaveState()
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
+
   const bool OnHit(const Hit::Properties props);
   void OnDelete();
 };
\ No newline at end of file
@@ -14,6 +14,8 @@ class CanodumbIdleState;
  */
 class CanodumbCursor : public Artifact
 {
+  friend class CanodumbIdleState;
+
 private:
   CanodumbIdleState* parentState; /*!< The context of the Canodumb who spawned it */
   Entity* target; /*!< The enemy to track */
@@ -2,6 +2,7 @@
 #include "bnCanodumbAttackState.h"
 #include "bnTile.h"
 #include "bnCanodumbCursor.h"
+#include "bnBattleSnapshot.h"
 
 #include <iostream>
 
@@ -64,3 +65,17 @@ void CanodumbIdleState::OnLeave(Canodumb& can) {
   FreeCursor();
 }
 
+void CanodumbIdleState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(cursor ? cursor->GetID() : 0L);
+}
+
+void CanodumbIdleState::LoadState(BattleSnapshot& snapshot) {
+  long cursorID = 0;
+  snapshot.Read(cursorID);
+  cursor = dynamic_cast<CanodumbCursor*>(snapshot.FindEntity(cursorID));
+
+  // The cursor may have been made by a state the restore replaced
+  if (cursor) {
+    cursor->parentState = this;
+  }
+}
@@ -45,5 +45,17 @@ public:
    * @param can canodumb 
    */
   void OnLeave(Canodumb& can);
+
+  /**
+   * @brief Writes the ID of the cursor the state is waiting on
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back what SaveState() wrote
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
 };
 
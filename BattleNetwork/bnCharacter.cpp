@@ -7,6 +7,7 @@
 #include "bnShaderResourceManager.h"
 #include "bnAnimationComponent.h"
 #include "bnShakingEffect.h"
+#include "bnBattleSnapshot.h"
 #include <Swoosh/Ease.h>
 
 Character::Character(Rank _rank) :
@@ -152,13 +153,15 @@ void Character::Update(float _elapsed) {
 
 bool Character::CanMoveTo(Battle::Tile * next)
 {
-  auto occupied = [this](Entity* in) {
+  bool occupied = false;
+
+  next->ForEachEntity([this, &occupied](Entity* in) {
     Character* c = dynamic_cast<Character*>(in);
 
-    return c && c != this && !c->CanShareTileSpace();
-  };
+    occupied = occupied || (c && c != this && !c->CanShareTileSpace());
+  });
 
-  bool result = (Entity::CanMoveTo(next) && next->FindEntities(occupied).size() == 0);
+  bool result = (Entity::CanMoveTo(next) && !occupied);
   result = result && !next->IsEdgeTile();
 
   return result;
@@ -341,7 +344,13 @@ void Character::ResolveFrameBattleDamage()
   }
 
   if (frameCounterAggressor) {
-    this->Broadcast(*this, *frameCounterAggressor);
+    if (GetField()) {
+      GetField()->GetEventBus().Post(*this, *this, *frameCounterAggressor);
+    }
+    else {
+      this->Broadcast(*this, *frameCounterAggressor);
+    }
+
     this->ToggleCounter(false);
     this->Stun(3.0);
   }
@@ -475,3 +484,78 @@ void Character::CancelSharedHitboxDamage(Character * to)
   if(iter != shareHit.end())
     shareHit.erase(iter);
 }
+
+void Character::SaveState(BattleSnapshot& snapshot) const
+{
+  Entity::SaveState(snapshot);
+
+  snapshot.Write(health);
+  snapshot.Write(maxHealth);
+  snapshot.Write(counterable);
+  snapshot.Write(canTilePush);
+  snapshot.Write(stunCooldown);
+  snapshot.Write(invincibilityCooldown);
+  snapshot.Write(hit);
+  snapshot.Write(invokeDeletion);
+  snapshot.Write(slideFromDrag);
+  snapshot.Write(counterSlideOffset);
+  snapshot.Write(counterSlideDelta);
+
+  snapshot.Write((uint32_t)statusQueue.size());
+
+  if (statusQueue.empty()) return;
+
+  // std::queue cannot be walked so copy it. Only happens on the frames a hit lands.
+  std::queue<Hit::Properties> statuses = statusQueue;
+
+  while (!statuses.empty()) {
+    const Hit::Properties& props = statuses.front();
+
+    snapshot.Write(props.damage);
+    snapshot.Write(props.flags);
+    snapshot.Write(props.element);
+    snapshot.Write(props.aggressor ? props.aggressor->GetID() : 0L);
+    snapshot.Write(props.drag);
+
+    statuses.pop();
+  }
+}
+
+void Character::LoadState(BattleSnapshot& snapshot)
+{
+  Entity::LoadState(snapshot);
+
+  snapshot.Read(health);
+  snapshot.Read(maxHealth);
+  snapshot.Read(counterable);
+  snapshot.Read(canTilePush);
+  snapshot.Read(stunCooldown);
+  snapshot.Read(invincibilityCooldown);
+  snapshot.Read(hit);
+  snapshot.Read(invokeDeletion);
+  snapshot.Read(slideFromDrag);
+  snapshot.Read(counterSlideOffset);
+  snapshot.Read(counterSlideDelta);
+
+  while (!statusQueue.empty()) {
+    statusQueue.pop();
+  }
+
+  uint32_t count = 0;
+  snapshot.Read(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    Hit::Properties props;
+    long aggressor = 0;
+
+    snapshot.Read(props.damage);
+    snapshot.Read(props.flags);
+    snapshot.Read(props.element);
+    snapshot.Read(aggressor);
+    snapshot.Read(props.drag);
+
+    props.aggressor = snapshot.FindCharacter(aggressor);
+
+    statusQueue.push(props);
+  }
+}
@@ -196,6 +196,20 @@ public:
   void SharedHitboxDamage(Character* to);
   void CancelSharedHitboxDamage(Character* to);
 
+  /**
+   * @brief Writes entity state followed by health, cooldowns, and the status queue
+   * @param snapshot
+   */
+  virtual void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back the state written by SaveState()
+   * 
+   * Aggressors in the status queue that no longer exist are restored as null.
+   * @param snapshot
+   */
+  virtual void LoadState(BattleSnapshot& snapshot);
+
 private:
   int maxHealth;
   sf::Vector2f counterSlideOffset; /*!< Used when enemies delete on counter - they slide back */
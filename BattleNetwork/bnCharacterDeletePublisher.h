@@ -1,7 +1,7 @@
 #pragma once
 #pragma once
 
-#include <list>
+#include <vector>
 #include "bnCharacterDeleteListener.h"
 
 class Character;
@@ -16,7 +16,7 @@ class CharacterDeletePublisher {
   friend class CharacterDeleteListener;
 
 private:
-  std::list<CharacterDeleteListener*> listeners; /*!< List of subscriptions */
+  std::vector<CharacterDeleteListener*> listeners; /*!< List of subscriptions */
 
   /**
    * @brief Add a listener to subscriptions
@@ -34,11 +34,17 @@ public:
    * @param pending who will be removed
    */
   void Broadcast(Character& pending) {
-    std::list<CharacterDeleteListener*>::iterator iter = listeners.begin();
-
-    while (iter != listeners.end()) {
-      (*iter)->OnDeleteEvent(pending);
-      iter++;
+    // Index so listeners may subscribe while being notified
+    for (size_t i = 0; i < listeners.size(); i++) {
+      listeners[i]->OnDeleteEvent(pending);
     }
   }
+
+  /**
+   * @brief Number of subscribed listeners
+   * @return size_t
+   */
+  const size_t GetListenerCount() const {
+    return listeners.size();
+  }
 }; 
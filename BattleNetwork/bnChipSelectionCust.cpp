@@ -3,6 +3,7 @@
 #include "bnShaderResourceManager.h"
 #include "bnInputManager.h"
 #include "bnChipLibrary.h"
+#include "bnPlayerChipUseListener.h"
 
 #define WILDCARD '*'
 #define VOIDED 0
@@ -250,6 +251,9 @@ bool ChipSelectionCust::CursorAction() {
         selectQueue[selectCount++] = &queue[cursorPos + (5 * cursorRow)];
         queue[cursorPos + (5 * cursorRow)].state = QUEUED;
 
+        // Decode the chip's textures while the player is still choosing
+        PlayerChipUseListener::PrefetchAssets(*queue[cursorPos + (5 * cursorRow)].data);
+
         // We can only upload 5 chips to navi...
         if (selectCount == 5) {
           for (int i = 0; i < chipCount; i++) {
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <list>
+#include <vector>
 
 #include "bnComponent.h"
 #include "bnChip.h"
@@ -19,7 +19,7 @@ class ChipUsePublisher {
 private:
   friend class ChipUseListener;
 
-  std::list<ChipUseListener*> listeners; /*!< All subscribers */
+  std::vector<ChipUseListener*> listeners; /*!< All subscribers */
 
   void AddListener(ChipUseListener* listener) {
     listeners.push_back(listener);
@@ -39,11 +39,17 @@ public:
   * @param user using the chip
   */
   void Broadcast(Chip& chip, Character& user) {
-    std::list<ChipUseListener*>::iterator iter = listeners.begin();
-
-    while (iter != listeners.end()) {
-      (*iter)->OnChipUse(chip, user);
-      iter++;
+    // Index so listeners may subscribe while being notified
+    for (size_t i = 0; i < listeners.size(); i++) {
+      listeners[i]->OnChipUse(chip, user);
     }
   }
+
+  /**
+   * @brief Number of subscribed listeners
+   * @return size_t
+   */
+  const size_t GetListenerCount() const {
+    return listeners.size();
+  }
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "bnSpawnPolicy.h"
 #include "bnEnemyChipsUI.h"
 #include "bnChip.h"
+#include "bnBattleContext.h"
 
 /**
  * @class ChipSpawnPolicyChipset
@@ -15,7 +16,7 @@ public:
 
   ChipSpawnPolicyChipset() {
     // Test chip
-    int random = rand() % 3;
+    int random = BattleContext::Rand() % 3;
 
     if (random == 0) {
       chips.push_back(Chip(82, 154, '*', 0, Element::NONE, "AreaGrab", "Defends and reflects", "Press A to bring up a shield that protects you and reflects damage.", 2));
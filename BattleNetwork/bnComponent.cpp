@@ -1,3 +1,9 @@
 #include "bnComponent.h"
+#include "bnBattleContext.h"
 
-long Component::numOfComponents = 0;
\ No newline at end of file
+long Component::numOfComponents = 0;
+
+long Component::NextID() {
+  BattleContext* context = BattleContext::Current();
+  return context ? context->NextComponentID() : ++numOfComponents;
+}
@@ -2,6 +2,7 @@
 
 class Entity;
 class BattleScene;
+class BattleSnapshot;
 
 /**
  * @class Component
@@ -18,6 +19,11 @@ private:
   static long numOfComponents; /*!< Resource counter to generate new IDs */
   long ID; /*!< ID for quick lookups, resource management, and scripting */
 
+  /**
+   * @brief Next ID from the bound BattleContext, or numOfComponents if none
+   */
+  static long NextID();
+
 public:
   Component() = delete;
   
@@ -25,7 +31,7 @@ public:
    * @brief Sets an owner and ID. Increments numOfComponents beforehand.
    * @param owner the entity to attach to
    */
-  Component(Entity* owner) { this->owner = owner; ID = ++numOfComponents;  };
+  Component(Entity* owner) { this->owner = owner; ID = NextID();  };
   virtual ~Component() { ; }
 
   Component(Component&& rhs) = delete;
@@ -76,4 +82,16 @@ public:
    * @warning Components injected into the battle scene are updated and deleted. Free the owner if injecting.
    */
   virtual void Inject(BattleScene&) = 0;
+
+  /**
+   * @brief Write any state that changes during battle. Used for rollback.
+   * @param snapshot
+   */
+  virtual void SaveState(BattleSnapshot& snapshot) const { ; }
+
+  /**
+   * @brief Read back the state written by SaveState() in the same order
+   * @param snapshot
+   */
+  virtual void LoadState(BattleSnapshot& snapshot) { ; }
 };
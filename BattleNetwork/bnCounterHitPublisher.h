@@ -1,7 +1,7 @@
 #pragma once
 #pragma once
 
-#include <list>
+#include <vector>
 #include "bnCounterHitListener.h"
 
 class Character;
@@ -16,7 +16,7 @@ class CounterHitPublisher {
   friend class CounterHitListener;
 
 private:
-  std::list<CounterHitListener*> listeners; /*!< List of subscriptions */
+  std::vector<CounterHitListener*> listeners; /*!< List of subscriptions */
 
   /**
    * @brief Add a listener to subscriptions
@@ -35,11 +35,17 @@ public:
    * @param aggressor who hit the victim to trigger this event
    */
   void Broadcast(Character& victim, Character& aggressor) {
-    std::list<CounterHitListener*>::iterator iter = listeners.begin();
-
-    while (iter != listeners.end()) {
-      (*iter)->OnCounter(victim, aggressor);
-      iter++;
+    // Index so listeners may subscribe while being notified
+    for (size_t i = 0; i < listeners.size(); i++) {
+      listeners[i]->OnCounter(victim, aggressor);
     }
   }
+
+  /**
+   * @brief Number of subscribed listeners
+   * @return size_t
+   */
+  const size_t GetListenerCount() const {
+    return listeners.size();
+  }
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "bnTextureResourceManager.h"
 #include "bnShaderResourceManager.h"
 #include "bnAudioResourceManager.h"
+#include "bnBattleContext.h"
 
 const int Cube::numOfAllowedCubesOnField = 2;
 
@@ -37,6 +38,8 @@ Cube::Cube(Field* _field, Team _team) : Obstacle(field, team), InstanceCountingT
 }
 
 Cube::~Cube() {
+  // Cubes removed without being deleted would still be counted
+  this->RemoveInstanceFromCountedList();
 }
 
 bool Cube::CanMoveTo(Battle::Tile * next)
@@ -115,14 +118,14 @@ void Cube::OnDelete() {
   delete virusBody;
 
   if (this->GetFirstComponent<AnimationComponent>()->GetAnimationString() != "APPEAR") {
-    int intensity = rand() % 2;
+    int intensity = BattleContext::Rand() % 2;
     intensity += 1;
 
     auto left = (this->GetElement() == Element::ICE) ? RockDebris::Type::LEFT_ICE : RockDebris::Type::LEFT;
     this->GetField()->AddEntity(*new RockDebris(left, (double)intensity), *this->GetTile());
 
 
-    intensity = rand() % 3;
+    intensity = BattleContext::Rand() % 3;
     intensity += 1;
     auto right = (this->GetElement() == Element::ICE) ? RockDebris::Type::RIGHT_ICE : RockDebris::Type::RIGHT;
     this->GetField()->AddEntity(*new RockDebris(right, (double)intensity), *this->GetTile());
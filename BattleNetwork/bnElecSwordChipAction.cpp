@@ -27,6 +27,7 @@ ElecSwordChipAction::ElecSwordChipAction(Character * owner, int damage) : SwordC
 
 ElecSwordChipAction::~ElecSwordChipAction()
 {
+  TEXTURES.ReleaseTexture(PATH);
 }
 
 void ElecSwordChipAction::OnSpawnHitbox()
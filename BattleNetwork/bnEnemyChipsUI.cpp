@@ -12,6 +12,7 @@ using std::to_string;
 #include "bnAudioResourceManager.h"
 #include "bnChip.h"
 #include "bnEngine.h"
+#include "bnBattleContext.h"
 
 EnemyChipsUI::EnemyChipsUI(Character* _owner) : ChipUsePublisher(), Component(_owner) {
   chipCount = curr = 0;
@@ -29,7 +30,7 @@ void EnemyChipsUI::OnUpdate(float _elapsed) {
 
     if (agent && agent->GetTarget() && !agent->GetTarget()->IsDeleted() && agent->GetTarget()->GetTile()) {
       if (agent->GetTarget()->GetTile()->GetY() == GetOwner()->GetTile()->GetY()) {
-        if (rand() % 500 > 299) {
+        if (BattleContext::Rand() % 500 > 299) {
           this->UseNextChip();
         }
       }
@@ -73,7 +74,12 @@ void EnemyChipsUI::UseNextChip() {
   }
 
   std::cout << "selected chip " << selectedChips[curr].GetShortName() << " is broadcasted by enemy UI" << std::endl;
-  this->Broadcast(selectedChips[curr], *this->character);
+  if (character->GetField()) {
+    character->GetField()->GetEventBus().Post(*this, selectedChips[curr], *this->character);
+  }
+  else {
+    this->Broadcast(selectedChips[curr], *this->character);
+  }
 
   curr++;
 }
@@ -6,6 +6,10 @@
 #include "bnShaderType.h"
 #include "bnShaderResourceManager.h"
 
+namespace {
+  thread_local Camera* threadCamera = nullptr; /*!< set by BindThreadCamera() */
+}
+
 Engine& Engine::GetInstance() {
   static Engine instance;
   return instance;
@@ -50,8 +54,10 @@ void Engine::Draw(Drawable& _drawable, bool applyShaders) {
     }
 #endif 
 
+    CountDraw(stateCopy.shader);
     surface->draw(_drawable, stateCopy);
   } else {
+    CountDraw(nullptr);
     surface->draw(_drawable);
   }
 }
@@ -72,8 +78,10 @@ void Engine::Draw(Drawable* _drawable, bool applyShaders) {
     }
 #endif
 
+    CountDraw(stateCopy.shader);
     surface->draw(*_drawable, stateCopy);
   } else {
+    CountDraw(nullptr);
     surface->draw(*_drawable);
   }
 }
@@ -94,10 +102,13 @@ void Engine::Draw(SpriteSceneNode* _drawable) {
     sf::RenderStates newState = state;
     newState.shader = shader->Get();
 
+    CountDraw(newState.shader);
     context->draw(*surface, newState);
     // surface->draw(*context, newState); // bake
-    shader->ResetUniforms();
+
+    // Uniforms stay on the shader. The next ApplyUniforms() only sends what changed.
   } else {
+    CountDraw(state.shader);
     context->draw(*surface, state);
   }
 }
@@ -141,12 +152,12 @@ void Engine::Draw(vector<SpriteSceneNode*> _drawable) {
       sf::RenderStates newState = state;
       newState.shader = shader.Get();
 
+      CountDraw(newState.shader);
       context->draw(*surface, newState);
 
       //surface->draw(*context, newState); // bake
-
-      shader.ResetUniforms();
     } else {
+      CountDraw(state.shader);
       context->draw(*surface, state);
     }
   }
@@ -166,6 +177,13 @@ bool Engine::Running() {
 }
 
 void Engine::Clear() {
+  // A new frame begins
+  frameStats.uniformUploads = SmartShader::GetUniformUploadCount() - uniformUploadsAtFrameStart;
+  lastFrameStats = frameStats;
+  frameStats = DrawStats();
+  uniformUploadsAtFrameStart = SmartShader::GetUniformUploadCount();
+  lastShader = nullptr;
+
   if (HasRenderSurface()) {
     surface->clear();
   }
@@ -179,6 +197,9 @@ RenderWindow* Engine::GetWindow() const {
 
 Engine::Engine()
 {
+  lastShader = nullptr;
+  uniformUploadsAtFrameStart = 0;
+  surface = nullptr;
 
   cam = new Camera(view);
 }
@@ -187,6 +208,19 @@ Engine::~Engine() {
   delete window;
 }
 
+void Engine::CountDraw(const sf::Shader* shader) {
+  frameStats.drawCalls++;
+
+  if (shader != lastShader) {
+    frameStats.programSwitches++;
+    lastShader = shader;
+  }
+}
+
+const DrawStats Engine::GetLastFrameStats() const {
+  return lastFrameStats;
+}
+
 const sf::Vector2f Engine::GetViewOffset() {
   return GetView().getCenter() - cam->GetView().getCenter();
 }
@@ -264,7 +298,12 @@ const sf::View Engine::GetView() {
 
 Camera* Engine::GetCamera()
 {
-  return cam;
+  return threadCamera ? threadCamera : cam;
+}
+
+void Engine::BindThreadCamera(Camera* camera)
+{
+  threadCamera = camera;
 }
 
 void Engine::SetCamera(Camera& camera) {
@@ -11,6 +11,16 @@ using std::vector;
 #include "bnCamera.h"
 #include "bnLayered.h"
 
+/**
+ * @struct DrawStats
+ * @brief Per-frame counters collected by the engine draw pipeline
+ */
+struct DrawStats {
+  unsigned drawCalls{ 0 };       /*!< Draws submitted through Engine::Draw() */
+  unsigned programSwitches{ 0 }; /*!< Draws that used a different shader than the draw before it */
+  unsigned uniformUploads{ 0 };  /*!< Uniforms sent by SmartShader::ApplyUniforms() */
+};
+
 /**
  * @class Engine
  * @author mav
@@ -128,10 +138,18 @@ public:
   
   /**
    * @brief Get the camera object
-   * @return Camera*
+   * @return Camera* bound to the calling thread if any, otherwise the window's camera
    */
   Camera* GetCamera();
 
+  /**
+   * @brief GetCamera() on the calling thread returns this camera instead
+   *
+   * Battles running off the main thread shake their own camera.
+   * @param camera owned by the caller, or null to unbind
+   */
+  static void BindThreadCamera(Camera* camera);
+
   /**
    * @brief Sets the external render texture buffer to draw to
    * @param _surface
@@ -160,9 +178,21 @@ public:
     return *surface;
   }
 
+  /**
+   * @brief Counters for the frame before the last call to Clear()
+   * @return DrawStats
+   */
+  const DrawStats GetLastFrameStats() const;
+
   // TODO: make this private again
   const sf::Vector2f GetViewOffset(); // for drawing 
 private:
+  /**
+   * @brief Count a draw call and whether it switched shader programs
+   * @param shader the shader used for the draw
+   */
+  void CountDraw(const sf::Shader* shader);
+
   /**
    * @brief sets camera to nullptr
    */
@@ -178,6 +208,10 @@ private:
   sf::RenderStates state; /*!< Global GL context information used when drawing*/
   sf::RenderTexture* surface; /*!< The external buffer to draw to */
   Camera* cam; /*!< Camera object */
+  DrawStats frameStats; /*!< Counters for the frame in progress */
+  DrawStats lastFrameStats; /*!< Counters for the last complete frame */
+  const sf::Shader* lastShader; /*!< Shader used by the previous draw */
+  unsigned uniformUploadsAtFrameStart; /*!< SmartShader upload count when the frame began */
 
 };
 
@@ -2,6 +2,9 @@
 #include "bnComponent.h"
 #include "bnTile.h"
 #include "bnField.h"
+#include "bnCharacter.h"
+#include "bnBattleSnapshot.h"
+#include "bnBattleContext.h"
 #include <Swoosh/Ease.h>
 
 long Entity::numOfIDs = 0;
@@ -29,7 +32,9 @@ Entity::Entity()
   lastComponentID(0),
   height(0)
 {
-  this->ID = ++Entity::numOfIDs;
+  // Battles running in a BattleContext count their own IDs
+  BattleContext* context = BattleContext::Current();
+  this->ID = context ? context->NextEntityID() : ++Entity::numOfIDs;
   alpha = 255;
 }
 
@@ -349,7 +354,17 @@ Team Entity::GetTeam() const {
   return team;
 }
 void Entity::SetTeam(Team _team) {
+  Team previous = team;
+
   team = _team;
+
+  if (previous == _team || !tile || !field) return;
+
+  // The field counts characters in each column by team. Move this one's count over.
+  if (dynamic_cast<Character*>(this) && tile->ContainsEntity(this)) {
+    field->CountCharacter(tile->GetX(), previous, -1);
+    field->CountCharacter(tile->GetX(), _team, 1);
+  }
 }
 
 void Entity::SetPassthrough(bool state)
@@ -504,3 +519,93 @@ const int Entity::GetMoveCount() const
 {
     return this->moveCount;
 }
+
+void Entity::SaveState(BattleSnapshot& snapshot) const
+{
+  snapshot.Write(tile);
+  snapshot.Write(previous);
+  snapshot.Write(next);
+  snapshot.Write(getPosition());
+  snapshot.Write(tileOffset);
+  snapshot.Write(slideStartPosition);
+  snapshot.Write(team);
+  snapshot.Write(element);
+  snapshot.Write(direction);
+  snapshot.Write(previousDirection);
+  snapshot.Write(alpha);
+  snapshot.Write(height);
+  snapshot.Write(hasSpawned);
+  snapshot.Write(isBattleActive);
+  snapshot.Write(passthrough);
+  snapshot.Write(floatShoe);
+  snapshot.Write(airShoe);
+  snapshot.Write(isSliding);
+  snapshot.Write(deleted);
+  snapshot.Write(moveCount);
+  snapshot.Write(slideTime.asMicroseconds());
+  snapshot.Write(defaultSlideTime.asMicroseconds());
+  snapshot.Write(elapsedSlideTime);
+
+  snapshot.Write((uint32_t)components.size());
+
+  for (Component* c : components) {
+    snapshot.Write(c->GetID());
+
+    size_t block = snapshot.BeginBlock();
+    c->SaveState(snapshot);
+    snapshot.EndBlock(block);
+  }
+}
+
+void Entity::LoadState(BattleSnapshot& snapshot)
+{
+  sf::Vector2f position;
+  sf::Int64 slideMicroseconds = 0, defaultSlideMicroseconds = 0;
+
+  snapshot.Read(tile);
+  snapshot.Read(previous);
+  snapshot.Read(next);
+  snapshot.Read(position);
+  snapshot.Read(tileOffset);
+  snapshot.Read(slideStartPosition);
+  snapshot.Read(team);
+  snapshot.Read(element);
+  snapshot.Read(direction);
+  snapshot.Read(previousDirection);
+  snapshot.Read(alpha);
+  snapshot.Read(height);
+  snapshot.Read(hasSpawned);
+  snapshot.Read(isBattleActive);
+  snapshot.Read(passthrough);
+  snapshot.Read(floatShoe);
+  snapshot.Read(airShoe);
+  snapshot.Read(isSliding);
+  snapshot.Read(deleted);
+  snapshot.Read(moveCount);
+  snapshot.Read(slideMicroseconds);
+  snapshot.Read(defaultSlideMicroseconds);
+  snapshot.Read(elapsedSlideTime);
+
+  setPosition(position);
+  slideTime = sf::microseconds(slideMicroseconds);
+  defaultSlideTime = sf::microseconds(defaultSlideMicroseconds);
+
+  uint32_t count = 0;
+  snapshot.Read(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    long ID = 0;
+    snapshot.Read(ID);
+
+    size_t end = snapshot.ReadBlock();
+
+    for (Component* c : components) {
+      if (c->GetID() == ID) {
+        c->LoadState(snapshot);
+        break;
+      }
+    }
+
+    snapshot.EndReadBlock(end);
+  }
+}
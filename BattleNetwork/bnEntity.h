@@ -33,11 +33,13 @@ namespace Battle {
 
 class Field;
 class BattleScene; // forward decl
+class BattleSnapshot;
 
 class Entity : public SpriteSceneNode {
   friend class Field;
   friend class Component;
   friend class BattleScene;
+  friend class BattleSnapshot;
 
 private:
   long ID;              /*!< IDs are used for tagging during battle & to identify entities in scripting. */
@@ -363,6 +365,26 @@ public:
   */
   void FinishMove();
 
+  /**
+   * @brief Virtual. Write the entity's battle state for rollback.
+   * 
+   * Writes tile coordinates, movement, flags, and every component's state.
+   * Subclasses with state of their own should call the base first and then
+   * write their members in a fixed order. Characters with AI are the exception
+   * and write the AI before the base. See AI::SaveAI().
+   * @param snapshot
+   */
+  virtual void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Virtual. Read back the state written by SaveState()
+   * 
+   * Tiles live as long as the field so tile pointers are stored as is.
+   * Components that were freed since the snapshot are skipped.
+   * @param snapshot
+   */
+  virtual void LoadState(BattleSnapshot& snapshot);
+
 protected:
   Battle::Tile* next; /**< Pointer to the next tile */
   Battle::Tile* tile; /**< Current tile pointer */
@@ -3,6 +3,7 @@
 #include "bnAudioResourceManager.h"
 #include "bnField.h"
 #include "bnTile.h"
+#include "bnBattleContext.h"
 
 using sf::IntRect;
 
@@ -127,14 +128,14 @@ void Explosion::SetOffsetArea(sf::Vector2f area)
 
   this->offsetArea = area;
 
-  int randX = rand() % (int)(area.x+0.5f);
-  int randY = rand() % (int)(area.y+0.5f);
+  int randX = BattleContext::Rand() % (int)(area.x+0.5f);
+  int randY = BattleContext::Rand() % (int)(area.y+0.5f);
 
   int randNegX = 1;
   int randNegY = 1;
 
-  if (rand() % 10 > 5) randNegX = -1;
-  if (rand() % 10 > 5) randNegY = -1;
+  if (BattleContext::Rand() % 10 > 5) randNegX = -1;
+  if (BattleContext::Rand() % 10 > 5) randNegY = -1;
 
   randX *= randNegX;
   randY *= -randY;
@@ -5,13 +5,17 @@
 #include "bnArtifact.h"
 #include "bnTextureResourceManager.h"
 
+#include <algorithm>
+
 constexpr auto TILE_ANIMATION_PATH = "resources/tiles/tiles.animation";
 
 Field::Field(int _width, int _height)
   : width(_width),
   height(_height),
   pending(),
-  tiles(vector<vector<Battle::Tile*>>())
+  tiles(),
+  columns((size_t)_width + 2),
+  restoreCols()
   {
   // Moved tile resource acquisition to field so we only them once for all tiles
   Animation a(TILE_ANIMATION_PATH);
@@ -21,48 +25,34 @@ Field::Field(int _width, int _height)
   auto t_a_b = TEXTURES.GetTexture(TextureType::TILE_ATLAS_BLUE);
   auto t_a_r = TEXTURES.GetTexture(TextureType::TILE_ATLAS_RED);
 
+  // Never grows after this so tile pointers stay valid
+  tiles.reserve((size_t)(_width + 2) * (_height + 2));
+
   for (int y = 0; y < _height+2; y++) {
-    vector<Battle::Tile*> row = vector<Battle::Tile*>();
     for (int x = 0; x < _width+2; x++) {
-      Battle::Tile* tile = new Battle::Tile(x, y);
-      tile->SetField(this);
-      tile->animation = a;
-      tile->blue_team_atlas = t_a_b;
-      tile->red_team_atlas = t_a_r;
-      row.push_back(tile);
+      // The left half of the field starts red
+      tiles.emplace_back(x, y, x <= _width / 2 ? Team::RED : Team::BLUE);
+
+      Battle::Tile& tile = tiles.back();
+      tile.SetField(this);
+      tile.animation = a;
+      tile.blue_team_atlas = t_a_b;
+      tile.red_team_atlas = t_a_r;
     }
-    tiles.push_back(row);
   }
 
-  /*
-  // DEBUGGING
-  // invisible tiles surround the arena for some entities to slide off of
-  for (int i = 0; i < _width + 2; i++) {
-    tiles[0][i]->setColor(sf::Color(255, 255, 255, 50));
-  }
-
-  for (int i = 0; i < _width + 2; i++) {
-    tiles[_height + 1][i]->setColor(sf::Color(255, 255, 255, 50));
-  }
-
-  for (int i = 1; i < _height + 1; i++) {
-    tiles[i][0]->setColor(sf::Color(255, 255, 255, 50));
-    tiles[i][_width + 1]->setColor(sf::Color(255, 255, 255, 50));
-
-  }*/
+  restoreCols.reserve(columns.size());
 
   isBattleActive = false;
   isUpdating = false;
+  keepDeleted = false;
 }
 
 Field::~Field() {
-  for (size_t i = 0; i < tiles.size(); i++) {
-    for (size_t j = 0; j < tiles[i].size(); j++) {
-      delete tiles[i][j];
-    }
-    tiles[i].clear();
-  }
   tiles.clear();
+
+  eventBus.KeepDeleted(nullptr);
+  ClearGraveyard();
 }
 
 int Field::GetWidth() const {
@@ -76,15 +66,7 @@ int Field::GetHeight() const {
 std::vector<Battle::Tile*> Field::FindTiles(std::function<bool(Battle::Tile* t)> query)
 {
   std::vector<Battle::Tile*> res;
-  
-  for(int i = 0; i < tiles.size(); i++) {
-    for(int j = 0; j < tiles[i].size(); j++) {
-      if(query(tiles[i][j])) {
-          res.push_back(tiles[i][j]);
-      }
-    }
-  }
-    
+  FindTiles(res, query);
   return res;
 }
 
@@ -188,32 +170,29 @@ void Field::AddEntity(Artifact & art, Battle::Tile & dest)
 std::vector<Entity*> Field::FindEntities(std::function<bool(Entity* e)> query)
 {
   std::vector<Entity*> res;
-
-  for (int y = 1; y <= height; y++) {
-    for (int x = 1; x <= width; x++) {
-      Battle::Tile* tile = GetAt(x, y);
-
-      std::vector<Entity*> found = tile->FindEntities(query);
-      res.reserve(res.size() + found.size()); // preallocate memory
-      res.insert(res.end(), found.begin(), found.end());
-    }
-  }
-
+  FindEntities(res, query);
   return res;
 }
 
 void Field::SetAt(int _x, int _y, Team _team) {
-  if (_x < 0 || _x > 7) return;
-  if (_y < 0 || _y > 4) return;
+  if (_x < 0 || _x > width + 1) return;
+  if (_y < 0 || _y > height + 1) return;
+
+  At(_x, _y).SetTeam(_team);
+}
+
+Battle::Tile* Field::GetAt(int _x, int _y) {
+  if (_x < 0 || _x > width + 1) return nullptr;
+  if (_y < 0 || _y > height + 1) return nullptr;
 
-  tiles[_y][_x]->SetTeam(_team);
+  return &At(_x, _y);
 }
 
-Battle::Tile* Field::GetAt(int _x, int _y) const {
-  if (_x < 0 || _x > 7) return nullptr;
-  if (_y < 0 || _y > 4) return nullptr;
+const Battle::Tile* Field::GetAt(int _x, int _y) const {
+  if (_x < 0 || _x > width + 1) return nullptr;
+  if (_y < 0 || _y > height + 1) return nullptr;
 
-  return tiles[_y][_x];
+  return &At(_x, _y);
 }
 
 void Field::Update(float _elapsed) {
@@ -240,96 +219,122 @@ void Field::Update(float _elapsed) {
   // FORCES PENDING OF NEWLY ADDED ENTITIES
   this->isUpdating = true;
 
-  int entityCount = 0;
+  const int stride = width + 2;
 
-  int redTeamFarCol = 0; // from red's perspective, 5 is the farthest - begin at the first (0 col) index and increment
-  int blueTeamFarCol = 5; // from blue's perspective, 0  is the farthest - begin at the first (5th col) index and increment
+  for (size_t i = 0; i < tiles.size(); i++) {
+    const int j = (int)(i % stride); // col
 
-  // tile cols to check to restore team state
-  std::map<int, bool> backToRed;
-  std::map<int, bool> backToBlue;
+    Battle::Tile* t = &tiles[i];
+    t->Update(_elapsed);
 
-  float syncBlueTeamCooldown = 0;
-  float syncRedTeamCooldown = 0;
+    // Red tiles on blue's side and blue tiles on red's side go back when their cooldown is over
+    Team stolen = j <= width / 2 ? Team::BLUE : Team::RED;
 
-  for (int i = 0; i < tiles.size(); i++) {
-    for (int j = 0; j < tiles[i].size(); j++) {
-      tiles[i][j]->Update(_elapsed);
+    if (t->GetTeam() == stolen && t->teamCooldown <= 0 && !columns[j].restore) {
+      columns[j].restore = true;
+      restoreCols.push_back(j);
+    }
 
-      auto t = tiles[i][j];
+    t->SetBattleActive(isBattleActive);
+  }
 
-      for(auto it = t->characters.begin(); it != t->characters.end(); it++) {
-        if((*it)->GetTeam() == Team::RED && redTeamFarCol <= j) { redTeamFarCol = j; }
-        else if((*it)->GetTeam() == Team::BLUE && blueTeamFarCol >= j) { blueTeamFarCol = j; }
-      }
+  if (restoreCols.size()) {
+    int redTeamFarCol = 0; // from red's perspective, width - 1 is the farthest
+    int blueTeamFarCol = width - 1; // from blue's perspective, 0 is the farthest
 
-      if(j <= 3) {
-        // sync stolen red tiles together
-        syncRedTeamCooldown = std::max(syncRedTeamCooldown, t->flickerTeamCooldown);
+    for (int j = 0; j < stride; j++) {
+      if (columns[j].red) { redTeamFarCol = std::max(redTeamFarCol, j); }
+      if (columns[j].blue) { blueTeamFarCol = std::min(blueTeamFarCol, j); }
+    }
 
-        // tiles should be red
-        if(t->GetTeam() == Team::BLUE) {
-          if(t->teamCooldown <= 0) {
-            backToRed.insert(std::make_pair(j, true));
-          }
-        }
-      } else{
-        // sync stolen blue tiles together
-        syncBlueTeamCooldown = std::max(syncBlueTeamCooldown, t->flickerTeamCooldown);
-
-        if(t->GetTeam() == Team::RED) {
-          if(t->teamCooldown <= 0) {
-            backToBlue.insert(std::make_pair(j, true));
-          }
-        }
-      }
+    // Restore **whole** col team states not just a single tile...
+    // col must be ahead of the furthest character of the same team
+    // e.g. red team characters must be behind the col row
+    //      blue team characters must be ahead the col row
+    // otherwise we risk trapping characters in a striped battle field
+    for (int j : restoreCols) {
+      columns[j].restore = false;
 
-      entityCount += (int)tiles[i][j]->GetEntityCount();
-      tiles[i][j]->SetBattleActive(isBattleActive);
-    }
-  }
+      if (j > width / 2) {
+        if (j <= redTeamFarCol) continue;
 
-  /*if (syncRedTeamCooldown != 0.f && syncBlueTeamCooldown != 0.f) {
-    for (int x = 0; x < width; x++) {
-      for (int y = 0; y < height; y++) {
-        auto t = tiles[y][x];
-        if (x <= 2) {
-          t->flickerTeamCooldown = syncRedTeamCooldown;
+        for (int y = 0; y < height + 2; y++) {
+          At(j, y).SetTeam(Team::BLUE, true);
         }
-        else {
-          t->flickerTeamCooldown = syncBlueTeamCooldown;
+      }
+      else {
+        if (j >= blueTeamFarCol) continue;
+
+        for (int y = 0; y < height + 2; y++) {
+          At(j, y).SetTeam(Team::RED, true);
         }
       }
     }
-  }*/
-
-  // Restore **whole** col team states not just a single tile...
-  // col must be ahead of the furthest character of the same team
-  // e.g. red team characters must be behind the col row
-  //      blue team characters must be ahead the col row
-  // otherwise we risk trapping characters in a striped battle field
-  for(auto p : backToBlue) {
-    if (p.first <= redTeamFarCol) continue;
-
-    for(int i = 0; i < tiles.size(); i++) {
-      tiles[i][p.first]->SetTeam(Team::BLUE, true);
-    }
+
+    restoreCols.clear();
   }
 
-  backToBlue.clear();
+  // UNLOCK ADD ENTITIES FUNCTION
+  this->isUpdating = false;
+}
 
-  for(auto p : backToRed) {
-    if (p.first >= blueTeamFarCol) continue;
+BattleEventBus& Field::GetEventBus()
+{
+  return eventBus;
+}
+
+void Field::CountCharacter(int col, Team team, int amount)
+{
+  if (col < 0 || col >= (int)columns.size()) return;
 
-    for(int i = 0; i < tiles.size(); i++) {
-      tiles[i][p.first]->SetTeam(Team::RED, true);
+  if (team == Team::RED) {
+    columns[col].red += amount;
+  }
+  else if (team == Team::BLUE) {
+    columns[col].blue += amount;
+  }
+}
+
+void Field::RecountColumns()
+{
+  for (Column& column : columns) {
+    column.red = column.blue = 0;
+  }
+
+  for (Battle::Tile& tile : tiles) {
+    for (Character* character : tile.characters) {
+      CountCharacter(tile.GetX(), character->GetTeam(), 1);
     }
   }
+}
 
-  backToRed.clear();
+void Field::KeepDeleted(bool keep)
+{
+  keepDeleted = keep;
+  eventBus.KeepDeleted(keep ? &graveyard : nullptr);
 
-  // UNLOCK ADD ENTITIES FUNCTION
-  this->isUpdating = false;
+  if (!keep) {
+    ClearGraveyard();
+  }
+}
+
+void Field::ReleaseEntity(Entity* entity)
+{
+  if (keepDeleted) {
+    graveyard.push_back(entity);
+  }
+  else {
+    delete entity;
+  }
+}
+
+void Field::ClearGraveyard()
+{
+  for (Entity* e : graveyard) {
+    delete e;
+  }
+
+  graveyard.clear();
 }
 
 void Field::SetBattleActive(bool state)
@@ -341,10 +346,9 @@ void Field::TileRequestsRemovalOfQueued(Battle::Tile* tile, long ID)
 {
   auto q = pending.begin();
   while(q != pending.end()) {
-    if (q->x == tile->GetX() && q->y == tile->GetY()) {
-      if (q->ID == ID) {
-        q = pending.erase(q);
-      }
+    if (q->x == tile->GetX() && q->y == tile->GetY() && q->ID == ID) {
+      q = pending.erase(q);
+      continue;
     }
 
     q++;
@@ -8,17 +8,21 @@ using std::endl;
 
 #include "bnEntity.h"
 #include "bnCharacterDeletePublisher.h"
+#include "bnBattleEventBus.h"
 
 class Character;
 class Spell;
 class Obstacle;
 class Artifact;
+class BattleSnapshot;
 
 namespace Battle {
   class Tile;
 }
 
 class Field : public CharacterDeletePublisher {
+  friend class BattleSnapshot;
+
 public:
   
   /**
@@ -47,9 +51,40 @@ public:
    * @brief Query for tiles that pass the input function
    * @param query input function, returns true or false based on conditions
    * @return vector of Tile* passing the input
+   * @see FindTiles(std::vector<Battle::Tile*>&, F&&) to reuse a buffer
    */
   std::vector<Battle::Tile*> FindTiles(std::function<bool(Battle::Tile* t)> query);
 
+  /**
+   * @brief Visit every tile row by row, edge tiles included. Nothing is allocated.
+   * @param visit called with each Battle::Tile*
+   */
+  template<typename F>
+  void ForEachTile(F&& visit);
+
+  /**
+   * @brief Visit every entity on the field. Nothing is allocated.
+   * @param visit called with each Entity*. Must not add or remove entities.
+   */
+  template<typename F>
+  void ForEachEntity(F&& visit);
+
+  /**
+   * @brief Query for tiles into a buffer the caller keeps between calls
+   * @param out cleared and filled with the tiles passing query. Its capacity is reused.
+   * @param query returns true for tiles to keep
+   */
+  template<typename F>
+  void FindTiles(std::vector<Battle::Tile*>& out, F&& query);
+
+  /**
+   * @brief Query for entities into a buffer the caller keeps between calls
+   * @param out cleared and filled with the entities passing query. Its capacity is reused.
+   * @param query returns true for entities to keep
+   */
+  template<typename F>
+  void FindEntities(std::vector<Entity*>& out, F&& query);
+
   /**
    * @brief Adds a character using the character's AdoptTile() routine
    * @param character
@@ -90,6 +125,7 @@ public:
    * @brief Query for entities on the entire field
    * @param e the query input function
    * @return list of Entity* that passed the input function's conditions
+   * @see FindEntities(std::vector<Entity*>&, F&&) to reuse a buffer
    */
   std::vector<Entity*> FindEntities(std::function<bool(Entity* e)> query);
 
@@ -105,9 +141,19 @@ public:
    * @brief Get the tile at (x,y)
    * @param _x col
    * @param _y row
-   * @return null if x < 1 or x > 6 or y < 1 or y > 3, otherwise returns Tile*
+   * @return null if (x,y) is outside the field and its edge, otherwise returns Tile*
+   */
+  Battle::Tile* GetAt(int _x, int _y);
+  const Battle::Tile* GetAt(int _x, int _y) const;
+
+  /**
+   * @brief Get the tile at (x,y) without a bounds check
+   * @param _x col from 0 to width + 1
+   * @param _y row from 0 to height + 1
+   * @return Tile&
    */
-  Battle::Tile* GetAt(int _x, int _y) const;
+  Battle::Tile& At(int _x, int _y);
+  const Battle::Tile& At(int _x, int _y) const;
 
   /**
    * @brief Updates all tiles
@@ -128,6 +174,48 @@ public:
   */
   void TileRequestsRemovalOfQueued(Battle::Tile*, long ID);
 
+  /**
+   * @brief Events posted during Update() wait here until the scene dispatches them
+   * @return BattleEventBus&
+   */
+  BattleEventBus& GetEventBus();
+
+  /**
+   * @brief Keep column occupancy in step with a tile's characters. Called by Battle::Tile and Entity::SetTeam().
+   * @param col column of the tile
+   * @param team of the character
+   * @param amount 1 when a character enters the tile, -1 when it leaves
+   */
+  void CountCharacter(int col, Team team, int amount);
+
+  /**
+   * @brief Count every column's characters again from the tiles
+   *
+   * Used when tiles are rebuilt outside of Battle::Tile::AddEntity() and
+   * Battle::Tile::RemoveEntityByID(), e.g. by a snapshot restore
+   */
+  void RecountColumns();
+
+  /**
+   * @brief Keep entities the field deletes alive in a graveyard instead of freeing them
+   * @param keep true to keep them, false to free the graveyard and stop keeping them
+   *
+   * BattleSnapshot turns this on so Restore() can bring back entities deleted after Save().
+   * Deleted characters still go through the event bus first.
+   */
+  void KeepDeleted(bool keep);
+
+  /**
+   * @brief Free an entity that was taken off its tile, or keep it if KeepDeleted() is on
+   * @param entity
+   */
+  void ReleaseEntity(Entity* entity);
+
+  /**
+   * @brief Free every entity in the graveyard
+   */
+  void ClearGraveyard();
+
 private:
 
   bool isBattleActive; /*!< State flag if battle is over */
@@ -167,5 +255,25 @@ private:
 
   vector<queueBucket> pending;
 
-  vector<vector<Battle::Tile*>> tiles; /*!< Nested vector to make calls via tiles[x][y] */
-};
\ No newline at end of file
+  BattleEventBus eventBus; /*!< deferred delete, counter, and chip events */
+
+  bool keepDeleted; /*!< set by KeepDeleted() */
+  vector<Entity*> graveyard; /*!< deleted entities kept for BattleSnapshot::Restore() */
+
+  // (width + 2) x (height + 2) tiles with the edge, row by row in one allocation.
+  // Made once in the constructor so pointers to tiles never change.
+  vector<Battle::Tile> tiles;
+
+  /*! \brief What the field knows about one column of tiles */
+  struct Column {
+    int red{ 0 }; /*!< red characters standing in the column */
+    int blue{ 0 }; /*!< blue characters standing in the column */
+    bool restore{ false }; /*!< a stolen tile's cooldown ran out this frame */
+  };
+
+  vector<Column> columns; /*!< width + 2 columns with the edge */
+  vector<int> restoreCols; /*!< columns marked restore this frame. Never grows past width + 2. */
+};
+
+// Templates above need a complete Battle::Tile. bnTile.h defines them.
+#include "bnTile.h"
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <SFML/System.hpp>
 
 #include "bnLogger.h"
+#include "bnVirtualFileSystem.h"
 
 #ifdef __ANDROID_NDK__
 #include <android/asset_manager.h>
@@ -88,23 +89,12 @@ public:
         }
     };
 
+  /**
+   * @brief Reads the whole file from the resource pack or from disk
+   * @see VirtualFileSystem
+   */
   static std::string Read(const std::string& _path) {
-    sf::FileInputStream in;
-
-    if (in.open(_path) && in.getSize() > 0) {
-      sf::Int64 size = in.getSize();
-      char* buffer = new char[size + 1];
-      in.read(buffer, size);
-      buffer[size] = '\0';
-
-      std::string strbuff(buffer);
-
-      delete[] buffer;
-
-      return strbuff;
-    }
-
-    return std::string("");
+    return VFS.ReadString(_path);
   }
 
   static std::string ValueOf(std::string key, std::string line) {
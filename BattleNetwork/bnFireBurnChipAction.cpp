@@ -31,6 +31,7 @@ FireBurnChipAction::FireBurnChipAction(Character * owner, FireBurn::Type type, i
 
 FireBurnChipAction::~FireBurnChipAction()
 {
+  TEXTURES.ReleaseTexture(PATH);
 }
 
 void FireBurnChipAction::Execute() {
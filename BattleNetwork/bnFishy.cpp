@@ -4,12 +4,14 @@
 #include "bnTextureResourceManager.h"
 #include "bnAudioResourceManager.h"
 
+#define TEXTURE_PATH "resources/spells/fishy_temp.png"
+
 Fishy::Fishy(Field* _field, Team _team, double speed) : Obstacle(field, team) {
   SetLayer(0);
   field = _field;
   hit = false;
   
-  auto texture = TEXTURES.LoadTextureFromFile("resources/spells/fishy_temp.png");
+  auto texture = TEXTURES.LoadTextureFromFile(TEXTURE_PATH);
   setTexture(*texture);
   setScale(2.f, 2.f);
   // why do we need to do this??
@@ -33,6 +35,7 @@ Fishy::Fishy(Field* _field, Team _team, double speed) : Obstacle(field, team) {
 }
 
 Fishy::~Fishy() {
+  TEXTURES.ReleaseTexture(TEXTURE_PATH);
 }
 
 void Fishy::OnUpdate(float _elapsed) {
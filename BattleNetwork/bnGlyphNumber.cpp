@@ -0,0 +1,118 @@
+#include "bnGlyphNumber.h"
+
+namespace {
+  // Enough for every digit of an int
+  const unsigned MAX_DIGITS = 10;
+}
+
+GlyphNumber::GlyphNumber(const sf::Texture& texture, sf::Vector2i glyphSize, sf::Vector2i zero, sf::Vector2i step)
+  : texture(&texture), glyphSize(glyphSize), zero(zero), step(step), vertices(sf::Triangles),
+  color(sf::Color::White), alignment(Alignment::LEFT), number(0), digits(1) {
+  Layout();
+}
+
+GlyphNumber::~GlyphNumber() {
+}
+
+void GlyphNumber::SetNumber(int number) {
+  if (number < 0) number = 0;
+
+  if (this->number == number) return;
+
+  this->number = number;
+  Layout();
+}
+
+const int GlyphNumber::GetNumber() const {
+  return number;
+}
+
+void GlyphNumber::SetColor(const sf::Color& color) {
+  if (this->color == color) return;
+
+  this->color = color;
+
+  for (size_t i = 0; i < vertices.getVertexCount(); i++) {
+    vertices[i].color = color;
+  }
+}
+
+void GlyphNumber::SetZero(sf::Vector2i zero) {
+  if (this->zero == zero) return;
+
+  this->zero = zero;
+  Layout();
+}
+
+void GlyphNumber::SetAlignment(Alignment alignment) {
+  if (this->alignment == alignment) return;
+
+  this->alignment = alignment;
+  Layout();
+}
+
+const float GlyphNumber::GetWidth() const {
+  return (float)(digits * glyphSize.x);
+}
+
+void GlyphNumber::Layout() {
+  // Pull the digits out from the lowest up
+  int reversed[MAX_DIGITS];
+  int value = number;
+  digits = 0;
+
+  do {
+    reversed[digits++] = value % 10;
+    value /= 10;
+  } while (value > 0 && digits < MAX_DIGITS);
+
+  // Shrinking keeps the capacity so a counter dialing down and back up does not reallocate
+  vertices.resize(digits * 6);
+
+  float w = (float)glyphSize.x;
+  float h = (float)glyphSize.y;
+  float x = 0;
+
+  if (alignment == Alignment::CENTER) {
+    x = -GetWidth() / 2.0f;
+  }
+  else if (alignment == Alignment::RIGHT) {
+    x = -GetWidth();
+  }
+
+  for (unsigned i = 0; i < digits; i++) {
+    int digit = reversed[digits - i - 1];
+
+    float u = (float)(zero.x + (step.x * digit));
+    float v = (float)(zero.y + (step.y * digit));
+
+    sf::Vertex* quad = &vertices[i * 6];
+
+    quad[0].position = sf::Vector2f(x, 0);
+    quad[1].position = sf::Vector2f(x + w, 0);
+    quad[2].position = sf::Vector2f(x, h);
+    quad[3].position = sf::Vector2f(x, h);
+    quad[4].position = sf::Vector2f(x + w, 0);
+    quad[5].position = sf::Vector2f(x + w, h);
+
+    quad[0].texCoords = sf::Vector2f(u, v);
+    quad[1].texCoords = sf::Vector2f(u + w, v);
+    quad[2].texCoords = sf::Vector2f(u, v + h);
+    quad[3].texCoords = sf::Vector2f(u, v + h);
+    quad[4].texCoords = sf::Vector2f(u + w, v);
+    quad[5].texCoords = sf::Vector2f(u + w, v + h);
+
+    for (int j = 0; j < 6; j++) {
+      quad[j].color = color;
+    }
+
+    x += w;
+  }
+}
+
+void GlyphNumber::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+  states.transform *= getTransform();
+  states.texture = texture;
+
+  target.draw(vertices, states);
+}
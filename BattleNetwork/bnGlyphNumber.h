@@ -0,0 +1,74 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class GlyphNumber
+ * @author mav
+ * @date 10/19/20
+ * @brief Draws a number with bitmap glyphs from one vertex array
+ *
+ * The digits are laid out once when the number, color or glyph row changes.
+ * Drawing an unchanged number is one draw call with no formatting or allocation.
+ *
+ * Glyph sheets store the digits in a line. The rect of digit n is the rect of 0
+ * moved by n steps, so both the vertical enemy set and the horizontal player set work.
+ *
+ * Negative numbers are drawn as 0.
+ */
+class GlyphNumber : public sf::Drawable, public sf::Transformable {
+public:
+  /*! \brief Where the origin sits relative to the digits */
+  enum class Alignment : int {
+    LEFT,
+    CENTER,
+    RIGHT
+  };
+
+  /**
+   * @param texture glyph sheet
+   * @param glyphSize size of one digit in pixels
+   * @param zero top left of the digit 0 in the sheet
+   * @param step distance in the sheet from one digit to the next
+   */
+  GlyphNumber(const sf::Texture& texture, sf::Vector2i glyphSize, sf::Vector2i zero, sf::Vector2i step);
+  ~GlyphNumber();
+
+  /**
+   * @brief Lays out the digits again only if the number changed
+   * @param number
+   */
+  void SetNumber(int number);
+  const int GetNumber() const;
+
+  /**
+   * @brief Recolors the digits only if the color changed
+   * @param color
+   */
+  void SetColor(const sf::Color& color);
+
+  /**
+   * @brief Move the digit 0 to another place in the sheet. Used to switch color rows.
+   * @param zero top left of the digit 0 in the sheet
+   */
+  void SetZero(sf::Vector2i zero);
+
+  void SetAlignment(Alignment alignment);
+
+  /**
+   * @brief Width of the number in pixels before scaling
+   */
+  const float GetWidth() const;
+
+  virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+private:
+  void Layout();
+
+  const sf::Texture* texture;
+  sf::Vector2i glyphSize, zero, step;
+  sf::VertexArray vertices; /*!< six vertices per digit */
+  sf::Color color;
+  Alignment alignment;
+  int number;
+  unsigned digits; /*!< digits in number */
+};
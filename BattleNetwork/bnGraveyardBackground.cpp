@@ -9,9 +9,10 @@
 #define COMPONENT_FRAME_COUNT 8
 #define COMPONENT_WIDTH 128
 #define COMPONENT_HEIGHT 32
+#define TEXTURE_PATH "resources/backgrounds/grave/fg.png"
 
 GraveyardBackground::GraveyardBackground(void)
-  : x(0.0f), y(0.0f), progress(0.0f), Background(*TEXTURES.LoadTextureFromFile("resources/backgrounds/grave/fg.png"), 240, 180) {
+  : x(0.0f), y(0.0f), progress(0.0f), Background(TEXTURE_PATH, 240, 180) {
   FillScreen(sf::Vector2u(COMPONENT_WIDTH, COMPONENT_HEIGHT));
 }
 
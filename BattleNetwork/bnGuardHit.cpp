@@ -6,6 +6,7 @@
 #include "bnCharacter.h"
 
 #include <cmath>
+#include "bnBattleContext.h"
 
 using sf::IntRect;
 
@@ -20,14 +21,14 @@ GuardHit::GuardHit(Field* _field, Character* hit, bool center) : Artifact(_field
 
   if (!center) {
     float random = hit->getLocalBounds().width / 2.0f;
-    random *= rand() % 2 == 0 ? -1.0f : 1.0f;
+    random *= BattleContext::Rand() % 2 == 0 ? -1.0f : 1.0f;
 
     w = (float)random;
 
     h = (float)(std::floor(hit->GetHeight()));
 
     if (h > 0) {
-      h = (float)(rand() % (int)h);
+      h = (float)(BattleContext::Rand() % (int)h);
     }
   }
   else {
@@ -41,6 +41,9 @@ HoneyBomber::HoneyBomber(Rank _rank)
 }
 
 HoneyBomber::~HoneyBomber() {
+  // Honey bombers removed without being deleted would keep their turn forever
+  this->RemoveMeFromTurnOrder();
+
   delete shadow;
 }
 
@@ -66,4 +69,14 @@ const bool HoneyBomber::OnHit(const Hit::Properties props) {
 
 const float HoneyBomber::GetHeight() const {
   return 30.0f;
-}
\ No newline at end of file
+}
+
+void HoneyBomber::SaveState(BattleSnapshot& snapshot) const{
+  AI<HoneyBomber>::SaveAI(snapshot);
+  Character::SaveState(snapshot);
+}
+
+void HoneyBomber::LoadState(BattleSnapshot& snapshot){
+  AI<HoneyBomber>::LoadAI(snapshot);
+  Character::LoadState(snapshot);
+}
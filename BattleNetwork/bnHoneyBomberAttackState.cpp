@@ -4,6 +4,7 @@
 #include "bnBees.h"
 #include "bnHoneyBomberIdleState.h"
 #include "bnAnimationComponent.h"
+#include "bnBattleSnapshot.h"
 
 HoneyBomberAttackState::HoneyBomberAttackState() : AIState<HoneyBomber>() { 
   beeCount = 3; 
@@ -70,3 +71,18 @@ void HoneyBomberAttackState::DoAttack(HoneyBomber& honey) {
     honey.GetField()->AddEntity(*bee, honey.GetTile()->GetX() - 1, honey.GetTile()->GetY());
   }
 }
+
+void HoneyBomberAttackState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(beeCount);
+  snapshot.Write(attackCooldown);
+  snapshot.Write(lastBee ? lastBee->GetID() : 0L);
+}
+
+void HoneyBomberAttackState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(beeCount);
+  snapshot.Read(attackCooldown);
+
+  long beeID = 0;
+  snapshot.Read(beeID);
+  lastBee = dynamic_cast<Bees*>(snapshot.FindEntity(beeID));
+}
@@ -45,6 +45,18 @@ public:
    */
   void OnLeave(HoneyBomber& honey);
 
+  /**
+   * @brief Writes the state's timers and flags
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back what SaveState() wrote
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
+
   /**
    * @brief animates before spawning a series of bees
    * @param honey
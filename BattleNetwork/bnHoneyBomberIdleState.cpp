@@ -2,6 +2,7 @@
 #include "bnHoneyBomberIdleState.h"
 #include "bnHoneyBomberMoveState.h"
 #include "bnAnimationComponent.h"
+#include "bnBattleSnapshot.h"
 #include <iostream>
 
 HoneyBomberIdleState::HoneyBomberIdleState() : cooldown(1), AIState<HoneyBomber>() { ; }
@@ -26,3 +27,10 @@ void HoneyBomberIdleState::OnUpdate(float _elapsed, HoneyBomber& honey) {
 void HoneyBomberIdleState::OnLeave(HoneyBomber& honey) {
 }
 
+void HoneyBomberIdleState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(cooldown);
+}
+
+void HoneyBomberIdleState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(cooldown);
+}
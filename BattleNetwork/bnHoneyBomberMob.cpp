@@ -3,6 +3,7 @@
 #include "bnField.h"
 #include "bnSpawnPolicy.h"
 #include "bnChipsSpawnPolicy.h"
+#include "bnBattleContext.h"
 
 HoneyBomberMob::HoneyBomberMob(Field* field) : MobFactory(field)
 {
@@ -16,9 +17,9 @@ HoneyBomberMob::~HoneyBomberMob()
 Mob* HoneyBomberMob::Build() {
   Mob* mob = new Mob(field);
 
-  mob->Spawn<Rank1<HoneyBomber>>(4 + (rand() % 3), 1);
-  mob->Spawn<Rank1<HoneyBomber>>(4 + (rand() % 3), 2);
-  mob->Spawn<Rank1<HoneyBomber>>(4 + (rand() % 3), 3);
+  mob->Spawn<Rank1<HoneyBomber>>(4 + (BattleContext::Rand() % 3), 1);
+  mob->Spawn<Rank1<HoneyBomber>>(4 + (BattleContext::Rand() % 3), 2);
+  mob->Spawn<Rank1<HoneyBomber>>(4 + (BattleContext::Rand() % 3), 3);
 
   return mob;
 }
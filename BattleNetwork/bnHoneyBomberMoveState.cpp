@@ -5,6 +5,8 @@
 #include "bnMobMoveEffect.h"
 #include "bnAnimationComponent.h"
 #include "bnHoneyBomberAttackState.h"
+#include "bnBattleContext.h"
+#include "bnBattleSnapshot.h"
 
 HoneyBomberMoveState::HoneyBomberMoveState() : isMoving(false), moveCount(3), cooldown(1), AIState<HoneyBomber>() { ; }
 HoneyBomberMoveState::~HoneyBomberMoveState() { ; }
@@ -30,7 +32,10 @@ void HoneyBomberMoveState::OnUpdate(float _elapsed, HoneyBomber& honey) {
     return honey.ChangeState<HoneyBomberAttackState>();
   }
 
-  auto myteam = honey.GetField()->FindTiles([&honey](Battle::Tile* t) {
+  // Reused between moves so picking a tile does not allocate
+  static thread_local std::vector<Battle::Tile*> myteam;
+
+  honey.GetField()->FindTiles(myteam, [&honey](Battle::Tile* t) {
     if (t->GetTeam() == honey.GetTeam())
       return true;
 
@@ -41,7 +46,7 @@ void HoneyBomberMoveState::OnUpdate(float _elapsed, HoneyBomber& honey) {
   int teley = 0;
 
   if (myteam.size() > 0) {
-      int randIndex = rand() % myteam.size();
+      int randIndex = BattleContext::Rand() % myteam.size();
       telex = myteam[randIndex]->GetX();
       teley = myteam[randIndex]->GetY();
   }
@@ -67,3 +72,15 @@ void HoneyBomberMoveState::OnUpdate(float _elapsed, HoneyBomber& honey) {
 void HoneyBomberMoveState::OnLeave(HoneyBomber& met) {
 
 }
+
+void HoneyBomberMoveState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(isMoving);
+  snapshot.Write(moveCount);
+  snapshot.Write(cooldown);
+}
+
+void HoneyBomberMoveState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(isMoving);
+  snapshot.Read(moveCount);
+  snapshot.Read(cooldown);
+}
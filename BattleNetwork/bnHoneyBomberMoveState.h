@@ -46,5 +46,17 @@ public:
    * @param honey
    */
   void OnLeave(HoneyBomber& honey);
+
+  /**
+   * @brief Writes the state's timers and flags
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back what SaveState() wrote
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
 };
 
@@ -7,21 +7,28 @@ namespace Overworld {
   {
     this->branchDepth = branchDepth;
 
+    npcs.resize(INFINITE_MAP_MAX_NPCS);
+    nextNPC = 0;
+    liveNPCs = 0;
+
     ToggleLighting(false);
 
     DeleteTiles();
 
+    // Enough spares to rebuild the visible road and its branches without allocating
+    tiles.SetSpareCapacity((size_t)(numOfCols * 5 + branchDepth));
+
     // One long road
     int row = 0;
     for (int i = 0; i < numOfCols; i++) {
-      map.push_back(new Tile(sf::Vector2f((float)i*tileWidth, (float)row*tileHeight)));
+      head = tiles.Create(sf::Vector2f((float)i*tileWidth, (float)row*tileHeight));
+      tiles.Insert(head);
     }
 
     // Add the arrow at the top
-    map.insert(map.begin(), new Tile(&LOAD_TEXTURE(MAIN_MENU_ARROW), sf::Vector2f(-(float)((LOAD_TEXTURE(MAIN_MENU_ARROW)).getSize().x*1.25), 0)));
+    tiles.Insert(new Tile(&LOAD_TEXTURE(MAIN_MENU_ARROW), sf::Vector2f(-(float)((LOAD_TEXTURE(MAIN_MENU_ARROW)).getSize().x*1.25), 0)));
 
-    // Make a pointer to the start of the map
-    head = map.back();
+    // head points to the start of the map
 
     // Load NPC animations
     animator = Animator();
@@ -36,133 +43,133 @@ namespace Overworld {
 
   InfiniteMap::~InfiniteMap()
   {
+    // Lights are deleted by the map. Sprites are owned by the ring.
+    sprites.clear();
   }
 
+  void InfiniteMap::SpawnNPC(NPCType type, const sf::Vector2f& pos) {
+    NPC& npc = npcs[nextNPC];
+    nextNPC = (nextNPC + 1) % npcs.size();
 
-  void InfiniteMap::DrawTiles(sf::RenderTarget& target, sf::RenderStates states) const {
-    //std::cout << "map size: " << map.size() << "\n";
-    for (int i = 0; i < map.size(); i++) {
-      sf::Sprite tileSprite(map[i]->GetTexture());
-
-
-      tileSprite.setScale(2.0f, 2.0f);
-      sf::Vector2f pos = map[i]->GetPos();
-
-      if (cam) {
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
-
-        pos -= offset;
+    if (npc.active) {
+      RecycleNPC(npc);
+    }
 
-        pos = OrthoToIsometric(pos*2.0f);
+    npc.sprite = sf::Sprite(LOAD_TEXTURE(OW_MR_PROG));
+    npc.sprite.setPosition(pos);
+    npc.type = type;
+    npc.active = true;
+    liveNPCs++;
 
-        tileSprite.setPosition(pos);
+    this->AddSprite(&npc.sprite);
 
-        if (!cam->IsInView(tileSprite)) {
-          if (pos.x < 0) {
-            if (&(*head) != &(*map[i])) {
-              map[i]->Cleanup();
-              continue;
-            }
-          }
-        }
-      }
+#ifndef __ANDROID__
+    if (type == NPCType::MR_PROG_FIRE) {
+      npc.light = new Light(pos, sf::Color(255, 120, 0), 10);
+      this->AddLight(npc.light);
     }
-    
-    Map::DrawTiles(target, states);
-
-    /*
+#endif
+  }
 
-      pos = map[i]->GetPos();
+  void InfiniteMap::RecycleNPC(NPC& npc) {
+    this->RemoveSprite(&npc.sprite);
 
-      if (cam) {
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
+    if (npc.light) {
+      this->RemoveLight(npc.light);
+      npc.light = nullptr;
+    }
 
-        pos -= offset;
-      }
+    npc.active = false;
+    liveNPCs--;
+  }
 
-      pos = OrthoToIsometric(pos*2.0f);
+  const size_t InfiniteMap::GetNPCCount() const {
+    return liveNPCs;
+  }
 
-      if (cam) {
-        tileSprite.setPosition(pos);
 
-        if (cam->IsInView(tileSprite)) {
-          target.draw(tileSprite, states);
-        }
-      }
-    } */
-  }
-  
   void InfiniteMap::Update(double elapsed)
   {
     static float total = 0;
     total += (float)elapsed;
 
-    for (auto npc : npcs) {
-      if (!npc)
+    for (auto& npc : npcs) {
+      if (!npc.active)
         continue;
 
-      switch (npc->type) {
+      switch (npc.type) {
       case NPCType::MR_PROG_DOWN:
       {
-        animator(total, npc->sprite, progAnimations.GetFrameList("PROG_DR"));
+        animator(total, npc.sprite, progAnimations.GetFrameList("PROG_DR"));
 
-        sf::Vector2f newPos = npc->sprite.getPosition();
-        npc->sprite.setPosition(newPos);
+        sf::Vector2f newPos = npc.sprite.getPosition();
+        npc.sprite.setPosition(newPos);
       }
       break;
       case NPCType::MR_PROG_LEFT:
       {
-        animator(total, npc->sprite, progAnimations.GetFrameList("PROG_UR"));
+        animator(total, npc.sprite, progAnimations.GetFrameList("PROG_UR"));
       }
       break;
       case NPCType::MR_PROG_RIGHT:
       {
-        animator(total, npc->sprite, progAnimations.GetFrameList("PROG_DR"));
-        npc->sprite.setScale(-1.0f, 1.0f);
+        animator(total, npc.sprite, progAnimations.GetFrameList("PROG_DR"));
+        npc.sprite.setScale(-1.0f, 1.0f);
         
-        // sf::Vector2f newPos = npc->sprite.getPosition();
+        // sf::Vector2f newPos = npc.sprite.getPosition();
         // newPos.x += 10 * elapsed;
-        // npc->sprite.setPosition(newPos);
+        // npc.sprite.setPosition(newPos);
       }
       break;
       case NPCType::MR_PROG_UP:
       {
-        animator(total, npc->sprite, progAnimations.GetFrameList("PROG_UR"));
+        animator(total, npc.sprite, progAnimations.GetFrameList("PROG_UR"));
 
       }
       break;
       case NPCType::MR_PROG_FIRE:
       {
-        animator(total, npc->sprite, progAnimations.GetFrameList("PROG_DR_FIRE"));
+        animator(total, npc.sprite, progAnimations.GetFrameList("PROG_DR_FIRE"));
       }
       break;
       case NPCType::NUMBERMAN_DANCE:
       {
-        animator(total, npc->sprite, numbermanAnimations.GetFrameList("NUMBERMAN_DANCE"));
+        animator(total, npc.sprite, numbermanAnimations.GetFrameList("NUMBERMAN_DANCE"));
       }
       break;
       case NPCType::NUMBERMAN_DOWN:
       {
-        animator(total, npc->sprite, numbermanAnimations.GetFrameList("NUMBERMAN_IDLE_DR"));
+        animator(total, npc.sprite, numbermanAnimations.GetFrameList("NUMBERMAN_IDLE_DR"));
       }
       break;
       }
     }
 
-    Map::Update(elapsed);
+    // Recycle tiles and npcs that scrolled off the left of the screen. The head is always kept.
+    if (cam) {
+      sf::View view = cam->GetView();
+      float left = view.getCenter().x - (view.getSize().x / 2.0f);
 
-    std::sort(map.begin(), map.end(), InfiniteMap::TileComparitor(this));
+      // Tiles this far left can no longer pass Camera::IsInView() at 2x scale
+      left -= (float)(GetTileSize().x * 2);
 
-    if (std::max((int)(map.size()-branchDepth), 0) < cols*5) {
+      tiles.RemoveLeftOf(left, [this](Tile* tile) { return tile == head; });
 
-      Overworld::Tile* tile = new Tile(sf::Vector2f(head->GetPos().x + this->GetTileSize().x, head->GetPos().y));
-      map.push_back(tile);
+      for (auto& npc : npcs) {
+        if (npc.active && tiles.ToIsometric(npc.sprite.getPosition()).x < left) {
+          RecycleNPC(npc);
+        }
+      }
+    }
 
-      head = tile;
+    Map::Update(elapsed);
+
+    if (std::max((int)(tiles.Size()-branchDepth), 0) < cols*5) {
 
-      std::sort(map.begin(), map.end(), InfiniteMap::TileComparitor(this));
+      Overworld::Tile* tile = tiles.Create(sf::Vector2f(head->GetPos().x + this->GetTileSize().x, head->GetPos().y));
+      tiles.Insert(tile);
+
+      head = tile;
 
       int depth = 0;
 
@@ -181,26 +188,19 @@ namespace Overworld {
 		  if (randDirection == 1 && lastDirection == 0)
 		    continue;
 
-      auto npcType = NPCType::MR_PROG_DOWN;
-      sf::Vector2f npcPosition;
-
 		  if (randDirection == 0) {
 	      distFromPath--;
 
-			  offroad = new Tile(sf::Vector2f(offroad->GetPos().x, offroad->GetPos().y + this->GetTileSize().y));
-			  map.push_back(offroad);
+			  offroad = tiles.Create(sf::Vector2f(offroad->GetPos().x, offroad->GetPos().y + this->GetTileSize().y));
+			  tiles.Insert(offroad);
 				
 			  if (randSpawnNPC == 0 && distFromPath != 0) {
-          npcType = (NPCType)(rand()%((int)(NPCType::MR_PROG_FIRE) + 1));
-			    npcs.push_back(new NPC { sf::Sprite(LOAD_TEXTURE(OW_MR_PROG)), npcType });
+          auto npcType = (NPCType)(rand()%((int)(NPCType::MR_PROG_FIRE) + 1));
 
 			    sf::Vector2f pos = offroad->GetPos();
 			    pos += sf::Vector2f(45, 0);
 
-			    npcs.back()->sprite.setPosition(pos);
-          npcPosition = pos;
-
-			    this->AddSprite(&npcs.back()->sprite);
+          SpawnNPC(npcType, pos);
 		    }
 			
 			  depth++;
@@ -208,27 +208,23 @@ namespace Overworld {
 		  else if (randDirection == 1) {
 			  distFromPath++;
 
-			  offroad = new Tile(sf::Vector2f(offroad->GetPos().x, offroad->GetPos().y - this->GetTileSize().y));
-			  map.push_back(offroad);
+			  offroad = tiles.Create(sf::Vector2f(offroad->GetPos().x, offroad->GetPos().y - this->GetTileSize().y));
+			  tiles.Insert(offroad);
 
 			  if (randSpawnNPC == 0 && distFromPath != 0) {
-          npcType = (NPCType)(rand()%((int)(NPCType::MR_PROG_FIRE) + 1));
-		        npcs.push_back(new NPC { sf::Sprite(LOAD_TEXTURE(OW_MR_PROG)), npcType });
+          auto npcType = (NPCType)(rand()%((int)(NPCType::MR_PROG_FIRE) + 1));
 
 			    sf::Vector2f pos = offroad->GetPos();
 			    pos += sf::Vector2f(45, 0);
 
-			    npcs.back()->sprite.setPosition(pos);
-          npcPosition = pos;
-
-			    this->AddSprite(&npcs.back()->sprite);
+          SpawnNPC(npcType, pos);
 			  }
 
 			  depth++;
 		  }
 		  else if (depth > 1) {
-			  offroad = new Tile(sf::Vector2f(offroad->GetPos().x + this->GetTileSize().x, offroad->GetPos().y));
-			  map.push_back(offroad);
+			  offroad = tiles.Create(sf::Vector2f(offroad->GetPos().x + this->GetTileSize().x, offroad->GetPos().y));
+			  tiles.Insert(offroad);
 
 			  depth++;
 		  }
@@ -257,15 +253,8 @@ namespace Overworld {
 			distFromPath = distFromPath + (randDirection ? -randDirection : 1);
 		  }*/
 
-#ifndef __ANDROID__
-      if (npcType == NPCType::MR_PROG_FIRE) {
-        this->AddLight(new Light(npcPosition, sf::Color(255, 120, 0), 10));
-      }
-#endif
-
 		  lastDirection = randDirection;
 
-		  std::sort(map.begin(), map.end(), InfiniteMap::TileComparitor(this));
       }
     }
   }
@@ -4,6 +4,9 @@
 #include "bnAnimator.h"
 #include "bnAnimation.h"
 
+// NPCs are kept in a ring. The oldest is recycled when all are in use.
+#define INFINITE_MAP_MAX_NPCS 32
+
 namespace Overworld {
   /*! \brief Denotes which NPC to draw */
   enum class NPCType :int {
@@ -19,7 +22,9 @@ namespace Overworld {
   /*! \brief Draw information for NPC */
   struct NPC {
     sf::Sprite sprite;
-    NPCType type;
+    NPCType type{ NPCType::MR_PROG_DOWN };
+    bool active{ false }; /*!< true if the sprite is in the map */
+    Overworld::Light* light{ nullptr }; /*!< light owned by the map while active */
   };
 
   /*! \brief An infinitely generating overworld map
@@ -28,6 +33,9 @@ namespace Overworld {
    *          Not recommended to use for anything more than visual effect.
    * 
    * Uses the Overworld::Map draw steps to reduce code
+   *
+   * Tiles and npcs that scroll behind the camera are recycled so the map
+   * can run indefinitely in a fixed amount of memory.
    */
   class InfiniteMap : public Overworld::Map
   {
@@ -39,7 +47,22 @@ namespace Overworld {
     Animation progAnimations; /*!< mr prog animations to animate */
     Animation numbermanAnimations; /*!< numberman animations to animate */
 
-    std::vector<NPC*> npcs; /*!< list of npcs */
+    std::vector<NPC> npcs; /*!< ring of npcs. Never resized so sprite pointers stay valid */
+    size_t nextNPC; /*!< next slot in the ring to spawn into */
+    size_t liveNPCs; /*!< number of active npcs */
+
+    /**
+     * @brief Takes the next slot in the ring and adds its sprite to the map
+     * @param type
+     * @param pos orthographic position
+     */
+    void SpawnNPC(NPCType type, const sf::Vector2f& pos);
+
+    /**
+     * @brief Removes the npc's sprite and light from the map so the slot can be reused
+     * @param npc
+     */
+    void RecycleNPC(NPC& npc);
 
     public:
     /**
@@ -55,14 +78,13 @@ namespace Overworld {
     virtual ~InfiniteMap();
 
     /**
-     * @brief Moves the tiles based on the camera's movement
-     * @param target
-     * @param states
+     * @brief Number of npcs currently in the map
+     * @return size_t
      */
-    virtual void DrawTiles(sf::RenderTarget& target, sf::RenderStates states) const;
-    
+    const size_t GetNPCCount() const;
+
     /**
-     * @brief Randomly generates an NPC. If the branch depth isn't reach spawn paths.
+     * @brief Recycles tiles and npcs behind the camera. Randomly generates an NPC. If the branch depth isn't reach spawn paths.
      * @param elapsed
      */
     virtual void Update(double elapsed);
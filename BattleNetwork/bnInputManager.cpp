@@ -3,6 +3,7 @@ using sf::Event;
 using sf::Keyboard;
 #include "bnEngine.h"
 #include "bnInputManager.h"
+#include <algorithm>
 
 #if defined(__ANDROID__)
 #include "Android/bnTouchArea.h"
@@ -13,6 +14,12 @@ using sf::Keyboard;
 #define GAMEPAD_1 0
 #define GAMEPAD_1_AXIS_SENSITIVITY 30.f
 
+namespace {
+  thread_local const InputFrame* threadFrame = nullptr; /*!< set by BindThreadFrame() */
+}
+
+static_assert(sizeof(EventTypes::KEYS) / sizeof(EventTypes::KEYS[0]) == INPUT_ACTION_COUNT, "INPUT_ACTION_COUNT must match EventTypes::KEYS");
+
 InputManager& InputManager::GetInstance() {
   static InputManager instance;
   return instance;
@@ -22,6 +29,13 @@ InputManager::InputManager()  : settings() {
   lastkey = sf::Keyboard::Key::Unknown;
   lastButton = (decltype(lastButton))-1;
   lastAxisXPower = axisXPower = lastAxisYPower = axisYPower = 0.f;
+  captureInputBuffer = false;
+  sampleHead = sampleCount = 0;
+  frame = 0;
+
+  for (unsigned i = 0; i < INPUT_ACTION_COUNT; i++) {
+    pressTime[i] = 0;
+  }
 }
 
 
@@ -30,19 +44,39 @@ InputManager::~InputManager() {
 
 void InputManager::SupportConfigSettings(ConfigReader& reader) {
   settings = reader.GetConfigSettings();
-  events.clear();
-  eventsLastFrame.clear();
+  current = InputFrame();
+  previous = InputFrame();
+  deferredRelease.reset();
 }
 
 void InputManager::Update() {
-  this->eventsLastFrame = this->events;
-  this->events.clear();
+  previous = current;
+
+  current = InputFrame();
+  current.frame = ++frame;
+
+  rawPressed.reset();
+  rawReleased.reset();
+  tapped.reset();
+  latencyRead.reset();
+
+  // Taps from last frame release now, before anything polled this frame
+  for (unsigned i = 0; i < INPUT_ACTION_COUNT; i++) {
+    if (deferredRelease[i]) {
+      Sample({ EventTypes::KEYS[i], InputState::RELEASED });
+    }
+  }
+
+  deferredRelease.reset();
 
   Event event;
 
   lastkey = sf::Keyboard::Key::Unknown;
   lastButton = (decltype(lastButton))-1;
 
+  // Keyboard events are ignored while a configured gamepad is connected
+  bool useGamepad = sf::Joystick::isConnected(GAMEPAD_1) && settings.IsOK();
+
   while (ENGINE.GetWindow()->pollEvent(event)) {
     if (event.type == Event::Closed) {
       this->onLoseFocus();
@@ -67,159 +101,152 @@ void InputManager::Update() {
       lastkey = event.key.code;
     }
 
-    for (unsigned int i = 0; i < sf::Joystick::getButtonCount(GAMEPAD_1); i++) {
-      if (sf::Joystick::isButtonPressed(GAMEPAD_1, i)) {
-        lastButton = (decltype(lastButton))i;
-      }
-    }
+    if (useGamepad) continue;
 
-    if (sf::Joystick::isConnected(GAMEPAD_1) && settings.IsOK()) {
-      for (unsigned int i = 0; i < sf::Joystick::getButtonCount(GAMEPAD_1); i++) {
-        if (sf::Joystick::isButtonPressed(GAMEPAD_1, i)) {
-          auto action = settings.GetPairedActions((Gamepad)i);
-
-          for (auto a : action) {
-            events.push_back({ a, InputState::PRESSED });
-          }
-          
-        } else {
-          /*
-          joysticks can only determine if the signal is on or off,
-          we must compare with the last frame to determine if this 
-          was a release event
-          */
-          auto action = settings.GetPairedActions((Gamepad)i);
-
-          for (auto a : action) {
-            bool canRelease = false;
-
-            InputEvent find1 = { a, InputState::HELD };
-            InputEvent find2 = { a, InputState::PRESSED };
-
-            if (find(eventsLastFrame.begin(), eventsLastFrame.end(), find1) != eventsLastFrame.end()) {
-              canRelease = true;
-            }
-            else if (find(eventsLastFrame.begin(), eventsLastFrame.end(), find2) != eventsLastFrame.end()) {
-              canRelease = true;
-            }       
-
-            if (canRelease) {
-              events.push_back({ a, InputState::RELEASED });
-            }
-          }
-        }
-      }
-    } else if (Event::KeyPressed == event.type) {
-      /* Gamepad not connected. Strictly use keyboard events. */
+    if (Event::KeyPressed == event.type) {
       if (settings.IsOK()) {
         auto action = settings.GetPairedActions(event.key.code);
 
         for (auto a : action) {
-          events.push_back({ a, InputState::PRESSED });
+          Sample({ a, InputState::PRESSED });
         }
       } else {
         if (Keyboard::Up == event.key.code) {
-          events.push_back(EventTypes::PRESSED_MOVE_UP);
-          events.push_back(EventTypes::PRESSED_UI_UP);
+          Sample(EventTypes::PRESSED_MOVE_UP);
+          Sample(EventTypes::PRESSED_UI_UP);
         }
         else if (Keyboard::Left == event.key.code) {
-          events.push_back(EventTypes::PRESSED_MOVE_LEFT);
-          events.push_back(EventTypes::PRESSED_UI_LEFT);
+          Sample(EventTypes::PRESSED_MOVE_LEFT);
+          Sample(EventTypes::PRESSED_UI_LEFT);
         }
         else if (Keyboard::Down == event.key.code) {
-          events.push_back(EventTypes::PRESSED_MOVE_DOWN);
-          events.push_back(EventTypes::PRESSED_UI_DOWN);
+          Sample(EventTypes::PRESSED_MOVE_DOWN);
+          Sample(EventTypes::PRESSED_UI_DOWN);
         }
         else if (Keyboard::Right == event.key.code) {
-          events.push_back(EventTypes::PRESSED_MOVE_RIGHT);
-          events.push_back(EventTypes::PRESSED_UI_RIGHT);
+          Sample(EventTypes::PRESSED_MOVE_RIGHT);
+          Sample(EventTypes::PRESSED_UI_RIGHT);
         }
         else if (Keyboard::X == event.key.code) {
-          events.push_back(EventTypes::PRESSED_CONFIRM);
-          events.push_back(EventTypes::PRESSED_USE_CHIP);
+          Sample(EventTypes::PRESSED_CONFIRM);
+          Sample(EventTypes::PRESSED_USE_CHIP);
         }
         else if (Keyboard::Z == event.key.code) {
-          events.push_back(EventTypes::PRESSED_CANCEL);
-          events.push_back(EventTypes::PRESSED_SHOOT);
+          Sample(EventTypes::PRESSED_CANCEL);
+          Sample(EventTypes::PRESSED_SHOOT);
         }
         else if (Keyboard::Space == event.key.code) {
-          events.push_back(EventTypes::PRESSED_CUST_MENU);
-          events.push_back(EventTypes::PRESSED_QUICK_OPT);
+          Sample(EventTypes::PRESSED_CUST_MENU);
+          Sample(EventTypes::PRESSED_QUICK_OPT);
         }
         else if (Keyboard::P == event.key.code) {
-          events.push_back(EventTypes::PRESSED_PAUSE);
+          Sample(EventTypes::PRESSED_PAUSE);
         }
         else if (Keyboard::A == event.key.code) {
-          events.push_back(EventTypes::PRESSED_CUST_MENU);
+          Sample(EventTypes::PRESSED_CUST_MENU);
         }
         else if (Keyboard::S == event.key.code) {
-          events.push_back(EventTypes::PRESSED_SPECIAL);
+          Sample(EventTypes::PRESSED_SPECIAL);
         }
         else if (Keyboard::D == event.key.code) {
-          events.push_back(EventTypes::PRESSED_SCAN_LEFT);
+          Sample(EventTypes::PRESSED_SCAN_LEFT);
         }
         else if (Keyboard::F == event.key.code) {
-          events.push_back(EventTypes::PRESSED_SCAN_RIGHT);
+          Sample(EventTypes::PRESSED_SCAN_RIGHT);
         }
       }
-    } else if (Event::KeyReleased == event.type) {
+    }
+    else if (Event::KeyReleased == event.type) {
       if (settings.IsOK()) {
         auto action = settings.GetPairedActions(event.key.code);
 
-        if (!action.size()) continue;
-
         for (auto a : action) {
-          events.push_back({ a, InputState::RELEASED });
+          Sample({ a, InputState::RELEASED });
         }
       }
       else {
         if (Keyboard::Up == event.key.code) {
-          events.push_back(EventTypes::RELEASED_MOVE_UP);
-          events.push_back(EventTypes::RELEASED_UI_UP);
+          Sample(EventTypes::RELEASED_MOVE_UP);
+          Sample(EventTypes::RELEASED_UI_UP);
         }
         else if (Keyboard::Left == event.key.code) {
-          events.push_back(EventTypes::RELEASED_MOVE_LEFT);
-          events.push_back(EventTypes::RELEASED_UI_LEFT);
+          Sample(EventTypes::RELEASED_MOVE_LEFT);
+          Sample(EventTypes::RELEASED_UI_LEFT);
         }
         else if (Keyboard::Down == event.key.code) {
-          events.push_back(EventTypes::RELEASED_MOVE_DOWN);
-          events.push_back(EventTypes::RELEASED_UI_DOWN);
+          Sample(EventTypes::RELEASED_MOVE_DOWN);
+          Sample(EventTypes::RELEASED_UI_DOWN);
         }
         else if (Keyboard::Right == event.key.code) {
-          events.push_back(EventTypes::RELEASED_MOVE_RIGHT);
-          events.push_back(EventTypes::RELEASED_UI_RIGHT);
+          Sample(EventTypes::RELEASED_MOVE_RIGHT);
+          Sample(EventTypes::RELEASED_UI_RIGHT);
         }
         else if (Keyboard::X == event.key.code) {
-          events.push_back(EventTypes::RELEASED_CONFIRM);
-          events.push_back(EventTypes::RELEASED_USE_CHIP);
+          Sample(EventTypes::RELEASED_CONFIRM);
+          Sample(EventTypes::RELEASED_USE_CHIP);
         }
         else if (Keyboard::Z == event.key.code) {
-          events.push_back(EventTypes::RELEASED_CANCEL);
-          events.push_back(EventTypes::RELEASED_SHOOT);
+          Sample(EventTypes::RELEASED_CANCEL);
+          Sample(EventTypes::RELEASED_SHOOT);
         }
         else if (Keyboard::Space == event.key.code) {
-          events.push_back(EventTypes::RELEASED_CUST_MENU);
-          events.push_back(EventTypes::RELEASED_QUICK_OPT);
+          Sample(EventTypes::RELEASED_CUST_MENU);
+          Sample(EventTypes::RELEASED_QUICK_OPT);
         }
         else if (Keyboard::P == event.key.code) {
-          events.push_back(EventTypes::RELEASED_PAUSE);
+          Sample(EventTypes::RELEASED_PAUSE);
         }
         else if (Keyboard::A == event.key.code) {
-          events.push_back(EventTypes::RELEASED_CUST_MENU);
+          Sample(EventTypes::RELEASED_CUST_MENU);
         }
         else if (Keyboard::S == event.key.code) {
-          events.push_back(EventTypes::RELEASED_SPECIAL);
+          Sample(EventTypes::RELEASED_SPECIAL);
         }
         else if (Keyboard::D == event.key.code) {
-          events.push_back(EventTypes::RELEASED_SCAN_LEFT);
+          Sample(EventTypes::RELEASED_SCAN_LEFT);
         }
         else if (Keyboard::F == event.key.code) {
-          events.push_back(EventTypes::RELEASED_SCAN_RIGHT);
+          Sample(EventTypes::RELEASED_SCAN_RIGHT);
         }
       }
     }
   } // end event poll
 
+  // Poll each gamepad button once per frame
+  unsigned buttonCount = sf::Joystick::getButtonCount(GAMEPAD_1);
+
+  for (unsigned int i = 0; i < buttonCount; i++) {
+    bool down = sf::Joystick::isButtonPressed(GAMEPAD_1, i);
+
+    if (down && !buttonsLastFrame[i]) {
+      lastButton = (decltype(lastButton))i;
+    }
+
+    buttonsLastFrame[i] = down;
+
+    if (!useGamepad) continue;
+
+    auto action = settings.GetPairedActions((Gamepad)i);
+
+    for (auto a : action) {
+      if (down) {
+        Sample({ a, InputState::PRESSED });
+      }
+      else {
+        /*
+        joysticks can only determine if the signal is on or off,
+        we must compare with the last frame to determine if this
+        was a release event
+        */
+        int index = GetActionIndex(a);
+
+        if (index >= 0 && (previous.pressed[index] || previous.held[index])) {
+          Sample({ a, InputState::RELEASED });
+        }
+      }
+    }
+  }
+
   // Check these every frame regardless of input state...
   lastAxisXPower = axisXPower;
   lastAxisYPower = axisYPower;
@@ -243,7 +270,7 @@ void InputManager::Update() {
       auto action = settings.GetPairedActions((Gamepad)lastButton);
 
       for (auto a : action) {
-        events.push_back({ a, InputState::PRESSED });
+        Sample({ a, InputState::PRESSED });
       }
     }
     
@@ -253,7 +280,7 @@ void InputManager::Update() {
       auto action = settings.GetPairedActions((Gamepad)lastButton);
 
       for (auto a : action) {
-        events.push_back({ a, InputState::PRESSED });
+        Sample({ a, InputState::PRESSED });
       }
     }
 
@@ -263,7 +290,7 @@ void InputManager::Update() {
       auto action = settings.GetPairedActions((Gamepad)lastButton);
 
       for (auto a : action) {
-        events.push_back({ a, InputState::PRESSED });
+        Sample({ a, InputState::PRESSED });
       }
     }
 
@@ -273,7 +300,7 @@ void InputManager::Update() {
       auto action = settings.GetPairedActions((Gamepad)lastButton);
 
       for (auto a : action) {
-        events.push_back({ a, InputState::PRESSED });
+        Sample({ a, InputState::PRESSED });
       }
     }
 
@@ -282,7 +309,7 @@ void InputManager::Update() {
         auto action = settings.GetPairedActions(Gamepad::LEFT);
 
         for (auto a : action) {
-          events.push_back({ a, InputState::RELEASED });
+          Sample({ a, InputState::RELEASED });
         }
       }
 
@@ -290,7 +317,7 @@ void InputManager::Update() {
         auto action = settings.GetPairedActions(Gamepad::RIGHT);
 
         for (auto a : action) {
-          events.push_back({ a, InputState::RELEASED });
+          Sample({ a, InputState::RELEASED });
         }
       }
     }
@@ -300,7 +327,7 @@ void InputManager::Update() {
         auto action = settings.GetPairedActions(Gamepad::DOWN);
 
         for (auto a : action) {
-          events.push_back({ a, InputState::RELEASED });
+          Sample({ a, InputState::RELEASED });
         }
       }
 
@@ -308,83 +335,91 @@ void InputManager::Update() {
         auto action = settings.GetPairedActions(Gamepad::UP);
 
         for (auto a : action) {
-          events.push_back({ a, InputState::RELEASED });
+          Sample({ a, InputState::RELEASED });
         }
       }
     }
   }
 
-  // First, we must see if any held keys from the last frame are released this frame
-  for (auto e : events) {
-    if (e.state == InputState::RELEASED) {
-      InputEvent find1 = { e.name, InputState::PRESSED };
-      InputEvent find2 = { e.name, InputState::HELD };
-      auto trunc = std::remove(eventsLastFrame.begin(), eventsLastFrame.end(), find1);
-      eventsLastFrame.erase(trunc, eventsLastFrame.end());
+  ResolveFrame();
 
-      trunc = std::remove(eventsLastFrame.begin(), eventsLastFrame.end(), find2);
-      eventsLastFrame.erase(trunc, eventsLastFrame.end());
+  /*
+  // Uncomment for debugging
+  for (unsigned i = 0; i < INPUT_ACTION_COUNT; i++) {
+    if (current.pressed[i]) Logger::Logf("input event %s, PRESSED", EventTypes::KEYS[i].c_str());
+    if (current.held[i]) Logger::Logf("input event %s, HELD", EventTypes::KEYS[i].c_str());
+    if (current.released[i]) Logger::Logf("input event %s, RELEASED", EventTypes::KEYS[i].c_str());
+  }
+  */
 
-      trunc = std::remove(events.begin(), events.end(), find1);
-      events.erase(trunc, events.end());
+#ifdef __ANDROID__
+    current.pressed.reset(); // TODO: what inputs get stuck in the event list on droid?
+    current.held.reset();
+    current.released.reset();
+    TouchArea::poll();
+#endif
+}
 
-      trunc = std::remove(events.begin(), events.end(), find2);
-      events.erase(trunc, events.end());
-    }
-  }
+void InputManager::Sample(const InputEvent& _event) {
+  int index = GetActionIndex(_event.name);
 
-  // Finally, merge the continuous held key events into the final event buffer
-  for (auto e : eventsLastFrame) {
-    InputEvent insert = EventTypes::NONE;
-    InputEvent erase  = EventTypes::NONE;
+  if (index < 0) return;
 
-      // Search for the held events to migrate into the current event frame
-      // Prevent further events if a key is held
-    if (e.state == HELD) {
-      insert = e;
-      erase = { e.name, PRESSED };
-    }
-   
-    // Search for press keys that have been held and transform them
-    if (e.state == PRESSED) {
-      insert = { e.name, HELD };
-      erase = e;
-    }
-   
-    auto trunc = std::remove(events.begin(), events.end(), erase);
-    events.erase(trunc, events.end());
+  sf::Int64 now = clock.getElapsedTime().asMicroseconds();
 
-    if (insert != EventTypes::NONE && std::find(events.begin(), events.end(), insert) == events.end()) {
-      events.push_back(insert); // migrate this input
+  if (_event.state == InputState::PRESSED) {
+    if (!rawPressed[index]) {
+      pressTime[index] = now;
     }
-  }
-  
-  /*
-  // Uncomment for debugging
-  for (auto e : events) {
-    std::string state = "NONE";
 
-    switch (e.state) {
-    case InputState::HELD:
-      state = "HELD";
-      break;
-    case InputState::RELEASED:
-      state = "RELEASED";
-      break;
-    case InputState::PRESSED:
-      state = "PRESSED";
-      break;
+    rawPressed[index] = true;
+  }
+  else if (_event.state == InputState::RELEASED) {
+    if (rawPressed[index]) {
+      tapped[index] = true;
     }
-    Logger::Logf("input event %s, %s", e.name.c_str(), state.c_str());
+
+    rawReleased[index] = true;
+  }
+  else {
+    return;
   }
-  */
 
-  eventsLastFrame.clear();
+  Record((unsigned)index, _event.state, now);
+}
 
-#ifdef __ANDROID__
-    events.clear(); // TODO: what inputs get stuck in the event list on droid?
-    TouchArea::poll();
-#endif
+void InputManager::Record(unsigned action, InputState state, sf::Int64 microseconds) {
+  InputSample& sample = samples[sampleHead];
+  sample.action = action;
+  sample.state = state;
+  sample.frame = frame;
+  sample.microseconds = microseconds;
+
+  sampleHead = (sampleHead + 1) % INPUT_SAMPLE_RING_SIZE;
+  sampleCount = std::min(sampleCount + 1, (size_t)INPUT_SAMPLE_RING_SIZE);
+}
+
+void InputManager::ResolveFrame() {
+  for (unsigned i = 0; i < INPUT_ACTION_COUNT; i++) {
+    bool wasDown = previous.pressed[i] || previous.held[i];
+
+    if (rawReleased[i]) {
+      if (tapped[i] && !wasDown) {
+        // Pressed and released between two frames. Keep the press visible for one frame.
+        current.pressed[i] = true;
+        deferredRelease[i] = true;
+      }
+      else {
+        current.released[i] = true;
+      }
+    }
+    else if (wasDown) {
+      current.held[i] = true;
+    }
+    else if (rawPressed[i]) {
+      current.pressed[i] = true;
+    }
+  }
 }
 
 sf::Keyboard::Key InputManager::GetAnyKey()
@@ -528,11 +563,117 @@ const bool InputManager::ConvertKeyToString(const sf::Keyboard::Key key, std::st
 }
 
 bool InputManager::Has(InputEvent _event) {
-  return events.end() != find(events.begin(), events.end(), _event);
+  int index = GetActionIndex(_event.name);
+
+  if (index < 0) return false;
+
+  if (threadFrame) {
+    switch (_event.state) {
+    case InputState::PRESSED:
+      return threadFrame->pressed[index];
+    case InputState::HELD:
+      return threadFrame->held[index];
+    case InputState::RELEASED:
+      return threadFrame->released[index];
+    }
+
+    return false;
+  }
+
+  switch (_event.state) {
+  case InputState::PRESSED:
+    if (!current.pressed[index]) return false;
+
+    if (!latencyRead[index]) {
+      latencyRead[index] = true;
+
+      latency.lastMicroseconds = clock.getElapsedTime().asMicroseconds() - pressTime[index];
+      latency.maxMicroseconds = std::max(latency.maxMicroseconds, latency.lastMicroseconds);
+      latency.totalMicroseconds += latency.lastMicroseconds;
+      latency.count++;
+    }
+
+    return true;
+  case InputState::HELD:
+    return current.held[index];
+  case InputState::RELEASED:
+    return current.released[index];
+  }
+
+  return false;
+}
+
+const InputFrame& InputManager::GetFrameState() const {
+  return current;
+}
+
+void InputManager::OverrideFrame(const InputFrame& state) {
+  current.pressed = state.pressed;
+  current.held = state.held;
+  current.released = state.released;
+}
+
+void InputManager::BindThreadFrame(const InputFrame* state) {
+  threadFrame = state;
+}
+
+const unsigned InputManager::GetFrame() const {
+  return frame;
+}
+
+const size_t InputManager::GetSampleCount() const {
+  return sampleCount;
+}
+
+const InputSample& InputManager::GetSample(size_t age) const {
+  if (sampleCount == 0) return samples[0];
+
+  age = std::min(age, sampleCount - 1);
+  return samples[(sampleHead + INPUT_SAMPLE_RING_SIZE - 1 - age) % INPUT_SAMPLE_RING_SIZE];
+}
+
+const InputLatencyStats InputManager::GetLatencyStats() const {
+  return latency;
+}
+
+int InputManager::GetActionIndex(const std::string& name) {
+  // Built once on first use. Static initialization is thread safe and server workers look actions up at the same time.
+  static const std::unordered_map<std::string, int> indices = []() {
+    std::unordered_map<std::string, int> result;
+
+    for (int i = 0; i < INPUT_ACTION_COUNT; i++) {
+      result[EventTypes::KEYS[i]] = i;
+    }
+
+    return result;
+  }();
+
+  auto iter = indices.find(name);
+
+  return (iter == indices.end()) ? -1 : iter->second;
 }
 
 void InputManager::VirtualKeyEvent(InputEvent event) {
-  events.push_back(event);
+  int index = GetActionIndex(event.name);
+
+  if (index < 0) return;
+
+  switch (event.state) {
+  case InputState::PRESSED:
+    current.pressed[index] = true;
+    pressTime[index] = clock.getElapsedTime().asMicroseconds();
+    break;
+  case InputState::HELD:
+    current.held[index] = true;
+    break;
+  case InputState::RELEASED:
+    current.released[index] = true;
+    break;
+  default:
+    return;
+  }
+
+  Record((unsigned)index, event.state, clock.getElapsedTime().asMicroseconds());
 }
 
 void InputManager::BindRegainFocusEvent(std::function<void()> callback)
@@ -561,7 +702,7 @@ ConfigSettings InputManager::GetConfigSettings()
 }
 
 bool InputManager::Empty() {
-  return events.empty();
+  return current.pressed.none() && current.held.none() && current.released.none();
 }
 
 bool InputManager::IsConfigFileValid()
@@ -2,7 +2,11 @@
 #include <vector>
 #include <map>
 #include <functional>
+#include <bitset>
+#include <unordered_map>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/Joystick.hpp>
+#include <SFML/System/Clock.hpp>
 
 using std::map;
 using std::vector;
@@ -15,6 +19,34 @@ using std::vector;
 using std::map;
 using std::vector;
 
+// One bit per entry in EventTypes::KEYS
+#define INPUT_ACTION_COUNT 18
+
+// Number of raw input samples kept for inspection
+#define INPUT_SAMPLE_RING_SIZE 256
+
+/*! \brief One raw press or release as it was polled */
+struct InputSample {
+  unsigned action{ 0 }; /*!< index into EventTypes::KEYS */
+  InputState state{ InputState::NONE }; /*!< PRESSED or RELEASED */
+  unsigned frame{ 0 }; /*!< simulation frame the sample applies to */
+  sf::Int64 microseconds{ 0 }; /*!< when the sample was polled */
+};
+
+/*! \brief The resolved state of every action for one simulation frame */
+struct InputFrame {
+  unsigned frame{ 0 };
+  std::bitset<INPUT_ACTION_COUNT> pressed, held, released;
+};
+
+/*! \brief Time between an action being polled and the game first reading it */
+struct InputLatencyStats {
+  unsigned count{ 0 };
+  sf::Int64 lastMicroseconds{ 0 };
+  sf::Int64 maxMicroseconds{ 0 };
+  sf::Int64 totalMicroseconds{ 0 };
+};
+
 /**
  * @class InputManager
  * @author mav
@@ -41,9 +73,11 @@ public:
    * This is achieved through the configuration object that maps actions to paired
    * buttons.
    * 
-   * Before this function ends, it will scan for any release events. If they are found,
-   * they are cleared from the event list. If no release is found but a press is present,
-   * the button state is transformed into a HELD state equivalent.
+   * Raw presses and releases are written to a sample ring tagged with the
+   * simulation frame they apply to. They are then resolved into one bitset per
+   * state. A press that was held last frame becomes HELD. A release clears any press.
+   * A press and release polled in the same frame count as a press this frame and a
+   * release next frame so that taps are never lost.
    */
   void Update();
 
@@ -54,10 +88,66 @@ public:
 
   /**
    * @brief Queries if an input event has been fired
+   *
+   * The first time a press is read, the time since it was polled is recorded.
    * @param _event the event to look for.
    * @return true if present, false otherwise
    */
   bool Has(InputEvent _event);
+
+  /**
+   * @brief The resolved state of all actions this frame
+   * @return const InputFrame&
+   */
+  const InputFrame& GetFrameState() const;
+
+  /**
+   * @brief Replaces this frame's resolved state. Used to play back recorded input.
+   *
+   * Call after Update(). The override lasts until the next Update().
+   * @param state pressed, held, and released bits to use
+   */
+  void OverrideFrame(const InputFrame& state);
+
+  /**
+   * @brief Has() on the calling thread reads this frame instead of the shared state
+   *
+   * Used by battles running off the main thread. Latency is not recorded for bound frames.
+   * @param state frame owned by the caller, or null to unbind
+   */
+  static void BindThreadFrame(const InputFrame* state);
+
+  /**
+   * @brief Simulation frame the current state applies to. Increments every Update()
+   * @return unsigned
+   */
+  const unsigned GetFrame() const;
+
+  /**
+   * @brief Number of raw samples in the ring
+   * @return size_t
+   */
+  const size_t GetSampleCount() const;
+
+  /**
+   * @brief Read a raw sample from the ring
+   * @param age 0 is the newest sample
+   * @return const InputSample&
+   */
+  const InputSample& GetSample(size_t age) const;
+
+  /**
+   * @brief Time from polling a press to the game first reading it
+   * @return InputLatencyStats
+   */
+  const InputLatencyStats GetLatencyStats() const;
+
+  /**
+   * @brief Index of the action name in EventTypes::KEYS
+   * @param name action name
+   * @return index or -1 if the name is not an action
+   */
+  static int GetActionIndex(const std::string& name);
   
   /**
    * @brief Checks if the input event list is empty
@@ -157,8 +247,41 @@ private:
    */
   InputManager();
   
-  vector<InputEvent> events; /*!< Current event list */
-  vector<InputEvent> eventsLastFrame; /*!< The even list prior to this update */
+  /**
+   * @brief Records a raw press or release for the frame being built
+   * @param _event event with PRESSED or RELEASED state
+   */
+  void Sample(const InputEvent& _event);
+
+  /**
+   * @brief Writes a sample to the ring
+   */
+  void Record(unsigned action, InputState state, sf::Int64 microseconds);
+
+  /**
+   * @brief Turns this frame's raw samples into pressed, held, and released bits
+   */
+  void ResolveFrame();
+
+  InputFrame current; /*!< Resolved state this frame */
+  InputFrame previous; /*!< Resolved state last frame */
+
+  std::bitset<INPUT_ACTION_COUNT> rawPressed; /*!< Actions pressed while polling this frame */
+  std::bitset<INPUT_ACTION_COUNT> rawReleased; /*!< Actions released while polling this frame */
+  std::bitset<INPUT_ACTION_COUNT> tapped; /*!< Actions released after being pressed in the same poll */
+  std::bitset<INPUT_ACTION_COUNT> deferredRelease; /*!< Taps that release on the next frame */
+  std::bitset<INPUT_ACTION_COUNT> latencyRead; /*!< Presses whose latency was recorded */
+  std::bitset<sf::Joystick::ButtonCount> buttonsLastFrame; /*!< Gamepad buttons down last frame */
+
+  sf::Int64 pressTime[INPUT_ACTION_COUNT]; /*!< When each action was last pressed */
+
+  InputSample samples[INPUT_SAMPLE_RING_SIZE]; /*!< Ring of raw samples */
+  size_t sampleHead; /*!< Next slot to write */
+  size_t sampleCount; /*!< Samples written, capped at the ring size */
+
+  unsigned frame; /*!< Simulation frame being built */
+  sf::Clock clock; /*!< Timestamps samples */
+  InputLatencyStats latency;
 
   map<InputEvent, std::string> input; /*!< Maps controller events*/
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include "bnTraitState.h"
 
 using namespace std;
 
@@ -9,6 +11,11 @@ class InstanceCountingTrait {
 protected:
 
   InstanceCountingTrait() {
+    if (!registered) {
+      registered = true;
+      TraitState::Register(&ResetCountedList);
+    }
+
     myCounterID = (long)IDs.size();
     IDs.push_back(myCounterID);
   };
@@ -38,13 +45,22 @@ protected:
   }
 
 private:
-  static vector<long> IDs; /*!< list of types spawned to take turns */
-  static int currIndex; /*!< current active entity ID */
+  static void ResetCountedList() {
+    IDs.clear();
+    currIndex = 0;
+  }
+
+  static thread_local vector<long> IDs; /*!< list of types spawned to take turns */
+  static thread_local int currIndex; /*!< current active entity ID */
+  static thread_local bool registered; /*!< reset registered with TraitState on this thread */
   long myCounterID; /*!< This entity's counter ID */
 };
 
-template<typename T> vector<long>
+template<typename T> thread_local vector<long>
   InstanceCountingTrait<T>::IDs = vector<long>();
 
-  template<typename T> int
+  template<typename T> thread_local int
     InstanceCountingTrait<T>::currIndex = 0;
+
+  template<typename T> thread_local bool
+    InstanceCountingTrait<T>::registered = false;
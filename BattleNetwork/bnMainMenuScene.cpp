@@ -23,6 +23,9 @@ MainMenuScene::MainMenuScene(swoosh::ActivityController& controller) :
   // before proceeding to next sub menus
   data = ChipFolderCollection::ReadFromFile("resources/database/folders.txt");
 
+  // Open the overworld theme in the background while the title screen segues
+  AUDIO.PrefetchStream("resources/loops/loop_overworld.ogg");
+
   // Draws the scrolling background
   bg = new LanBackground();
 
@@ -73,9 +76,8 @@ MainMenuScene::MainMenuScene(swoosh::ActivityController& controller) :
 }
 
 void MainMenuScene::onStart() {
-  // Stop any music already playing
-  AUDIO.StopStream();
-  AUDIO.Stream("resources/loops/loop_overworld.ogg", false);
+  // Fade out any music already playing
+  AUDIO.Stream("resources/loops/loop_overworld.ogg", false, sf::Music::TimeSpan(), 0.5f);
   
   // Set the camera back to ours
   ENGINE.SetCamera(camera);
@@ -0,0 +1,115 @@
+#include "bnMappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif !defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <SFML/System/FileInputStream.hpp>
+#endif
+
+MappedFile::MappedFile() : data(nullptr), size(0) {
+#ifdef _WIN32
+  file = mapping = nullptr;
+#endif
+}
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+const bool MappedFile::Open(const std::string& path) {
+  Close();
+
+#if defined(_WIN32)
+  HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (handle == INVALID_HANDLE_VALUE) return false;
+
+  LARGE_INTEGER length;
+
+  if (!GetFileSizeEx(handle, &length) || length.QuadPart == 0) {
+    CloseHandle(handle);
+    return false;
+  }
+
+  HANDLE view = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (!view) {
+    CloseHandle(handle);
+    return false;
+  }
+
+  file = handle;
+  mapping = view;
+  data = static_cast<const char*>(MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0));
+  size = (size_t)length.QuadPart;
+#elif !defined(__ANDROID__)
+  int fd = ::open(path.c_str(), O_RDONLY);
+
+  if (fd < 0) return false;
+
+  struct stat info;
+
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping keeps the file alive on its own
+  ::close(fd);
+
+  if (view == MAP_FAILED) return false;
+
+  data = static_cast<const char*>(view);
+  size = (size_t)info.st_size;
+#else
+  sf::FileInputStream in;
+
+  if (!in.open(path) || in.getSize() <= 0) return false;
+
+  buffer.resize((size_t)in.getSize());
+  in.read(buffer.data(), (sf::Int64)buffer.size());
+
+  data = buffer.data();
+  size = buffer.size();
+#endif
+
+  if (!data) {
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void MappedFile::Close() {
+#if defined(_WIN32)
+  if (data) UnmapViewOfFile(data);
+  if (mapping) CloseHandle((HANDLE)mapping);
+  if (file) CloseHandle((HANDLE)file);
+  file = mapping = nullptr;
+#elif !defined(__ANDROID__)
+  if (data) munmap(const_cast<char*>(data), size);
+#else
+  buffer.clear();
+#endif
+
+  data = nullptr;
+  size = 0;
+}
+
+const char* MappedFile::GetData() const {
+  return data;
+}
+
+const size_t MappedFile::GetSize() const {
+  return size;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/**
+ * @class MappedFile
+ * @author mav
+ * @date 10/19/20
+ * @brief Read-only view of a whole file that is memory mapped where the platform allows
+ *
+ * Pages are read by the OS as they are touched, so nothing is copied into the heap.
+ * On Android files live inside the APK and are read into a buffer instead.
+ */
+class MappedFile {
+public:
+  MappedFile();
+
+  /**
+   * @brief Unmaps the file if still open
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile& rhs) = delete;
+  MappedFile& operator=(const MappedFile& rhs) = delete;
+
+  /**
+   * @brief Map the file at path. Closes any file that was open.
+   * @param path relative path from application to file
+   * @return true if the file is open and not empty
+   */
+  const bool Open(const std::string& path);
+
+  void Close();
+
+  /**
+   * @brief First byte of the file or nullptr if nothing is open
+   */
+  const char* GetData() const;
+
+  const size_t GetSize() const;
+
+private:
+  const char* data;
+  size_t size;
+  std::vector<char> buffer; /*!< used when the file cannot be mapped */
+
+#ifdef _WIN32
+  void* file; /*!< HANDLE */
+  void* mapping; /*!< HANDLE */
+#endif
+};
@@ -77,3 +77,13 @@ bool Megalian::CanMoveTo(Battle::Tile * next)
 {
   return true;
 }
+
+void Megalian::SaveState(BattleSnapshot& snapshot) const{
+  AI<Megalian>::SaveAI(snapshot);
+  Character::SaveState(snapshot);
+}
+
+void Megalian::LoadState(BattleSnapshot& snapshot){
+  AI<Megalian>::LoadAI(snapshot);
+  Character::LoadState(snapshot);
+}
@@ -10,6 +10,7 @@
 #include "bnTextureResourceManager.h"
 #include "bnDefenseAura.h"
 #include <Swoosh/Ease.h>
+#include "bnBattleContext.h"
 
 /*! \brief Megalian enemy is composed of two characters: one deals damage and propogates all damage, and the other controls the whole */
 class Megalian : public Character, public AI<Megalian> {
@@ -115,8 +116,8 @@ private:
           int y = 0;
 
           while (!nextTile) {
-            x = (rand() % 3) + 4;
-            y = (rand() % 3) + 1;
+            x = (BattleContext::Rand() % 3) + 4;
+            y = (BattleContext::Rand() % 3) + 1;
 
             nextTile = GetField()->GetAt(x, y);
 
@@ -229,6 +230,18 @@ public:
    */
   virtual const float GetHeight() const;
 
+  /**
+   * @brief Saves the AI and then the character
+   * @param snapshot
+   */
+  virtual void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back the state written by SaveState()
+   * @param snapshot
+   */
+  virtual void LoadState(BattleSnapshot& snapshot);
+
   const bool HasAura();
 
   virtual bool CanMoveTo(Battle::Tile* next);
@@ -1,6 +1,7 @@
 #include "bnMegalianIdleState.h"
 #include "bnTile.h"
 #include "bnField.h"
+#include "bnBattleSnapshot.h"
 
 MegalianIdleState::MegalianIdleState() : AIState<Megalian>() { ; }
 MegalianIdleState::~MegalianIdleState() { ; }
@@ -15,3 +16,10 @@ void MegalianIdleState::OnUpdate(float _elapsed, Megalian& m) {
 void MegalianIdleState::OnLeave(Megalian& m) {
 }
 
+void MegalianIdleState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(cooldown);
+}
+
+void MegalianIdleState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(cooldown);
+}
@@ -38,5 +38,17 @@ public:
    * @param met
    */
   void OnLeave(Megalian& m);
+
+  /**
+   * @brief Writes the state's timers and flags
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back what SaveState() wrote
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
 };
 
@@ -9,10 +9,8 @@
 
 Megaman::Megaman() : Player() {
 
-  auto base_palette = TEXTURES.LoadTextureFromFile("resources/navis/megaman/forms/base.palette.png");
-  PaletteSwap* pswap = new PaletteSwap(this, *base_palette);
+  PaletteSwap* pswap = new PaletteSwap(this, "resources/navis/megaman/forms/base.palette.png");
   RegisterComponent(pswap);
-  delete base_palette;
 
   SetHealth(900);
   SetName("Megaman");
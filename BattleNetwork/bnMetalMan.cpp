@@ -12,6 +12,7 @@
 #include "bnMetalManThrowState.h"
 #include "bnObstacle.h"
 #include "bnHitbox.h"
+#include "bnBattleContext.h"
 
 #define RESOURCE_PATH "resources/mobs/metalman/metalman.animation"
 
@@ -100,7 +101,7 @@ bool MetalMan::CanMoveTo(Battle::Tile * next)
 void MetalMan::OnUpdate(float _elapsed) {
   // TODO: use StuntDoubles to circumvent teleportaton
   if (movedByStun) { 
-    this->Teleport((rand() % 3) + 4, (rand() % 3) + 1); 
+    this->Teleport((BattleContext::Rand() % 3) + 4, (BattleContext::Rand() % 3) + 1); 
     this->AdoptNextTile(); 
     this->FinishMove();
     movedByStun = false; 
@@ -2,6 +2,7 @@
 #include "bnMetalMan.h"
 #include "bnMissile.h"
 #include "bnField.h"
+#include "bnBattleContext.h"
 
 MetalManMissileState::MetalManMissileState(int missiles) : cooldown(0.8f), missiles(missiles), AIState<MetalMan>()
 {
@@ -43,7 +44,7 @@ void MetalManMissileState::OnUpdate(float _elapsed, MetalMan& metal) {
     if(metal.GetTarget() && metal.GetTarget()->GetTile()) {
         auto tile = metal.GetTarget()->GetTile();
         if(missileIndex % 2 == 0) {
-            tile = metal.GetField()->GetAt(1 + (rand() % 3), 1 + (rand() % 3));
+            tile = metal.GetField()->GetAt(1 + (BattleContext::Rand() % 3), 1 + (BattleContext::Rand() % 3));
         }
 
         auto missile = new Missile(metal.GetField(), metal.GetTeam(), tile, 0.4f);
@@ -7,6 +7,7 @@
 #include "bnMetalManPunchState.h"
 #include "bnMetalManThrowState.h"
 #include "bnMetalManMissileState.h"
+#include "bnBattleContext.h"
 
 MetalManMoveState::MetalManMoveState() : isMoving(false), AIState<MetalMan>() { ; }
 MetalManMoveState::~MetalManMoveState() { ; }
@@ -28,7 +29,7 @@ void MetalManMoveState::OnUpdate(float _elapsed, MetalMan& metal) {
 
   do {
     // Find a new spot that is on our team
-    moved = metal.Teleport((rand() % 6) + 1, (rand() % 3) + 1);
+    moved = metal.Teleport((BattleContext::Rand() % 6) + 1, (BattleContext::Rand() % 3) + 1);
     tries--;
   } while ((!moved || metal.GetNextTile()->GetTeam() != metal.GetTeam()) && tries > 0);
 
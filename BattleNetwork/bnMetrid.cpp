@@ -54,6 +54,8 @@ Metrid::Metrid(Rank _rank)
 }
 
 Metrid::~Metrid() {
+  // Metrids removed without being deleted would keep their turn forever
+  this->RemoveMeFromTurnOrder();
 }
 
 void Metrid::OnDelete() {
@@ -78,4 +80,14 @@ const bool Metrid::OnHit(const Hit::Properties props) {
 
 const float Metrid::GetHeight() const {
   return hitHeight;
-}
\ No newline at end of file
+}
+
+void Metrid::SaveState(BattleSnapshot& snapshot) const{
+  AI<Metrid>::SaveAI(snapshot);
+  Character::SaveState(snapshot);
+}
+
+void Metrid::LoadState(BattleSnapshot& snapshot){
+  AI<Metrid>::LoadAI(snapshot);
+  Character::LoadState(snapshot);
+}
@@ -44,6 +44,18 @@ public:
    */
   const float GetHeight() const;
 
+  /**
+   * @brief Saves the AI and then the character
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back the state written by SaveState()
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
+
 private:
 
   float hitHeight; /*!< hit height of this entity */
@@ -5,6 +5,7 @@
 #include "bnMetrid.h"
 #include "bnMetridIdleState.h"
 #include "bnAnimationComponent.h"
+#include "bnBattleSnapshot.h"
 
 MetridAttackState::MetridAttackState() : AIState<Metrid>() { meteorCooldown = 0; meteorCount = 5; beginAttack = false; }
 MetridAttackState::~MetridAttackState() { ; }
@@ -109,3 +110,17 @@ void MetridAttackState::DoAttack(Metrid& met) {
     met.GetField()->AddEntity(*meteor, target->GetX(),target->GetY());
   }
 }
+
+void MetridAttackState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(meteorCount);
+  snapshot.Write(meteorCooldown);
+  snapshot.Write(beginAttack);
+  snapshot.Write(target);
+}
+
+void MetridAttackState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(meteorCount);
+  snapshot.Read(meteorCooldown);
+  snapshot.Read(beginAttack);
+  snapshot.Read(target);
+}
@@ -48,6 +48,18 @@ public:
    */
   void OnLeave(Metrid& met);
 
+  /**
+   * @brief Writes the state's timers and flags
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back what SaveState() wrote
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
+
   /**
    * @brief animates before spawning a series of meteors
    * @param met
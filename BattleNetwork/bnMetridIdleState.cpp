@@ -9,6 +9,7 @@
 #endif
 
 #include "bnAnimationComponent.h"
+#include "bnBattleSnapshot.h"
 #include <iostream>
 
 MetridIdleState::MetridIdleState() : cooldown(1), AIState<Metrid>() { ; }
@@ -41,3 +42,10 @@ void MetridIdleState::OnUpdate(float _elapsed, Metrid& met) {
 void MetridIdleState::OnLeave(Metrid& met) {
 }
 
+void MetridIdleState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(cooldown);
+}
+
+void MetridIdleState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(cooldown);
+}
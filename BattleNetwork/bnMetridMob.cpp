@@ -5,6 +5,7 @@
 #include "bnTile.h"
 #include "bnSpawnPolicy.h"
 #include "bnChipsSpawnPolicy.h"
+#include "bnBattleContext.h"
 
 MetridMob::MetridMob(Field* field) : MobFactory(field)
 {
@@ -16,7 +17,7 @@ MetridMob::~MetridMob()
 }
 
 Mob* MetridMob::Build() {
-  int mobType = rand() % 3; 
+  int mobType = BattleContext::Rand() % 3; 
 
   // 0 - metrid and cannodumb
   // 1 - 2 metrid and cannodumb of higher types
@@ -60,11 +61,11 @@ Mob* MetridMob::Build() {
     }
   }
 
-  Battle::Tile* tile = field->GetAt(1, (rand()%3)+1);
+  Battle::Tile* tile = field->GetAt(1, (BattleContext::Rand()%3)+1);
   tile->SetState(TileState::EMPTY);
 
-  if (rand() % 10 < 5) {
-    Battle::Tile* tile = field->GetAt(3, (rand() % 3) + 1);
+  if (BattleContext::Rand() % 10 < 5) {
+    Battle::Tile* tile = field->GetAt(3, (BattleContext::Rand() % 3) + 1);
     tile->SetState(TileState::EMPTY);
   }
 
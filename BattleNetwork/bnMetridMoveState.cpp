@@ -5,6 +5,8 @@
 #include "bnMobMoveEffect.h"
 #include "bnAnimationComponent.h"
 #include "bnMetridAttackState.h"
+#include "bnBattleContext.h"
+#include "bnBattleSnapshot.h"
 
 MetridMoveState::MetridMoveState() : isMoving(false), moveCount(5), cooldown(1), AIState<Metrid>() { ; }
 MetridMoveState::~MetridMoveState() { ; }
@@ -35,7 +37,10 @@ void MetridMoveState::OnUpdate(float _elapsed, Metrid& met) {
     return met.ChangeState<MetridAttackState>();
   }
 
-  auto myteam = met.GetField()->FindTiles([&met](Battle::Tile* t) {
+  // Reused between moves so picking a tile does not allocate
+  static thread_local std::vector<Battle::Tile*> myteam;
+
+  met.GetField()->FindTiles(myteam, [&met](Battle::Tile* t) {
     if (t->GetTeam() == met.GetTeam() && t->IsWalkable())
       return true;
 
@@ -46,7 +51,7 @@ void MetridMoveState::OnUpdate(float _elapsed, Metrid& met) {
   int teley = 0;
 
   if (myteam.size() > 0) {
-      int randIndex = rand() % myteam.size();
+      int randIndex = BattleContext::Rand() % myteam.size();
       telex = myteam[randIndex]->GetX();
       teley = myteam[randIndex]->GetY();
   }
@@ -80,3 +85,14 @@ void MetridMoveState::OnLeave(Metrid& met) {
 
 }
 
+void MetridMoveState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(isMoving);
+  snapshot.Write(moveCount);
+  snapshot.Write(cooldown);
+}
+
+void MetridMoveState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(isMoving);
+  snapshot.Read(moveCount);
+  snapshot.Read(cooldown);
+}
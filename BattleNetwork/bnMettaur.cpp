@@ -47,6 +47,8 @@ Mettaur::Mettaur(Rank _rank)
 }
 
 Mettaur::~Mettaur() {
+  // Mettaurs removed without being deleted would keep their turn forever
+  this->RemoveMeFromTurnOrder();
 }
 
 void Mettaur::OnDelete() {
@@ -73,4 +75,14 @@ const bool Mettaur::OnHit(const Hit::Properties props) {
 
 const float Mettaur::GetHeight() const {
   return hitHeight;
-}
\ No newline at end of file
+}
+
+void Mettaur::SaveState(BattleSnapshot& snapshot) const{
+  AI<Mettaur>::SaveAI(snapshot);
+  AnimatedCharacter::SaveState(snapshot);
+}
+
+void Mettaur::LoadState(BattleSnapshot& snapshot){
+  AI<Mettaur>::LoadAI(snapshot);
+  AnimatedCharacter::LoadState(snapshot);
+}
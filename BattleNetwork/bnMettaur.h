@@ -47,6 +47,18 @@ public:
    */
   virtual const float GetHeight() const;
 
+  /**
+   * @brief Saves the AI and then the character
+   * @param snapshot
+   */
+  virtual void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back the state written by SaveState()
+   * @param snapshot
+   */
+  virtual void LoadState(BattleSnapshot& snapshot);
+
 private:
 
   float hitHeight; /*!< hit height of this mettaur */
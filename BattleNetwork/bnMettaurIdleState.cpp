@@ -1,5 +1,6 @@
 #include "bnMettaurIdleState.h"
 #include "bnMettaurMoveState.h"
+#include "bnBattleSnapshot.h"
 #include <iostream>
 
 MettaurIdleState::MettaurIdleState() : cooldown(0.5), AIState<Mettaur>() { ; }
@@ -32,3 +33,10 @@ void MettaurIdleState::OnUpdate(float _elapsed, Mettaur& met) {
 void MettaurIdleState::OnLeave(Mettaur& met) {
 }
 
+void MettaurIdleState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(cooldown);
+}
+
+void MettaurIdleState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(cooldown);
+}
@@ -4,6 +4,7 @@
 #include "bnField.h"
 #include "bnMettaurAttackState.h"
 #include "bnMettaurIdleState.h"
+#include "bnBattleSnapshot.h"
 
 MettaurMoveState::MettaurMoveState() : isMoving(false), AIState<Mettaur>() { ; }
 MettaurMoveState::~MettaurMoveState() { ; }
@@ -61,3 +62,12 @@ void MettaurMoveState::OnLeave(Mettaur& met) {
 
 }
 
+void MettaurMoveState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(nextDirection);
+  snapshot.Write(isMoving);
+}
+
+void MettaurMoveState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(nextDirection);
+  snapshot.Read(isMoving);
+}
@@ -11,6 +11,8 @@
 /*! \brief Manages spawning and deleting the enemy mob and delivers a reward based on rank */
 class Mob
 {
+  friend class BattleSnapshot;
+
 public:
   /*! \brief Spawn info data object */
   struct MobData {
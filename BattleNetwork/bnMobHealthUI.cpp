@@ -1,6 +1,3 @@
-#include <string>
-using std::to_string;
-
 #include <Swoosh/Game.h>
 #include "bnBattleScene.h"
 #include "bnMobHealthUI.h"
@@ -9,12 +6,15 @@ using std::to_string;
 #include "bnLogger.h"
 
 MobHealthUI::MobHealthUI(Character* _mob)
-  : mob(_mob), UIComponent(_mob) {
+  : mob(_mob), UIComponent(_mob),
+  // Glyphs are 8x10. First glyph is 9 the last is 0. There's 1px space between the glyphs
+  glyphs(LOAD_TEXTURE(ENEMY_HP_NUMSET), sf::Vector2i(8, 10), sf::Vector2i(0, 99), sf::Vector2i(0, -11)) {
   healthCounter = mob->GetHealth();
   cooldown = 0;
   color = sf::Color::White;
-  glyphs.setTexture(LOAD_TEXTURE(ENEMY_HP_NUMSET));
   glyphs.setScale(2.f, 2.f);
+  glyphs.SetAlignment(GlyphNumber::Alignment::CENTER);
+  glyphs.SetNumber(healthCounter);
 }
 
 MobHealthUI::~MobHealthUI() {
@@ -71,6 +71,9 @@ void MobHealthUI::OnUpdate(float elapsed) {
     }
 
     if (healthCounter < 0 || mob->GetHealth() <= 0) { healthCounter = 0; }
+
+    glyphs.SetNumber(healthCounter);
+    glyphs.SetColor(color);
   }
 }
 
@@ -86,34 +89,9 @@ void MobHealthUI::draw(sf::RenderTarget & target, sf::RenderStates states) const
   auto this_states = states;
   this_states.transform *= this->getTransform();
 
-  // Glyphs are 8x10
-  // First glyph is 9 the last is 0
-  // There's 1px space between the glyphs
-
-  if (healthCounter > 0 && mob->GetTile()) {
-    int size = (int)(std::to_string(healthCounter).size());
-    int hp = healthCounter;
-    float offsetx = -(((size)*8.0f) / 2.0f)*glyphs.getScale().x;
-    int index = 0;
-    while (index < size) {
-      auto str = std::to_string(healthCounter);
-      auto substr = str.substr(index, 1);
-      const char* cc = substr.c_str();
-      int number = std::atoi(cc);
-
-      int row = (10-number-1);
-      int rowStart = row + (row * 10);
-
-      glyphs.setTextureRect(sf::IntRect(0, rowStart, 8, 10));
-      glyphs.setPosition(sf::Vector2f(offsetx, 0.0f) + this->mob->GetTile()->getPosition());
-      glyphs.setColor(this->color);
-
-      target.draw(glyphs, this_states);
-      //ENGINE.Draw(font);
-
-      offsetx += 8.0f*glyphs.getScale().x;
-      index++;
-    }
+  if (healthCounter > 0 && mob && mob->GetTile()) {
+    glyphs.setPosition(this->mob->GetTile()->getPosition());
+    target.draw(glyphs, this_states);
   }
 
   UIComponent::draw(target, states);
@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "bnUIComponent.h"
+#include "bnGlyphNumber.h"
 using sf::Font;
 using sf::Text;
 class Character;
@@ -45,7 +46,7 @@ public:
 private:
   Character * mob; /*!< Owner of health */
   sf::Color color; /*!< Color of the glyphs */
-  mutable sf::Sprite glyphs; /*!< Drawable texture */
+  mutable GlyphNumber glyphs; /*!< Health digits. Laid out again only when health or color changes */
   int healthCounter; /*!< mob's current health */
   double cooldown; /*!< Time after dial to uncolorize */
 };
\ No newline at end of file
@@ -22,7 +22,7 @@ MobRegistration::MobMeta::~MobMeta()
   }
 
   if (placeholderTexture) {
-    delete placeholderTexture;
+    TEXTURES.ReleaseTexture(GetPlaceholderTexturePath());
   }
 }
 
@@ -62,6 +62,12 @@ MobRegistration::MobMeta & MobRegistration::MobMeta::SetName(const std::string &
   return *this;
 }
 
+MobRegistration::MobMeta & MobRegistration::MobMeta::AddAnimationPath(const std::string & path)
+{
+  this->animationPaths.push_back(path);
+  return *this;
+}
+
 const sf::Texture* MobRegistration::MobMeta::GetPlaceholderTexture() const
 {
   return this->placeholderTexture;
@@ -72,6 +78,11 @@ const std::string MobRegistration::MobMeta::GetPlaceholderTexturePath() const
   return this->placeholderPath;
 }
 
+const std::vector<std::string>& MobRegistration::MobMeta::GetAnimationPaths() const
+{
+  return this->animationPaths;
+}
+
 const std::string MobRegistration::MobMeta::GetName() const
 {
   return this->name;
@@ -107,6 +118,15 @@ Mob * MobRegistration::MobMeta::GetMob() const
   return mobFactory->Build();
 }
 
+Mob * MobRegistration::MobMeta::BuildMob(Field* field) const
+{
+  MobFactory* factory = makeMobFactory(field);
+  Mob* mob = factory->Build();
+  delete factory;
+
+  return mob;
+}
+
 MobRegistration & MobRegistration::GetInstance()
 {
   static MobRegistration singleton; return singleton;
@@ -30,12 +30,14 @@ public:
     std::string name;       /*!< Name of the mob */
     std::string description;/*!< Description of mob that shows up in the text box */
     std::string placeholderPath; /*!< Path to the preview image */
+    std::vector<std::string> animationPaths; /*!< Animation files the mob's enemies load */
     sf::Texture* placeholderTexture; /*!< Texture of the preview image */
     int atk; /*!< Strength of mob to display */
     double speed; /*!< Speed of mob to display */
     int hp; /*!< Total health of mob to display */
 
     std::function<void()> loadMobClass; /*!< Deferred mob loader function */
+    std::function<MobFactory*(Field*)> makeMobFactory; /*!< Makes a factory that is not shared with GetMob() */
     public:
     /**
      * @brief Sets mob to temp data
@@ -94,6 +96,13 @@ public:
      * @return MobMeta& to chain
      */
     MobMeta& SetName(const std::string& name);
+
+    /**
+     * @brief Adds an animation file the mob loads so it can be parsed before the battle
+     * @param path path to the animation file
+     * @return MobMeta& to chain
+     */
+    MobMeta& AddAnimationPath(const std::string& path);
     
     /**
      * @brief Gets the preview texture
@@ -106,6 +115,12 @@ public:
      * @return const std::string
      */
     const std::string GetPlaceholderTexturePath() const;
+
+    /**
+     * @brief Gets the animation files added with AddAnimationPath()
+     * @return const std::vector<std::string>&
+     */
+    const std::vector<std::string>& GetAnimationPaths() const;
     
     /**
      * @brief Gets the name of the mob 
@@ -142,6 +157,16 @@ public:
      * @return Mob* to send to BattleScene
      */
     Mob* GetMob() const;
+
+    /**
+     * @brief Build the mob onto a field the caller owns
+     * 
+     * Does not touch the shared factory used by GetMob() so battles on
+     * different threads can build at the same time.
+     * @param field
+     * @return Mob* owned by the caller
+     */
+    Mob* BuildMob(Field* field) const;
   };
 
 private:
@@ -217,6 +242,10 @@ inline MobRegistration::MobMeta & MobRegistration::MobMeta::SetMobClass()
     }
   };
 
+  makeMobFactory = [](Field* field) -> MobFactory* {
+    return new T(field);
+  };
+
 
   return *this;
 }
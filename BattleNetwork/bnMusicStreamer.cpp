@@ -0,0 +1,233 @@
+#include "bnMusicStreamer.h"
+#include "bnLogger.h"
+#include "bnVirtualFileSystem.h"
+#include <algorithm>
+
+MusicStreamer::MusicStreamer() {
+  quit = false;
+  fadeProgress = fadeDuration = 0.f;
+  volume = 100.f; // SFML default
+
+  worker = std::thread(&MusicStreamer::Run, this);
+}
+
+MusicStreamer::~MusicStreamer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    quit = true;
+  }
+
+  wake.notify_all();
+  worker.join();
+
+  outgoing.reset();
+  current.reset();
+}
+
+void MusicStreamer::Load(Track& track) {
+  const char* packed = nullptr;
+  size_t size = 0;
+
+  // Packed tracks are already in memory. Stream straight from the mapped pack.
+  if (VFS.Find(track.path, packed, size)) {
+    track.ok = track.music.openFromMemory(packed, size);
+    return;
+  }
+
+  if (!VFS.Read(track.path, track.data)) {
+    track.ok = false;
+    return;
+  }
+
+  // sf::Music keeps reading from our buffer so loop points never seek on disk
+  track.ok = track.music.openFromMemory(track.data.data(), track.data.size());
+}
+
+void MusicStreamer::Run() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (!quit) {
+    Track* next = nullptr;
+
+    for (auto& track : prefetched) {
+      if (!track->ready) {
+        next = track.get();
+        break;
+      }
+    }
+
+    if (!next) {
+      wake.wait(lock);
+      continue;
+    }
+
+    // Tracks are only removed from the list once they are ready
+    // so it is safe to load this one without the lock
+    lock.unlock();
+    Load(*next);
+    lock.lock();
+
+    next->ready = true;
+    loaded.notify_all();
+  }
+}
+
+void MusicStreamer::Prefetch(const std::string& path) {
+  if (current && current->path == path) return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto& track : prefetched) {
+      if (track->path == path) return;
+    }
+
+    auto track = std::make_unique<Track>();
+    track->path = path;
+    prefetched.push_back(std::move(track));
+
+    // Drop the oldest finished tracks if too many were never played
+    auto iter = prefetched.begin();
+
+    while (prefetched.size() > MUSIC_PREFETCH_LIMIT && iter != prefetched.end()) {
+      if ((*iter)->ready) {
+        iter = prefetched.erase(iter);
+      }
+      else {
+        iter++;
+      }
+    }
+  }
+
+  wake.notify_one();
+}
+
+std::unique_ptr<MusicStreamer::Track> MusicStreamer::Claim(const std::string& path) {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  auto iter = std::find_if(prefetched.begin(), prefetched.end(), [&path](const std::unique_ptr<Track>& track) {
+    return track->path == path;
+  });
+
+  if (iter == prefetched.end()) return nullptr;
+
+  Track* track = iter->get();
+
+  // If the worker is still on it, wait for the remainder instead of opening it twice
+  loaded.wait(lock, [track] { return track->ready; });
+
+  std::unique_ptr<Track> result = std::move(*iter);
+  prefetched.erase(iter);
+
+  return result;
+}
+
+int MusicStreamer::Play(const std::string& path, bool loop, sf::Music::TimeSpan span, float crossfade) {
+  sf::Clock clock;
+  bool wasPrefetched = false;
+
+  if (current && current->path == path) {
+    // Already in memory. Restart it.
+    current->music.stop();
+    outgoing.reset();
+    wasPrefetched = true;
+  }
+  else {
+    std::unique_ptr<Track> track = Claim(path);
+    wasPrefetched = (track != nullptr);
+
+    if (!track) {
+      track = std::make_unique<Track>();
+      track->path = path;
+      Load(*track);
+      track->ready = true;
+    }
+
+    if (!track->ok) {
+      Stop();
+      return -1; // error
+    }
+
+    bool isPlaying = current && current->music.getStatus() == sf::SoundSource::Status::Playing;
+
+    if (crossfade > 0.f && isPlaying) {
+      outgoing = std::move(current);
+      fadeProgress = 0.f;
+      fadeDuration = crossfade;
+    }
+    else {
+      outgoing.reset();
+    }
+
+    current = std::move(track);
+  }
+
+  current->music.setLoop(loop);
+
+  if (loop) {
+    current->music.setLoopPoints(span);
+  }
+
+  current->music.setVolume(outgoing ? 0.f : volume);
+  current->music.play();
+
+  sf::Int64 blocked = clock.getElapsedTime().asMicroseconds();
+
+  stats.switches++;
+  wasPrefetched ? stats.prefetchHits++ : stats.prefetchMisses++;
+  stats.lastSwitchMicroseconds = blocked;
+  stats.maxSwitchMicroseconds = std::max(stats.maxSwitchMicroseconds, blocked);
+  stats.totalSwitchMicroseconds += blocked;
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Stream switch to %s blocked %i us (%s)", path.c_str(), (int)blocked, wasPrefetched ? "prefetched" : "opened");
+  Logger::GetMutex()->unlock();
+
+  return 0;
+}
+
+void MusicStreamer::Stop(float fadeOut) {
+  if (fadeOut > 0.f && current) {
+    outgoing = std::move(current);
+    fadeProgress = 0.f;
+    fadeDuration = fadeOut;
+    return;
+  }
+
+  outgoing.reset();
+  current.reset();
+}
+
+void MusicStreamer::Update(float elapsed) {
+  if (!outgoing) return;
+
+  fadeProgress += elapsed;
+
+  float alpha = std::min(fadeProgress / fadeDuration, 1.f);
+
+  if (current) {
+    current->music.setVolume(volume * alpha);
+  }
+
+  outgoing->music.setVolume(volume * (1.f - alpha));
+
+  if (alpha >= 1.f) {
+    outgoing.reset();
+  }
+}
+
+void MusicStreamer::SetVolume(float volume) {
+  this->volume = volume;
+
+  if (outgoing) {
+    // Apply the new volume at the current fade position
+    Update(0.f);
+  }
+  else if (current) {
+    current->music.setVolume(volume);
+  }
+}
+
+const MusicStreamStats MusicStreamer::GetStats() const {
+  return stats;
+}
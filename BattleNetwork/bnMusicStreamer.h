@@ -0,0 +1,118 @@
+#pragma once
+
+#include <SFML/Audio/Music.hpp>
+#include <SFML/System/Clock.hpp>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// How many prefetched tracks can wait in memory before the oldest is dropped
+#define MUSIC_PREFETCH_LIMIT 4
+
+/**
+ * @struct MusicStreamStats
+ * @brief Measures how long stream switches block the main thread
+ */
+struct MusicStreamStats {
+  unsigned switches{ 0 };         /*!< Total calls to MusicStreamer::Play() */
+  unsigned prefetchHits{ 0 };     /*!< Switches that used a prefetched track */
+  unsigned prefetchMisses{ 0 };   /*!< Switches that opened the file on the main thread */
+  sf::Int64 lastSwitchMicroseconds{ 0 };
+  sf::Int64 maxSwitchMicroseconds{ 0 };
+  sf::Int64 totalSwitchMicroseconds{ 0 };
+};
+
+/**
+ * @class MusicStreamer
+ * @author mav
+ * @date 10/19/20
+ * @brief Streams music with background prefetching and crossfades
+ *
+ * Tracks are read into memory and opened on a worker thread when prefetched
+ * so that switching streams does not wait on file open and codec initialization.
+ * Because the whole file is in memory, loop points seek without touching disk.
+ *
+ * Two tracks may play at once while crossfading. Call Update() every frame.
+ * @see AudioResourceManager::Stream
+ */
+class MusicStreamer {
+public:
+  MusicStreamer();
+  ~MusicStreamer();
+
+  /**
+   * @brief Queue a track to be read and opened on the worker thread
+   * @param path path to music file
+   */
+  void Prefetch(const std::string& path);
+
+  /**
+   * @brief Play a track. Uses the prefetched track if one exists
+   * @param path path to music file
+   * @param loop if true, loop the track
+   * @param span loop points. Only used if loop is true
+   * @param crossfade seconds to fade from the playing track to this one. 0 swaps immediately
+   * @return -1 if the track could not be opened, otherwise 0
+   */
+  int Play(const std::string& path, bool loop, sf::Music::TimeSpan span, float crossfade);
+
+  /**
+   * @brief Stop the playing track
+   * @param fadeOut seconds to fade out. 0 stops immediately
+   */
+  void Stop(float fadeOut = 0.f);
+
+  /**
+   * @brief Step crossfades
+   * @param elapsed in seconds
+   */
+  void Update(float elapsed);
+
+  void SetVolume(float volume);
+
+  const MusicStreamStats GetStats() const;
+
+private:
+  struct Track {
+    std::string path;
+    std::vector<char> data; /*!< Entire file when it is not in the resource pack. sf::Music reads from here */
+    sf::Music music;
+    bool ready{ false };    /*!< Worker finished with this track */
+    bool ok{ false };       /*!< Track opened successfully */
+  };
+
+  /**
+   * @brief Opens the music from the resource pack or reads the file into memory first
+   * @param track to load
+   */
+  static void Load(Track& track);
+
+  /**
+   * @brief Worker thread entry. Loads queued tracks until shutdown
+   */
+  void Run();
+
+  /**
+   * @brief Take a prefetched track out of the queue, waiting on it if still loading
+   * @param path path to music file
+   * @return the track or nullptr if it was never prefetched
+   */
+  std::unique_ptr<Track> Claim(const std::string& path);
+
+  std::list<std::unique_ptr<Track>> prefetched; /*!< Guarded by mutex */
+  std::unique_ptr<Track> current;
+  std::unique_ptr<Track> outgoing; /*!< Fading out */
+  std::thread worker;
+  std::mutex mutex;
+  std::condition_variable wake;    /*!< Signals the worker */
+  std::condition_variable loaded;  /*!< Signals a track is ready */
+  bool quit;
+  float fadeProgress;
+  float fadeDuration;
+  float volume;
+  MusicStreamStats stats;
+};
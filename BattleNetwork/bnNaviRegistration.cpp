@@ -156,6 +156,11 @@ Player * NaviRegistration::NaviMeta::GetNavi()
   return out;
 }
 
+Player * NaviRegistration::NaviMeta::BuildNavi() const
+{
+  return makeNavi();
+}
+
 NaviRegistration & NaviRegistration::GetInstance()
 {
  static NaviRegistration singleton; return singleton; 
@@ -38,6 +38,7 @@ public:
     bool isSword; /*!< Is buster or sword based navi */
 
     std::function<void()> loadNaviClass; /*!< Deffered navi loading. Only load navi class when needed */
+    std::function<Player*()> makeNavi; /*!< Builds a navi that is not shared with GetNavi() */
 
     public:
     /**
@@ -195,6 +196,14 @@ public:
      * @return Player*
      */
     Player* GetNavi();
+
+    /**
+     * @brief Build a new navi without touching the one GetNavi() keeps ready
+     * 
+     * Safe to call from battles running on other threads.
+     * @return Player* owned by the caller
+     */
+    Player* BuildNavi() const;
   };
 
 private:
@@ -274,5 +283,9 @@ inline NaviRegistration::NaviMeta & NaviRegistration::NaviMeta::SetNaviClass()
     this->hp = this->navi->GetHealth();
   };
 
+  makeNavi = []() -> Player* {
+    return new T();
+  };
+
   return *this;
 }
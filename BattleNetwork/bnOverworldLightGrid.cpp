@@ -0,0 +1,187 @@
+#include "bnOverworldLightGrid.h"
+#include "bnLogger.h"
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+
+namespace Overworld {
+  LightGrid::LightGrid(float cellSize) : cellSize(cellSize), cellWidth(cellSize), cellHeight(cellSize), cols(0), rows(0), all(nullptr) {
+  }
+
+  LightGrid::~LightGrid() {
+  }
+
+  void LightGrid::Build(const std::vector<Light*>& lights, const sf::FloatRect& bounds) {
+    this->bounds = bounds;
+    all = &lights;
+
+    stats = Stats();
+    stats.lights = (unsigned)lights.size();
+
+    cols = std::max(1, std::min(OVERWORLD_LIGHT_GRID_MAX_CELLS, (int)std::ceil(bounds.width / cellSize)));
+    rows = std::max(1, std::min(OVERWORLD_LIGHT_GRID_MAX_CELLS, (int)std::ceil(bounds.height / cellSize)));
+
+    cellWidth = std::max(cellSize, bounds.width / (float)cols);
+    cellHeight = std::max(cellSize, bounds.height / (float)rows);
+
+    size_t count = (size_t)(cols * rows);
+
+    if (cells.size() < count) {
+      cells.resize(count);
+    }
+
+    // Keep the capacity of each cell from last frame
+    for (size_t i = 0; i < count; i++) {
+      cells[i].clear();
+    }
+
+    stats.cells = (unsigned)count;
+
+    for (const Light* light : lights) {
+      float reach = ReachOf(*light);
+      sf::Vector2f pos = light->GetPosition();
+
+      int left = (int)std::floor((pos.x - reach - bounds.left) / cellWidth);
+      int right = (int)std::floor((pos.x + reach - bounds.left) / cellWidth);
+      int top = (int)std::floor((pos.y - reach - bounds.top) / cellHeight);
+      int bottom = (int)std::floor((pos.y + reach - bounds.top) / cellHeight);
+
+      if (right < 0 || bottom < 0 || left >= cols || top >= rows) continue;
+
+      left = std::max(left, 0);
+      top = std::max(top, 0);
+      right = std::min(right, cols - 1);
+      bottom = std::min(bottom, rows - 1);
+
+      for (int y = top; y <= bottom; y++) {
+        for (int x = left; x <= right; x++) {
+          cells[(size_t)(y * cols + x)].push_back(light);
+        }
+      }
+    }
+  }
+
+  const sf::Color LightGrid::Shade(const sf::Vector2f& pos, sf::Color base) const {
+    stats.shades++;
+
+    int x = (int)std::floor((pos.x - bounds.left) / cellWidth);
+    int y = (int)std::floor((pos.y - bounds.top) / cellHeight);
+
+    if (x < 0 || y < 0 || x >= cols || y >= rows) {
+      if (!all) return base;
+
+      for (const Light* light : *all) {
+        Accumulate(*light, pos, base);
+      }
+
+      stats.evaluations += (unsigned)all->size();
+
+      return base;
+    }
+
+    const std::vector<const Light*>& cell = cells[(size_t)(y * cols + x)];
+
+    for (const Light* light : cell) {
+      Accumulate(*light, pos, base);
+    }
+
+    stats.evaluations += (unsigned)cell.size();
+
+    return base;
+  }
+
+  const LightGrid::Stats LightGrid::GetStats() const {
+    return stats;
+  }
+
+  const float LightGrid::ReachOf(const Light& light) {
+    return (float)(light.GetRadius()*light.GetRadius());
+  }
+
+  void LightGrid::Accumulate(const Light& light, const sf::Vector2f& pos, sf::Color& color) {
+    float deltaX = pos.x - light.GetPosition().x;
+    float deltaY = pos.y - light.GetPosition().y;
+
+    float deltaR = std::sqrt(deltaX*deltaX + deltaY*deltaY);
+    float lightR = ReachOf(light);
+
+    if (deltaR <= lightR) {
+      double dist = (lightR - deltaR) / lightR;
+
+      double r = (dist*light.GetDiffuse().r) + color.r;
+      double g = (dist*light.GetDiffuse().g) + color.g;
+      double b = (dist*light.GetDiffuse().b) + color.b;
+
+      r = std::min(255.0, r); g = std::min(255.0, g); b = std::min(255.0, b);
+
+      color = sf::Color((sf::Uint8)r, (sf::Uint8)g, (sf::Uint8)b, 255);
+    }
+  }
+
+  void LightGrid::RunBenchmark(unsigned lightCount, unsigned frames) {
+    // A 480x320 screen of 47x24 tiles at 2x scale, padded like Map::GetIsometricViewBounds()
+    const sf::FloatRect screen(-200.f, -200.f, 700.f, 700.f);
+    const float tileWidth = 47.f, tileHeight = 24.f;
+
+    std::vector<sf::Vector2f> tiles;
+
+    for (float y = screen.top; y < screen.top + screen.height; y += tileHeight) {
+      for (float x = screen.left; x < screen.left + screen.width; x += tileWidth) {
+        tiles.push_back(sf::Vector2f(x, y));
+      }
+    }
+
+    // Same sizes the main menu uses for NPC and navi lights
+    std::vector<Light*> lights;
+
+    for (unsigned i = 0; i < lightCount; i++) {
+      sf::Vector2f pos(screen.left + (float)(rand() % (int)screen.width), screen.top + (float)(rand() % (int)screen.height));
+      lights.push_back(new Light(pos, sf::Color(255, 120, 0), 10));
+    }
+
+    LightGrid grid(tileWidth * 2.0f);
+
+    // Warm the cell storage so the timed loop does not allocate
+    grid.Build(lights, screen);
+
+    unsigned checksum = 0;
+    sf::Clock clock;
+
+    for (unsigned f = 0; f < frames; f++) {
+      for (auto& pos : tiles) {
+        sf::Color c = sf::Color::Black;
+
+        for (Light* light : lights) {
+          Accumulate(*light, pos, c);
+        }
+
+        checksum += c.r;
+      }
+    }
+
+    sf::Int64 bruteForce = clock.restart().asMicroseconds();
+
+    for (unsigned f = 0; f < frames; f++) {
+      grid.Build(lights, screen);
+
+      for (auto& pos : tiles) {
+        checksum += grid.Shade(pos, sf::Color::Black).r;
+      }
+    }
+
+    sf::Int64 binned = clock.restart().asMicroseconds();
+
+    Stats last = grid.GetStats();
+
+    Logger::GetMutex()->lock();
+    Logger::Logf("Overworld lighting benchmark: %u lights, %u tiles, %u frames", lightCount, (unsigned)tiles.size(), frames);
+    Logger::Logf("  per tile per light: %.2f us/frame", (double)bruteForce / (double)frames);
+    Logger::Logf("  light grid:         %.2f us/frame (%u cells, %u light tests/frame)", (double)binned / (double)frames, last.cells, last.evaluations);
+    Logger::Logf("  checksum %u", checksum);
+    Logger::GetMutex()->unlock();
+
+    for (Light* light : lights) {
+      delete light;
+    }
+  }
+}
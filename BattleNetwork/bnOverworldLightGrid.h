@@ -0,0 +1,87 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "bnOverworldLight.h"
+
+// Largest number of cells along either side of the grid
+#define OVERWORLD_LIGHT_GRID_MAX_CELLS 64
+
+namespace Overworld {
+  /*! \brief Bins lights into a coarse grid once per frame
+   *
+   * Each cell stores the lights whose reach overlaps it, in the same order
+   * as the map's light list. Shading a tile or sprite only walks the lights
+   * in its cell, so the cost per tile does not grow with lights on the
+   * other side of the screen.
+   *
+   * Positions outside of the grid bounds are shaded against every light
+   * so the result is always the same as the unbinned loop.
+   *
+   * Cell storage is reused between frames and does not allocate once warm.
+   */
+  class LightGrid {
+  public:
+    /*! \brief Work done since the last Build() */
+    struct Stats {
+      unsigned lights{ 0 }; /*!< lights binned */
+      unsigned cells{ 0 }; /*!< cells in the grid */
+      unsigned shades{ 0 }; /*!< calls to Shade() */
+      unsigned evaluations{ 0 }; /*!< light tests performed by Shade() */
+    };
+
+    /**
+     * @param cellSize length of a cell side in orthographic space
+     */
+    LightGrid(float cellSize);
+    ~LightGrid();
+
+    /**
+     * @brief Bin the lights for this frame
+     * @param lights lights to bin. The pointers must outlive the frame.
+     * @param bounds area in orthographic space that will be shaded
+     */
+    void Build(const std::vector<Light*>& lights, const sf::FloatRect& bounds);
+
+    /**
+     * @brief Add the contribution of each light in reach of pos to base
+     * @param pos position in orthographic space
+     * @param base starting color
+     * @return lit color
+     */
+    const sf::Color Shade(const sf::Vector2f& pos, sf::Color base) const;
+
+    /**
+     * @brief Work done since the last Build()
+     * @return Stats
+     */
+    const Stats GetStats() const;
+
+    /**
+     * @brief Light a full screen of tiles with and without the grid and log the cost per frame
+     * @param lightCount number of lights scattered across the screen
+     * @param frames number of frames to average over
+     */
+    static void RunBenchmark(unsigned lightCount, unsigned frames);
+
+  private:
+    /**
+     * @brief Distance at which a light stops contributing
+     *
+     * The map compares distance to radius squared, so that is the reach.
+     */
+    static const float ReachOf(const Light& light);
+
+    /**
+     * @brief Add one light to the color if in reach
+     */
+    static void Accumulate(const Light& light, const sf::Vector2f& pos, sf::Color& color);
+
+    float cellSize; /*!< requested cell size */
+    float cellWidth, cellHeight; /*!< actual cell size after clamping the grid dimensions */
+    int cols, rows; /*!< grid dimensions */
+    sf::FloatRect bounds; /*!< area covered by the grid */
+    std::vector<std::vector<const Light*>> cells; /*!< lights in reach of each cell */
+    const std::vector<Light*>* all; /*!< every light, for positions outside the grid */
+    mutable Stats stats;
+  };
+}
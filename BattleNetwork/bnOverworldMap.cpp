@@ -3,7 +3,7 @@
 #include <cmath>
 
 namespace Overworld {
-  Map::Map(int numOfCols, int numOfRows, int tileWidth, int tileHeight) : cols(numOfCols), rows(numOfRows), tileWidth(tileWidth), tileHeight(tileHeight), sf::Drawable() {
+  Map::Map(int numOfCols, int numOfRows, int tileWidth, int tileHeight) : tiles(tileWidth, tileHeight), lightGrid((float)(tileWidth * 2)), cols(numOfCols), rows(numOfRows), tileWidth(tileWidth), tileHeight(tileHeight), sf::Drawable() {
 
     // We must have one for the origin
     sf::Uint8 lighten = 255;
@@ -54,6 +54,15 @@ namespace Overworld {
     lights.push_back(_light);
   }
 
+  void Map::RemoveLight(Overworld::Light * _light) {
+    auto pos = std::find(lights.begin(), lights.end(), _light);
+
+    if (pos != lights.end()) {
+      delete *pos;
+      lights.erase(pos);
+    }
+  }
+
   void Map::AddSprite(sf::Sprite * _sprite)
   {
     sprites.push_back(_sprite);
@@ -68,131 +77,122 @@ namespace Overworld {
 
   void Map::Update(double elapsed)
   {
-	for(auto iter = map.begin(); iter != map.end(); ) {
-		if((*iter)->ShouldRemove()) {
-			delete *iter;
-			iter = map.erase(iter);
-		} else {
-			iter++;
-		}
-	}
+    tiles.RemoveMarked();
 
     std::sort(sprites.begin(), sprites.end(), [](const sf::Sprite* sprite, const sf::Sprite* other) { return sprite->getPosition().y < other->getPosition().y; });
 
   }
 
   void Map::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    // The first light follows the mouse
+    if (cam && lights.size() > 0) {
+      sf::View view = cam->GetView();
+      sf::Vector2i posi = sf::Mouse::getPosition(*ENGINE.GetWindow());
+      sf::Vector2f pos = sf::Vector2f((float)posi.x, (float)posi.y);
+      lights[0]->SetPosition(IsoToOrthogonal(pos + (view.getCenter() - (view.getSize() / 8.0f))));
+    }
+
+    // Lights are binned once per frame and shared by tiles and sprites
+    if (enableLighting) {
+      lightGrid.Build(lights, cam ? GetOrthographicViewBounds() : sf::FloatRect());
+    }
+
     DrawTiles(target, states);
     DrawSprites(target, states);
   }
 
   void Map::DrawTiles(sf::RenderTarget& target, sf::RenderStates states) const {
-    for (int i = 0; i < map.size(); i++) {
-      sf::Sprite tileSprite(map[i]->GetTexture());
-
-      if (enableLighting) {
-        tileSprite.setColor(sf::Color::Black); // no lighting
-      }
-
-      tileSprite.setScale(2.0f, 2.0f);
-      sf::Vector2f pos = map[i]->GetPos();
+    if (!cam) {
+      tiles.ForEach([&](Tile* tile) { DrawTile(*tile, sf::Vector2f(), target, states); });
+      return;
+    }
 
-      if (cam) {
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
+    sf::View view = cam->GetView();
+    sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
 
-        pos -= offset;
+    // Only chunks that intersect the view are visited
+    tiles.ForEachInView(GetIsometricViewBounds(), [&](Tile* tile) { DrawTile(*tile, offset, target, states); });
 
-        pos = OrthoToIsometric(pos*2.0f);
+    for (int i = 0; i < lights.size() && enableLighting; i++) {
+      sf::Sprite originTest(*TEXTURES.GetTexture(TextureType::LIGHT));
 
-        tileSprite.setPosition(pos);
+      sf::Vector2f pos = lights[i]->GetPosition();
 
-        if (!cam->IsInView(tileSprite)) {
-          continue;
-        }
-      }
+      pos -= offset;
 
-      pos = map[i]->GetPos();
-
-      if (cam) {
-        if (lights.size() > 0) {
-          sf::View view = cam->GetView();
-          sf::Vector2i posi = sf::Mouse::getPosition(*ENGINE.GetWindow());
-          sf::Vector2f pos = sf::Vector2f((float)posi.x, (float)posi.y);
-          lights[0]->SetPosition(IsoToOrthogonal(pos + (view.getCenter() - (view.getSize() / 8.0f))));
-        }
+      pos = OrthoToIsometric(pos*2.0f);
 
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
+      originTest.setPosition(pos);
+      target.draw(originTest);
+    }
+  }
 
-        pos -= offset;
-      }
+  void Map::DrawTile(Tile& tile, const sf::Vector2f& offset, sf::RenderTarget& target, sf::RenderStates states) const {
+    sf::Sprite tileSprite(tile.GetTexture());
 
-      for (int j = 0; j < lights.size() && enableLighting; j++) {
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
+    if (enableLighting) {
+      tileSprite.setColor(sf::Color::Black); // no lighting
+    }
 
-        float deltaX = pos.x - (lights[j]->GetPosition().x - offset.x);
-        float deltaY = pos.y - (lights[j]->GetPosition().y - offset.y);
+    tileSprite.setScale(2.0f, 2.0f);
 
-        float deltaR = sqrt((float)(deltaX*deltaX + deltaY * deltaY));
-        float lightR = (float)(lights[j]->GetRadius()*lights[j]->GetRadius());
+    sf::Vector2f pos = tile.GetPos() - offset;
 
-        if (deltaR <= lightR) {
-          double dist = (lightR - deltaR) / lightR;
-          sf::Color c = tileSprite.getColor();
+    tileSprite.setPosition(OrthoToIsometric(pos*2.0f));
 
-          double r = (dist*lights[j]->GetDiffuse().r) + c.r;
-          double g = (dist*lights[j]->GetDiffuse().g) + c.g;
-          double b = (dist*lights[j]->GetDiffuse().b) + c.b;
+    if (cam && !cam->IsInView(tileSprite)) {
+      return;
+    }
 
-          r = std::min(255.0, r); g = std::min(255.0, g); b = std::min(255.0, b);
+    if (enableLighting) {
+      tileSprite.setColor(lightGrid.Shade(tile.GetPos(), tileSprite.getColor()));
+    }
 
-          sf::Color applied((sf::Uint8)r, (sf::Uint8)g, (sf::Uint8)b, 255);
-          tileSprite.setColor(applied);
-        }
-      }
+    target.draw(tileSprite, states);
+  }
 
-      pos = OrthoToIsometric(pos*2.0f);
+  const sf::FloatRect Map::GetOrthographicViewBounds() const {
+    sf::FloatRect iso = GetIsometricViewBounds();
 
-      if (cam) {
-        tileSprite.setPosition(pos);
+    sf::Vector2f corners[] = {
+      IsoToOrthogonal(sf::Vector2f(iso.left, iso.top)),
+      IsoToOrthogonal(sf::Vector2f(iso.left + iso.width, iso.top)),
+      IsoToOrthogonal(sf::Vector2f(iso.left, iso.top + iso.height)),
+      IsoToOrthogonal(sf::Vector2f(iso.left + iso.width, iso.top + iso.height))
+    };
 
-        if (cam->IsInView(tileSprite)) {
-          target.draw(tileSprite, states);
-        }
-      }
-      else {
-        tileSprite.setPosition(pos);
+    sf::Vector2f min = corners[0], max = corners[0];
 
-        target.draw(tileSprite, states);
-      }
+    for (auto& corner : corners) {
+      min.x = std::min(min.x, corner.x); min.y = std::min(min.y, corner.y);
+      max.x = std::max(max.x, corner.x); max.y = std::max(max.y, corner.y);
     }
 
-    if (cam) {
-      for (int i = 0; i < lights.size() && enableLighting; i++) {
-        sf::Sprite originTest(*TEXTURES.GetTexture(TextureType::LIGHT));
+    return sf::FloatRect(min, max - min);
+  }
 
-        sf::Vector2f pos = lights[i]->GetPosition();
+  const sf::FloatRect Map::GetIsometricViewBounds() const {
+    sf::View view = cam->GetView();
+    sf::Vector2f topLeft = view.getCenter() - (view.getSize() / 2.0f);
 
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
+    // Tiles are drawn at 2x so the view covers half as much isometric space.
+    // Pad generously so tiles partially on screen are never culled.
+    float padding = (float)(std::max(tileWidth, tileHeight) * 4);
 
-        pos -= offset;
+    return sf::FloatRect(topLeft.x - padding, topLeft.y - padding, (view.getSize().x / 2.0f) + (padding * 2.0f), (view.getSize().y / 2.0f) + (padding * 2.0f));
+  }
 
-        pos = OrthoToIsometric(pos*2.0f);
+  void Map::DrawSprites(sf::RenderTarget& target, sf::RenderStates states) const {
+    sf::Vector2f offset;
 
-        originTest.setPosition(pos);
-        target.draw(originTest);
-      }
+    if (cam) {
+      sf::View view = cam->GetView();
+      offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
     }
-  }
 
-  void Map::DrawSprites(sf::RenderTarget& target, sf::RenderStates states) const {
     for (int i = 0; i < sprites.size(); i++) {
       sf::Sprite tileSprite(*sprites[i]->getTexture());
       tileSprite.setTextureRect(sprites[i]->getTextureRect());
-      tileSprite.setPosition(sprites[i]->getPosition());
       tileSprite.setOrigin(sprites[i]->getOrigin());
 
       if (enableLighting) {
@@ -202,71 +202,20 @@ namespace Overworld {
       tileSprite.setScale(2.0f, 2.0f);
       sf::Vector2f pos = sprites[i]->getPosition();
 
-      if (cam) {
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
-
-        pos -= offset;
-
-        pos = OrthoToIsometric(pos*2.0f);
-
-        tileSprite.setPosition(pos);
-
-        if (!cam->IsInView(tileSprite)) {
-          continue;
-        }
-      }
-
-      pos = sprites[i]->getPosition();
-
-      if (cam) {
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
-
-        pos -= offset;
-      }
-
-      for (int j = 0; j < lights.size() && enableLighting; j++) {
-        sf::View view = cam->GetView();
-        sf::Vector2f offset = IsoToOrthogonal(view.getCenter() - (view.getSize() / 2.0f));
-
-        float deltaX = pos.x - (lights[j]->GetPosition().x - offset.x);
-        float deltaY = pos.y - (lights[j]->GetPosition().y - offset.y);
-
-        float deltaR = sqrt((float)(deltaX*deltaX + deltaY * deltaY));
-        float lightR = (float)(lights[j]->GetRadius()*lights[j]->GetRadius());
-
-        if (deltaR <= lightR) {
-          double dist = (lightR - deltaR) / lightR;
-          sf::Color c = tileSprite.getColor();
+      tileSprite.setPosition(OrthoToIsometric((pos - offset)*2.0f));
 
-          double r = (dist*lights[j]->GetDiffuse().r) + c.r;
-          double g = (dist*lights[j]->GetDiffuse().g) + c.g;
-          double b = (dist*lights[j]->GetDiffuse().b) + c.b;
-
-          r = std::min(255.0, r); g = std::min(255.0, g); b = std::min(255.0, b);
-
-          sf::Color applied((sf::Uint8)r, (sf::Uint8)g, (sf::Uint8)b, 255);
-          tileSprite.setColor(applied);
-        }
+      if (cam && !cam->IsInView(tileSprite)) {
+        continue;
       }
 
-      pos = OrthoToIsometric(pos*2.0f);
-
-      if (cam) {
-        tileSprite.setPosition(pos);
-
-        if (cam->IsInView(tileSprite)) {
-          target.draw(tileSprite, states);
-        }
+      if (enableLighting) {
+        tileSprite.setColor(lightGrid.Shade(pos, tileSprite.getColor()));
       }
-      else {
-        tileSprite.setPosition(pos);
 
-        target.draw(tileSprite, states);
-      }
+      target.draw(tileSprite, states);
     }
   }
+
   const sf::Vector2f Map::OrthoToIsometric(sf::Vector2f ortho) const {
     sf::Vector2f iso;
     float tileWidthHalf = (float)(tileWidth / 2);
@@ -294,14 +243,12 @@ namespace Overworld {
   }
 
   void Map::DeleteTiles() {
-    for (int i = 0; i < map.size(); i++) {
-      delete map[i];
-    }
-
-    map.clear();
+    tiles.Clear();
   }
 
   const sf::Vector2i Map::GetTileSize() const { return sf::Vector2i(tileWidth, tileHeight); }
 
+  const size_t Map::GetTileCount() const { return tiles.Size(); }
+
 
 }
@@ -5,60 +5,25 @@
 #include "bnCamera.h"
 #include "bnOverworldLight.h"
 #include "bnTile.h"
+#include "bnOverworldTile.h"
+#include "bnOverworldTileStore.h"
+#include "bnOverworldLightGrid.h"
 
 namespace Overworld {
-  /*! \brief Structure to hold tile data */
-  class Tile {
-    sf::Texture* texture;
-    sf::Vector2f pos;
-
-    bool cleanup; /*!< flag to remove tile */
-
-    /**
-     * @brief Randomly choose a tile color to add variation
-     */
-    void LoadTexture() { 
-      int randTex = rand() % 100;
-
-      if (randTex > 80) {
-        texture = TEXTURES.GetTexture(TextureType::MAIN_MENU_OW2);
-      }
-      else {
-        texture = TEXTURES.GetTexture(TextureType::MAIN_MENU_OW);
-      }
-    }
-
-  public:
-    Tile() { pos = sf::Vector2f(0, 0); LoadTexture(); cleanup = false;  }
-    Tile(const Tile& rhs) { texture = rhs.texture; pos = rhs.pos;  cleanup = false; }
-
-    Tile(sf::Texture* _texture, sf::Vector2f pos = sf::Vector2f()) : pos(pos) { texture = _texture; cleanup = false; }
-    Tile(sf::Vector2f pos) : pos(pos) { LoadTexture(); cleanup = false;}
-    ~Tile() { ; }
-    const sf::Vector2f GetPos() const { return pos; }
-    const sf::Texture& GetTexture() { return *texture; }
-
-    void Cleanup() {
-      cleanup = true;
-    }
-
-    bool ShouldRemove() {
-      return cleanup;
-    }
-
-  };
-
 /*! \brief Incredibly hackey overworld class. Read more.
  * 
  * This generates a WxH isometric map. 
  * 
  * It sorts all sprites by Y and gives illusion of depth
+ * Tiles are kept in depth order by the TileStore
  * 
  * If something it outside of the camera view, it is not drawn
+ * Only tile chunks that intersect the camera view are visited
  * Tiles randomly choose texture
  * 
  * The map also supports psuedo lighting by multiplying sprites
- * by the light color. Limit light sources because this is slow.
+ * by the light color. Lights are binned into a LightGrid once per frame
+ * so each tile only tests the lights near it.
  * 
  * \warning This is poorly written and far from optimized. This should be
  * redesigned and not used as a base for real overworld maps.
@@ -66,9 +31,10 @@ namespace Overworld {
   class Map : public sf::Drawable
   {
   protected:
-    std::vector<Tile*> map; /*!< tiles */
+    TileStore tiles; /*!< tiles chunked by isometric row */
     std::vector<Overworld::Light*> lights; /*!< light sources */
     std::vector<sf::Sprite*> sprites; /*!< other sprites in the scene */
+    mutable LightGrid lightGrid; /*!< lights binned for the current frame */
     
     bool enableLighting; /*!< if true, enables light shading */
 
@@ -110,27 +76,25 @@ namespace Overworld {
     virtual void DrawSprites(sf::RenderTarget& target, sf::RenderStates states) const;
 
     /**
-     * @class TileComparitor
-     * @brief Used to sort tiles by isometric Y value
+     * @brief Draws one tile with lighting
+     * @param tile
+     * @param offset camera offset in orthographic space
+     * @param target
+     * @param states
      */
-    struct TileComparitor
-    {
-    private:
-      Overworld::Map* map;
+    void DrawTile(Tile& tile, const sf::Vector2f& offset, sf::RenderTarget& target, sf::RenderStates states) const;
 
-    public:
-      TileComparitor(Map* _map) {
-        map = _map;
-      }
-
-      inline bool operator() (const Overworld::Tile* a, const Overworld::Tile* b)
-      {
-        sf::Vector2f isoA = map->OrthoToIsometric(a->GetPos());
-        sf::Vector2f isoB = map->OrthoToIsometric(b->GetPos());
+    /**
+     * @brief The camera view in isometric space, padded by the largest tile size
+     * @return bounds to pass to TileStore::ForEachInView()
+     */
+    const sf::FloatRect GetIsometricViewBounds() const;
 
-        return (isoA.y < isoB.y);
-      }
-    };
+    /**
+     * @brief Bounding box of the padded camera view in orthographic space
+     * @return bounds to pass to LightGrid::Build()
+     */
+    const sf::FloatRect GetOrthographicViewBounds() const;
 
     public:
     /**
@@ -163,6 +127,12 @@ namespace Overworld {
      * @param _light
      */
     void AddLight(Overworld::Light* _light);
+
+    /**
+     * @brief Remove and delete a light
+     * @param _light
+     */
+    void RemoveLight(Overworld::Light* _light);
     
     /**
      * @brief Add a sprite
@@ -194,5 +164,11 @@ namespace Overworld {
      * @return const sf::Vector2i(tileWidth, tileHeight)
      */
     const sf::Vector2i GetTileSize() const;
+
+    /**
+     * @brief Number of tiles currently in the map
+     * @return size_t
+     */
+    const size_t GetTileCount() const;
   };
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "bnTextureResourceManager.h"
+
+namespace Overworld {
+  /*! \brief Structure to hold tile data */
+  class Tile {
+    sf::Texture* texture;
+    sf::Vector2f pos;
+
+    bool cleanup; /*!< flag to remove tile */
+
+    /**
+     * @brief Randomly choose a tile color to add variation
+     */
+    void LoadTexture() { 
+      int randTex = rand() % 100;
+
+      if (randTex > 80) {
+        texture = TEXTURES.GetTexture(TextureType::MAIN_MENU_OW2);
+      }
+      else {
+        texture = TEXTURES.GetTexture(TextureType::MAIN_MENU_OW);
+      }
+    }
+
+  public:
+    Tile() { pos = sf::Vector2f(0, 0); LoadTexture(); cleanup = false;  }
+    Tile(const Tile& rhs) { texture = rhs.texture; pos = rhs.pos;  cleanup = false; }
+
+    Tile(sf::Texture* _texture, sf::Vector2f pos = sf::Vector2f()) : pos(pos) { texture = _texture; cleanup = false; }
+    Tile(sf::Vector2f pos) : pos(pos) { LoadTexture(); cleanup = false;}
+    ~Tile() { ; }
+
+    /**
+     * @brief Reuse this tile at a new position with a new random color
+     * @param pos
+     */
+    void Reset(sf::Vector2f pos) { this->pos = pos; LoadTexture(); cleanup = false; }
+
+    const sf::Vector2f GetPos() const { return pos; }
+    const sf::Texture& GetTexture() { return *texture; }
+
+    void Cleanup() {
+      cleanup = true;
+    }
+
+    bool ShouldRemove() {
+      return cleanup;
+    }
+
+  };
+}
@@ -0,0 +1,176 @@
+#include "bnOverworldTileStore.h"
+#include <cmath>
+
+namespace Overworld {
+  TileStore::TileStore(int tileWidth, int tileHeight) : spareCapacity(0), tileWidth(tileWidth), tileHeight(tileHeight), size(0) {
+  }
+
+  TileStore::~TileStore() {
+    Clear();
+  }
+
+  void TileStore::Insert(Tile* tile) {
+    sf::Vector2f iso = ToIsometric(tile->GetPos());
+    int row = RowOf(iso.y);
+
+    Chunk& chunk = chunks[ChunkOf(row)];
+    std::vector<Tile*>& tiles = chunk.rows[row];
+
+    // Keep the row sorted by isometric Y so drawing needs no sort
+    auto pos = std::upper_bound(tiles.begin(), tiles.end(), iso.y, [this](float y, Tile* other) {
+      return y < ToIsometric(other->GetPos()).y;
+    });
+
+    tiles.insert(pos, tile);
+
+    if (chunk.size == 0) {
+      chunk.minX = chunk.maxX = iso.x;
+    }
+    else {
+      chunk.minX = std::min(chunk.minX, iso.x);
+      chunk.maxX = std::max(chunk.maxX, iso.x);
+    }
+
+    chunk.size++;
+    size++;
+  }
+
+  Tile* TileStore::Create(const sf::Vector2f& pos) {
+    if (spares.empty()) {
+      return new Tile(pos);
+    }
+
+    Tile* tile = spares.back();
+    spares.pop_back();
+    tile->Reset(pos);
+
+    return tile;
+  }
+
+  void TileStore::SetSpareCapacity(size_t capacity) {
+    spareCapacity = capacity;
+
+    while (spares.size() > spareCapacity) {
+      delete spares.back();
+      spares.pop_back();
+    }
+
+    spares.reserve(spareCapacity);
+  }
+
+  const size_t TileStore::SpareCount() const {
+    return spares.size();
+  }
+
+  void TileStore::Clear() {
+    ForEach([](Tile* tile) { delete tile; });
+
+    for (Tile* tile : spares) {
+      delete tile;
+    }
+
+    spares.clear();
+    chunks.clear();
+    size = 0;
+  }
+
+  void TileStore::Release(Tile* tile) {
+    if (spares.size() < spareCapacity) {
+      spares.push_back(tile);
+    }
+    else {
+      delete tile;
+    }
+  }
+
+  size_t TileStore::RemoveMarked() {
+    size_t removed = 0;
+
+    for (auto chunkIter = chunks.begin(); chunkIter != chunks.end(); ) {
+      Chunk& chunk = chunkIter->second;
+      size_t before = chunk.size;
+
+      for (auto rowIter = chunk.rows.begin(); rowIter != chunk.rows.end(); ) {
+        std::vector<Tile*>& row = rowIter->second;
+
+        auto end = std::remove_if(row.begin(), row.end(), [this](Tile* tile) {
+          if (tile->ShouldRemove()) {
+            Release(tile);
+            return true;
+          }
+
+          return false;
+        });
+
+        chunk.size -= (size_t)std::distance(end, row.end());
+        row.erase(end, row.end());
+
+        rowIter = row.empty() ? chunk.rows.erase(rowIter) : std::next(rowIter);
+      }
+
+      removed += before - chunk.size;
+
+      if (chunk.size == 0) {
+        chunkIter = chunks.erase(chunkIter);
+      }
+      else {
+        if (before != chunk.size) {
+          RecalculateBounds(chunk);
+        }
+
+        chunkIter++;
+      }
+    }
+
+    size -= removed;
+
+    return removed;
+  }
+
+  const size_t TileStore::Size() const {
+    return size;
+  }
+
+  const size_t TileStore::ChunkCount() const {
+    return chunks.size();
+  }
+
+  const sf::Vector2f TileStore::ToIsometric(const sf::Vector2f& ortho) const {
+    sf::Vector2f iso;
+    float tileWidthHalf = (float)(tileWidth / 2);
+    float tileHeightHalf = (float)(tileHeight / 2);
+
+    iso.x = ((ortho.x / (float)tileWidth) - (ortho.y / (float)tileHeight)) * tileWidthHalf;
+    iso.y = ((ortho.x / (float)tileWidth) + (ortho.y / (float)tileHeight)) * tileHeightHalf;
+
+    return iso;
+  }
+
+  const int TileStore::RowOf(float isoY) const {
+    return (int)std::floor(isoY / (float)(tileHeight / 2));
+  }
+
+  const int TileStore::ChunkOf(int row) const {
+    // Floor division so negative rows land in the chunk below them
+    return (row >= 0) ? (row / OVERWORLD_CHUNK_ROWS) : ((row - OVERWORLD_CHUNK_ROWS + 1) / OVERWORLD_CHUNK_ROWS);
+  }
+
+  void TileStore::RecalculateBounds(Chunk& chunk) {
+    bool first = true;
+
+    for (auto& rowPair : chunk.rows) {
+      for (Tile* tile : rowPair.second) {
+        float x = ToIsometric(tile->GetPos()).x;
+
+        if (first) {
+          chunk.minX = chunk.maxX = x;
+          first = false;
+        }
+        else {
+          chunk.minX = std::min(chunk.minX, x);
+          chunk.maxX = std::max(chunk.maxX, x);
+        }
+      }
+    }
+  }
+}
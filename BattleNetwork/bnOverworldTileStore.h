@@ -0,0 +1,242 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include "bnOverworldTile.h"
+
+// Number of isometric rows grouped into one chunk
+#define OVERWORLD_CHUNK_ROWS 16
+
+namespace Overworld {
+  /*! \brief Chunked tile storage indexed by isometric row
+   *
+   * A tile's isometric row is the diagonal it sits on. Rows further down the
+   * screen are drawn later, so walking chunks and rows in key order gives the
+   * depth order without sorting. New tiles are inserted into their row in place.
+   *
+   * Chunks track their horizontal extent in isometric space so that
+   * ForEachInView() only visits chunks that can intersect the camera.
+   *
+   * The store owns its tiles. Removed tiles are kept as spares, up to the
+   * spare capacity, and handed back out by Create() instead of allocating.
+   */
+  class TileStore {
+  public:
+    struct Chunk {
+      std::map<int, std::vector<Tile*>> rows; /*!< isometric row -> tiles sorted by isometric Y */
+      float minX{ 0 }, maxX{ 0 }; /*!< horizontal extent of tile positions in isometric space */
+      size_t size{ 0 }; /*!< number of tiles in this chunk */
+    };
+
+    /**
+     * @brief Rows are computed with the same projection as Overworld::Map
+     * @param tileWidth
+     * @param tileHeight
+     */
+    TileStore(int tileWidth, int tileHeight);
+
+    /**
+     * @brief Deletes all tiles
+     */
+    ~TileStore();
+
+    TileStore(const TileStore&) = delete;
+
+    /**
+     * @brief Adds the tile in depth order. Takes ownership.
+     * @param tile
+     */
+    void Insert(Tile* tile);
+
+    /**
+     * @brief Makes a tile from the spares or allocates one. Does not insert it.
+     * @param pos orthographic position
+     * @return Tile*
+     */
+    Tile* Create(const sf::Vector2f& pos);
+
+    /**
+     * @brief Number of removed tiles to keep for Create(). Default is 0.
+     * @param capacity
+     */
+    void SetSpareCapacity(size_t capacity);
+
+    /**
+     * @brief Number of removed tiles waiting to be reused
+     */
+    const size_t SpareCount() const;
+
+    /**
+     * @brief Deletes all tiles and spares
+     */
+    void Clear();
+
+    /**
+     * @brief Removes tiles flagged with Tile::Cleanup()
+     * @return number of tiles removed
+     */
+    size_t RemoveMarked();
+
+    /**
+     * @brief Removes tiles whose isometric X is left of isoX
+     *
+     * Chunks entirely to the left are dropped without visiting each tile.
+     * Chunks entirely to the right are skipped.
+     * @param isoX boundary in isometric space
+     * @param keep predicate. Tiles it returns true for are not removed
+     * @return number of tiles removed
+     */
+    template<typename Keep>
+    size_t RemoveLeftOf(float isoX, Keep&& keep);
+
+    /**
+     * @brief Visit every tile in depth order
+     * @param f callable taking Tile*
+     */
+    template<typename F>
+    void ForEach(F&& f) const;
+
+    /**
+     * @brief Visit tiles in depth order that may be inside the bounds
+     *
+     * Tiles are found by their position, but their sprites reach past it, so the
+     * bounds are grown by one tile on every side before chunks and rows are culled.
+     * Tiles just outside the bounds can still be visited.
+     * @param isoBounds rectangle in isometric space
+     * @param f callable taking Tile*
+     */
+    template<typename F>
+    void ForEachInView(const sf::FloatRect& isoBounds, F&& f) const;
+
+    /**
+     * @brief Number of tiles stored
+     */
+    const size_t Size() const;
+
+    /**
+     * @brief Number of chunks that have tiles
+     */
+    const size_t ChunkCount() const;
+
+    /**
+     * @brief Same projection as Overworld::Map::OrthoToIsometric
+     */
+    const sf::Vector2f ToIsometric(const sf::Vector2f& ortho) const;
+
+  private:
+    /**
+     * @brief Isometric row for an isometric Y value
+     */
+    const int RowOf(float isoY) const;
+
+    /**
+     * @brief Chunk index for a row
+     */
+    const int ChunkOf(int row) const;
+
+    /**
+     * @brief Recompute the horizontal extent after tiles are removed
+     */
+    void RecalculateBounds(Chunk& chunk);
+
+    /**
+     * @brief Keep the tile as a spare or delete it if there is no room
+     */
+    void Release(Tile* tile);
+
+    std::vector<Tile*> spares; /*!< removed tiles ready for reuse */
+    size_t spareCapacity; /*!< most spares to keep */
+    std::map<int, Chunk> chunks; /*!< chunk index -> chunk */
+    int tileWidth, tileHeight;
+    size_t size;
+  };
+
+  template<typename Keep>
+  size_t TileStore::RemoveLeftOf(float isoX, Keep&& keep) {
+    size_t removed = 0;
+
+    for (auto chunkIter = chunks.begin(); chunkIter != chunks.end(); ) {
+      Chunk& chunk = chunkIter->second;
+
+      if (chunk.minX >= isoX) {
+        chunkIter++;
+        continue;
+      }
+
+      bool whole = chunk.maxX < isoX;
+
+      for (auto rowIter = chunk.rows.begin(); rowIter != chunk.rows.end(); ) {
+        std::vector<Tile*>& row = rowIter->second;
+
+        auto end = std::remove_if(row.begin(), row.end(), [&](Tile* tile) {
+          if (keep(tile)) return false;
+
+          if (whole || ToIsometric(tile->GetPos()).x < isoX) {
+            Release(tile);
+            return true;
+          }
+
+          return false;
+        });
+
+        removed += (size_t)std::distance(end, row.end());
+        chunk.size -= (size_t)std::distance(end, row.end());
+        row.erase(end, row.end());
+
+        rowIter = row.empty() ? chunk.rows.erase(rowIter) : std::next(rowIter);
+      }
+
+      if (chunk.size == 0) {
+        chunkIter = chunks.erase(chunkIter);
+      }
+      else {
+        RecalculateBounds(chunk);
+        chunkIter++;
+      }
+    }
+
+    size -= removed;
+
+    return removed;
+  }
+
+  template<typename F>
+  void TileStore::ForEach(F&& f) const {
+    for (auto& chunkPair : chunks) {
+      for (auto& rowPair : chunkPair.second.rows) {
+        for (Tile* tile : rowPair.second) {
+          f(tile);
+        }
+      }
+    }
+  }
+
+  template<typename F>
+  void TileStore::ForEachInView(const sf::FloatRect& isoBounds, F&& f) const {
+    // One tile of padding keeps tiles whose sprites overlap the edge
+    int firstRow = RowOf(isoBounds.top - tileHeight);
+    int lastRow = RowOf(isoBounds.top + isoBounds.height + tileHeight);
+
+    float left = isoBounds.left - tileWidth;
+    float right = isoBounds.left + isoBounds.width + tileWidth;
+
+    auto chunkIter = chunks.lower_bound(ChunkOf(firstRow));
+    auto chunkEnd = chunks.upper_bound(ChunkOf(lastRow));
+
+    for (; chunkIter != chunkEnd; chunkIter++) {
+      const Chunk& chunk = chunkIter->second;
+
+      if (chunk.maxX < left || chunk.minX > right) continue;
+
+      auto rowIter = chunk.rows.lower_bound(firstRow);
+      auto rowEnd = chunk.rows.upper_bound(lastRow);
+
+      for (; rowIter != rowEnd; rowIter++) {
+        for (Tile* tile : rowIter->second) {
+          f(tile);
+        }
+      }
+    }
+  }
+}
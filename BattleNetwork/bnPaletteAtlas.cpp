@@ -0,0 +1,101 @@
+#include "bnPaletteAtlas.h"
+#include "bnLogger.h"
+#include "bnVirtualFileSystem.h"
+
+PaletteAtlas& PaletteAtlas::GetInstance() {
+  static PaletteAtlas instance;
+  return instance;
+}
+
+PaletteAtlas::PaletteAtlas() {
+  rowCount = 0;
+
+  // Start with room for a few palettes. The page doubles when full.
+  pixels.create(PALETTE_ATLAS_WIDTH, 4, sf::Color::Transparent);
+  texture.loadFromImage(pixels);
+}
+
+PaletteAtlas::~PaletteAtlas() {
+}
+
+int PaletteAtlas::AddPalette(const std::string& path) {
+  auto iter = rowsByPath.find(path);
+
+  if (iter != rowsByPath.end()) {
+    return iter->second;
+  }
+
+  sf::Image palette;
+
+  if (!VFS.Load(palette, path)) {
+    Logger::Logf("Failed loading palette: %s", path.c_str());
+    return -1;
+  }
+
+  int row = AddPalette(palette);
+  rowsByPath[path] = row;
+
+  return row;
+}
+
+int PaletteAtlas::AddPalette(const sf::Image& palette) {
+  int row = (int)rowCount;
+
+  Reserve(rowCount + 1);
+  rowCount++;
+
+  SetPalette(row, palette);
+
+  return row;
+}
+
+void PaletteAtlas::SetPalette(int row, const sf::Image& palette) {
+  if (row < 0 || row >= (int)rowCount) return;
+
+  CopyRow(row, palette);
+
+  // Only the changed row goes to the GPU
+  texture.update(pixels.getPixelsPtr() + (row * PALETTE_ATLAS_WIDTH * 4), PALETTE_ATLAS_WIDTH, 1, 0, (unsigned)row);
+}
+
+void PaletteAtlas::CopyRow(int row, const sf::Image& palette) {
+  sf::Vector2u size = palette.getSize();
+
+  if (size.x == 0 || size.y == 0) return;
+
+  for (unsigned x = 0; x < PALETTE_ATLAS_WIDTH; x++) {
+    // Nearest neighbor so narrower palettes still cover the full red channel
+    unsigned srcX = (x * size.x) / PALETTE_ATLAS_WIDTH;
+    pixels.setPixel(x, (unsigned)row, palette.getPixel(srcX, 0));
+  }
+}
+
+void PaletteAtlas::Reserve(unsigned rows) {
+  unsigned capacity = pixels.getSize().y;
+
+  if (rows <= capacity) return;
+
+  while (capacity < rows) {
+    capacity *= 2;
+  }
+
+  sf::Image grown;
+  grown.create(PALETTE_ATLAS_WIDTH, capacity, sf::Color::Transparent);
+  grown.copy(pixels, 0, 0);
+  pixels = grown;
+
+  // Same sf::Texture object so shaders that point to it stay valid
+  texture.loadFromImage(pixels);
+}
+
+const sf::Texture& PaletteAtlas::GetTexture() const {
+  return texture;
+}
+
+const float PaletteAtlas::GetRowCoordinate(int row) const {
+  return ((float)row + 0.5f) / (float)pixels.getSize().y;
+}
+
+const unsigned PaletteAtlas::GetRowCount() const {
+  return rowCount;
+}
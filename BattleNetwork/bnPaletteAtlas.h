@@ -0,0 +1,91 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <map>
+
+// Palettes are indexed by the red channel so each row holds 256 colors
+#define PALETTE_ATLAS_WIDTH 256
+
+/**
+ * @class PaletteAtlas
+ * @author mav
+ * @date 10/19/20
+ * @brief One texture page that holds every palette, one palette per row
+ *
+ * The palette swap shader samples this page for all entities.
+ * Each entity only supplies the row to read from so that all palette-swapped
+ * sprites draw with the same shader and texture bindings.
+ * @see PaletteSwap
+ */
+class PaletteAtlas {
+public:
+  /**
+   * @brief If first call, initializes the atlas and returns it
+   * @return PaletteAtlas&
+   */
+  static PaletteAtlas& GetInstance();
+
+  /**
+   * @brief Adds the palette file as a new row. Files are only loaded once
+   * @param path path to palette image
+   * @return row index or -1 if the file could not be loaded
+   */
+  int AddPalette(const std::string& path);
+
+  /**
+   * @brief Adds the palette image as a new row
+   * @param palette image whose first row of pixels are the colors
+   * @return row index
+   */
+  int AddPalette(const sf::Image& palette);
+
+  /**
+   * @brief Replaces the colors in an existing row
+   * @param row row index
+   * @param palette image whose first row of pixels are the colors
+   */
+  void SetPalette(int row, const sf::Image& palette);
+
+  /**
+   * @brief The texture page for the palette swap shader
+   * @return const sf::Texture&
+   */
+  const sf::Texture& GetTexture() const;
+
+  /**
+   * @brief Texture coordinate of the center of a row
+   *
+   * The page grows as rows are added, so query this when drawing
+   * @param row row index
+   * @return v coordinate in the range [0,1]
+   */
+  const float GetRowCoordinate(int row) const;
+
+  /**
+   * @brief Number of palettes in the atlas
+   * @return unsigned
+   */
+  const unsigned GetRowCount() const;
+
+private:
+  PaletteAtlas();
+  ~PaletteAtlas();
+
+  /**
+   * @brief Copies the palette into the row of pixels, stretching it if needed
+   */
+  void CopyRow(int row, const sf::Image& palette);
+
+  /**
+   * @brief Doubles the capacity of the page if all rows are used
+   */
+  void Reserve(unsigned rows);
+
+  sf::Image pixels; /*!< CPU copy of the page */
+  sf::Texture texture; /*!< GPU copy of the page */
+  std::map<std::string, int> rowsByPath; /*!< Palettes loaded from file */
+  unsigned rowCount; /*!< Rows in use */
+};
+
+/*! \brief Shorthand to get instance of the atlas */
+#define PALETTES PaletteAtlas::GetInstance()
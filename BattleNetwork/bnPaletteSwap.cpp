@@ -1,24 +1,44 @@
 #include "bnPaletteSwap.h"
-#include "bnTextureResourceManager.h"
+#include "bnPaletteAtlas.h"
 #include "bnShaderResourceManager.h"
 #include "bnEntity.h"
 
-PaletteSwap::PaletteSwap(Entity * owner, sf::Texture base_palette) : Component(owner), base(base_palette), enabled(true)
+PaletteSwap::PaletteSwap(Entity * owner, sf::Texture base_palette) : PaletteSwap(owner, std::string())
 {
+  base = palette = PALETTES.AddPalette(base_palette.copyToImage());
+}
+
+PaletteSwap::PaletteSwap(Entity* owner, const std::string& basePath) : Component(owner), custom(-1), enabled(true)
+{
+  base = palette = basePath.empty() ? -1 : PALETTES.AddPalette(basePath);
+
   paletteSwap = ShaderResourceManager::GetInstance().GetShader(ShaderType::PALETTE_SWAP);
-  paletteSwap->setUniform("palette", base);
+
+  // Every palette swap shares the one atlas page
+  paletteSwap->setUniform("palette", PALETTES.GetTexture());
   paletteSwap->setUniform("texture", sf::Shader::CurrentTexture);
+
+  rowUniform = SmartShader(*paletteSwap).GetUniformHandle("paletteRow");
 }
 
 PaletteSwap::~PaletteSwap()
 {
 }
 
+void PaletteSwap::Apply()
+{
+  if (GetOwner()->GetShader().Get() != paletteSwap) {
+    GetOwner()->SetShader(paletteSwap);
+  }
+
+  // The page may have grown since last frame
+  GetOwner()->GetShader().SetUniform(rowUniform, PALETTES.GetRowCoordinate(palette));
+}
+
 void PaletteSwap::OnUpdate(float _elapsed)
 {
   if (!enabled) return;
-  if (GetOwner()->GetShader().Get() == paletteSwap) return;
-  GetOwner()->SetShader(paletteSwap);
+  Apply();
 }
 
 void PaletteSwap::Inject(BattleScene &)
@@ -27,22 +47,29 @@ void PaletteSwap::Inject(BattleScene &)
 
 void PaletteSwap::LoadPaletteTexture(std::string path)
 {
-  auto texture = TextureResourceManager::GetInstance().LoadTextureFromFile(path);
-  palette = *texture;
-  delete texture;
-  paletteSwap->setUniform("palette", palette);
+  int row = PALETTES.AddPalette(path);
 
+  if (row != -1) {
+    palette = row;
+  }
 }
 
 void PaletteSwap::SetTexture(sf::Texture & texture)
 {
-  palette = texture;
-  paletteSwap->setUniform("palette", palette);
+  // Reuse our own row so repeated calls don't grow the atlas
+  if (custom == -1) {
+    custom = PALETTES.AddPalette(texture.copyToImage());
+  }
+  else {
+    PALETTES.SetPalette(custom, texture.copyToImage());
+  }
+
+  palette = custom;
 }
 
 void PaletteSwap::Revert()
 {
-  SetTexture(base);
+  palette = base;
 }
 
 void PaletteSwap::Enable(bool enabled)
@@ -53,6 +80,6 @@ void PaletteSwap::Enable(bool enabled)
   // Don't wait for the next frame (update())
   // Otherwise blocky effects occur
   if (enabled) {
-    GetOwner()->SetShader(paletteSwap);
+    Apply();
   }
 }
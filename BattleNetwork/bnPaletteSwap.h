@@ -1,17 +1,31 @@
 #pragma once
 #include "bnComponent.h"
+#include "bnSmartShader.h"
 #include <SFML/Graphics.hpp>
 class BattleScene;
 class Entity;
 
+/**
+ * @class PaletteSwap
+ * @brief Recolors the owner with a row from the shared palette atlas
+ * @see PaletteAtlas
+ */
 class PaletteSwap : public Component {
 private:
-  sf::Texture palette;
-  sf::Texture base;
+  int base; /*!< Atlas row of the original palette */
+  int palette; /*!< Atlas row in use */
+  int custom; /*!< Atlas row owned by this component for SetTexture(). -1 until used */
   sf::Shader* paletteSwap;
+  SmartShader::Handle rowUniform; /*!< Pre-resolved handle for the row coordinate uniform */
   bool enabled; /*!< Turn this effect on/off */
+
+  /**
+   * @brief Attach the shader to the owner and point it to our row
+   */
+  void Apply();
 public:
   PaletteSwap(Entity* owner, sf::Texture base);
+  PaletteSwap(Entity* owner, const std::string& basePath);
   ~PaletteSwap();
   void OnUpdate(float _elapsed);
   void Inject(BattleScene&);
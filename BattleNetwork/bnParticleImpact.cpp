@@ -3,6 +3,7 @@
 #include "bnField.h"
 #include "bnTile.h"
 #include "bnParticleImpact.h"
+#include "bnBattleContext.h"
 
 using sf::IntRect;
 
@@ -50,8 +51,8 @@ ParticleImpact::ParticleImpact(ParticleImpact::Type type) : Artifact(nullptr)
 }
 
 void ParticleImpact::OnSpawn(Battle::Tile& tile) {
-  randOffset = sf::Vector2f(float(rand() % 10), float(rand() % 10));
-  randOffset.x *= rand() % 2 ? -1 : 1;
+  randOffset = sf::Vector2f(float(BattleContext::Rand() % 10), float(BattleContext::Rand() % 10));
+  randOffset.x *= BattleContext::Rand() % 2 ? -1 : 1;
   randOffset.y = randOffset.y - GetHeight();
 }
 
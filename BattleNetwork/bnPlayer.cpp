@@ -193,3 +193,15 @@ bool Player::RegisterForm(PlayerFormMeta * info)
   this->forms[formSize++] = info;
   return true;
 }
+
+void Player::SaveState(BattleSnapshot& snapshot) const
+{
+  AI<Player>::SaveAI(snapshot);
+  Character::SaveState(snapshot);
+}
+
+void Player::LoadState(BattleSnapshot& snapshot)
+{
+  AI<Player>::LoadAI(snapshot);
+  Character::LoadState(snapshot);
+}
@@ -77,6 +77,18 @@ public:
 
   virtual const float GetHeight() const;
 
+  /**
+   * @brief Saves the AI and then the character
+   * @param snapshot
+   */
+  virtual void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back the state written by SaveState()
+   * @param snapshot
+   */
+  virtual void LoadState(BattleSnapshot& snapshot);
+
   /**
    * @brief Get how many times the player has moved across the grid
    * @return int
@@ -23,151 +23,179 @@
 #include "bnInvis.h"
 #include "bnElecpulse.h"
 #include "bnHideUntil.h"
+#include "bnTextureResourceManager.h"
+
+#include <cstring>
+
+namespace {
+  /*! \brief What the player does with a chip and the textures doing it loads */
+  struct PlayerChip {
+    const char* name; /*!< short name of the chip */
+    bool prefix; /*!< if true, matches every chip whose short name starts with name */
+    void (*use)(Player& player, Chip& chip); /*!< null if the chip is handled elsewhere, e.g. summons */
+    const char* textures[2]; /*!< loaded by the action. Prefetched when the chip is selected. */
+  };
+
+  // Every chip the player can use. OnChipUse() and PrefetchAssets() both read this
+  // table so a new chip's action and its textures are added together.
+  const PlayerChip PLAYER_CHIPS[] = {
+    { "Recov", true, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new RecoverChipAction(&player, chip.GetDamage()));
+    }, { nullptr } },
+    { "CrckPanel", false, [](Player& player, Chip& chip) {
+      // Crack the top, middle, and bottom row in front of player
+      Battle::Tile* top = player.GetField()->GetAt(player.GetTile()->GetX() + 1, 1);
+      Battle::Tile* mid = player.GetField()->GetAt(player.GetTile()->GetX() + 1, 2);
+      Battle::Tile* low = player.GetField()->GetAt(player.GetTile()->GetX() + 1, 3);
+
+      // If the tiles are valid, set their state to CRACKED
+      if (top) { top->SetState(TileState::CRACKED); }
+      if (mid) { mid->SetState(TileState::CRACKED); }
+      if (low) { low->SetState(TileState::CRACKED); }
+
+      AUDIO.Play(AudioType::PANEL_CRACK);
+    }, { nullptr } },
+    { "YoYo", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new YoYoChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/buster_yoyo.png" } },
+    { "Invis", false, [](Player& player, Chip& chip) {
+      // Create an invisible component. This handles the logic for timed invis
+      player.RegisterComponent(new Invis(&player));
+    }, { nullptr } },
+    { "Rflctr1", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new ReflectChipAction(&player, chip.GetDamage()));
+    }, { nullptr } },
+    { "Fishy", false, [](Player& player, Chip& chip) {
+      /**
+        * Fishy is two pieces: the Fishy attack and a HideUntil component
+        *
+        * The fishy moves right
+        *
+        * HideUntil is a special component that removes entity from play
+        * until a condition is met. This condition is defined in a
+        * HideUntill::Callback query functor.
+        *
+        * In this case, we hide until the fishy is deleted whether by
+        * reaching the end of the field or by a successful attack. The
+        * query functor will then return true.
+        *
+        * When HideUntill condition is met, the component will add the entity back
+        * in its original place and then removes itself from the component
+        * owner
+        */
+      Fishy* fishy = new Fishy(player.GetField(), player.GetTeam(), 1.0);
+      fishy->SetDirection(Direction::RIGHT);
+
+      // Condition to end hide
+      HideUntil::Callback until = [fishy]() { return fishy->IsDeleted(); };
+
+      // First argument is the entity to hide
+      // Second argument is the query functor
+      HideUntil* fishyStatus = new HideUntil(&player, until);
+      player.RegisterComponent(fishyStatus);
+
+      Battle::Tile* tile = player.GetTile();
+
+      if (tile) {
+        player.GetField()->AddEntity(*fishy, tile->GetX(), tile->GetY());
+      }
+    }, { "resources/spells/fishy_temp.png" } },
+    { "XtrmeCnnon", false, nullptr, { nullptr } },
+    { "TwinFang", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new TwinFangChipAction(&player, chip.GetDamage()));
+    }, { nullptr } },
+    { "Tornado", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new TornadoChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/buster_fan.png" } },
+    { "ElecSwrd", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new ElecSwordChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/spell_elec_sword.png" } },
+    { "FireBrn", true, [](Player& player, Chip& chip) {
+      auto type = FireBurn::Type(std::atoi(chip.GetShortName().substr(7, 1).c_str()));
+      player.RegisterComponent(new FireBurnChipAction(&player, type, chip.GetDamage()));
+    }, { "resources/spells/buster_flame.png" } },
+    { "Vulcan", true, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new VulcanChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/spell_vulcan.png" } },
+    { "Cannon", true, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new CannonChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/CannonSeries.png" } },
+    { "MiniBomb", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new BombChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/spell_bomb.png" } },
+    { "CrakShot", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new CrackShotChipAction(&player, chip.GetDamage()));
+    }, { nullptr } },
+    { "Swrd", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new SwordChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/spell_sword_blades.png" } },
+    { "Elecplse", false, [](Player& player, Chip& chip) {
+      // Spawn an elecpulse attack
+      Player* owner = &player;
+      auto onFinish = [owner]() { owner->SetAnimation(PLAYER_IDLE); };
+
+      player.SetAnimation(PLAYER_SHOOTING, onFinish);
+
+      Elecpulse* pulse = new Elecpulse(player.GetField(), player.GetTeam(), chip.GetDamage());
+
+      AUDIO.Play(AudioType::ELECPULSE);
+
+      player.GetField()->AddEntity(*pulse, player.GetTile()->GetX() + 1, player.GetTile()->GetY());
+    }, { nullptr } },
+    { "LongSwrd", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new LongSwordChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/spell_sword_blades.png" } },
+    { "WideSwrd", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new WideSwordChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/spell_sword_blades.png" } },
+    { "FireSwrd", false, [](Player& player, Chip& chip) {
+      auto action = new LongSwordChipAction(&player, chip.GetDamage());
+      action->SetElement(Element::FIRE);
+      player.RegisterComponent(action);
+    }, { "resources/spells/spell_sword_blades.png" } },
+    { "AirShot1", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new AirShotChipAction(&player, chip.GetDamage()));
+    }, { "resources/spells/AirShot.png" } },
+    { "Thunder", false, [](Player& player, Chip& chip) {
+      player.RegisterComponent(new ThunderChipAction(&player, chip.GetDamage()));
+    }, { nullptr } },
+
+    // Summons are used by the summon handler. Their textures are prefetched here.
+    { "Roll", true, nullptr, { "resources/spells/spell_roll.png", "resources/spells/spell_heart.png" } },
+    { "ProtoMan", false, nullptr, { "resources/spells/protoman_summon.png" } }
+  };
+
+  const PlayerChip* FindPlayerChip(const std::string& name) {
+    for (const PlayerChip& entry : PLAYER_CHIPS) {
+      bool match = entry.prefix ? name.compare(0, std::strlen(entry.name), entry.name) == 0 : name == entry.name;
+
+      if (match) return &entry;
+    }
+
+    return nullptr;
+  }
+}
 
 void PlayerChipUseListener::OnChipUse(Chip& chip, Character& character) {
   // Player charging is cancelled
   player->SetCharging(false);
 
   // Identify the chip by the name
-  std::string name = chip.GetShortName();
-
-  if (name.substr(0, 5) == "Recov") {
-    auto action = new RecoverChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "CrckPanel") {
-    // Crack the top, middle, and bottom row in front of player
-    Battle::Tile* top = player->GetField()->GetAt(player->GetTile()->GetX() + 1, 1);
-    Battle::Tile* mid = player->GetField()->GetAt(player->GetTile()->GetX() + 1, 2);
-    Battle::Tile* low = player->GetField()->GetAt(player->GetTile()->GetX() + 1, 3);
-
-    // If the tiles are valid, set their state to CRACKED
-    if (top) { top->SetState(TileState::CRACKED); }
-    if (mid) { mid->SetState(TileState::CRACKED); }
-    if (low) { low->SetState(TileState::CRACKED); }
-
-    AUDIO.Play(AudioType::PANEL_CRACK);
-  }
-  else if (name == "YoYo") {
-    auto action = new YoYoChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "Invis") {
-    // Create an invisible component. This handles the logic for timed invis
-    Component* invis = new Invis(player);
+  const PlayerChip* entry = FindPlayerChip(chip.GetShortName());
 
-    // Add the component to player
-    player->RegisterComponent(invis);
-  }
-  else if (name == "Rflctr1") {
-    auto action = new ReflectChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "Fishy") {
-    /**
-      * Fishy is two pieces: the Fishy attack and a HideUntil component
-      *
-      * The fishy moves right
-      *
-      * HideUntil is a special component that removes entity from play
-      * until a condition is met. This condition is defined in a
-      * HideUntill::Callback query functor.
-      *
-      * In this case, we hide until the fishy is deleted whether by
-      * reaching the end of the field or by a successful attack. The
-      * query functor will then return true.
-      *
-      * When HideUntill condition is met, the component will add the entity back
-      * in its original place and then removes itself from the component
-      * owner
-      */
-    Fishy* fishy = new Fishy(player->GetField(), player->GetTeam(), 1.0);
-    fishy->SetDirection(Direction::RIGHT);
-
-    // Condition to end hide
-    HideUntil::Callback until = [fishy]() { return fishy->IsDeleted(); };
-
-    // First argument is the entity to hide
-    // Second argument is the query functor
-    HideUntil* fishyStatus = new HideUntil(player, until);
-    player->RegisterComponent(fishyStatus);
-
-    Battle::Tile* tile = player->GetTile();
-
-    if (tile) {
-      this->player->GetField()->AddEntity(*fishy, tile->GetX(), tile->GetY());
-    }
-  }
-  else if (name == "XtrmeCnnon") {
-
-  }
-  else if (name == "TwinFang") {
-    auto action = new TwinFangChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "Tornado") {
-    auto action = new TornadoChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
+  if (entry && entry->use) {
+    entry->use(*player, chip);
   }
-  else if (name == "ElecSwrd") {
-    auto action = new ElecSwordChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name.substr(0, 7) == "FireBrn") {
-    auto type = FireBurn::Type(std::atoi(name.substr(7, 1).c_str()));
-    auto action = new FireBurnChipAction(player, type, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name.substr(0, 6) == "Vulcan") {
-    auto action = new VulcanChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name.size() >= 6 && name.substr(0, 6) == "Cannon") {
-    auto action = new CannonChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "MiniBomb") {
-    auto action = new BombChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "CrakShot") {
-    auto action = new CrackShotChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "Swrd") {
-    auto action = new SwordChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "Elecplse") {
-    // Spawn an elecpulse attack
-    auto onFinish = [this]() { this->player->SetAnimation(PLAYER_IDLE);  };
+}
 
-    player->SetAnimation(PLAYER_SHOOTING, onFinish);
+void PlayerChipUseListener::PrefetchAssets(const Chip& chip) {
+  const PlayerChip* entry = FindPlayerChip(chip.GetShortName());
 
-    Elecpulse* pulse = new Elecpulse(player->GetField(), player->GetTeam(), chip.GetDamage());
+  if (!entry) return;
 
-    AUDIO.Play(AudioType::ELECPULSE);
-
-    player->GetField()->AddEntity(*pulse, player->GetTile()->GetX() + 1, player->GetTile()->GetY());
-  }
-  else if (name == "LongSwrd") {
-    auto action = new LongSwordChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "WideSwrd") {
-    auto action = new WideSwordChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "FireSwrd") {
-    auto action = new LongSwordChipAction(player, chip.GetDamage());
-    action->SetElement(Element::FIRE);
-    player->RegisterComponent(action);
-  }
-  else if (name == "AirShot1") {
-    auto action = new AirShotChipAction(player, chip.GetDamage());
-    player->RegisterComponent(action);
-  }
-  else if (name == "Thunder") {
-    player->RegisterComponent(new ThunderChipAction(player, chip.GetDamage()));
+  for (const char* path : entry->textures) {
+    if (path) {
+      TEXTURES.PrefetchTexture(path);
+    }
   }
-}
\ No newline at end of file
+}
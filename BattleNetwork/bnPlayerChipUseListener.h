@@ -32,4 +32,10 @@ public:
    * @param character Character using chip
    */
   void OnChipUse(Chip& chip, Character& character);
+
+  /**
+   * @brief Start decoding the textures the chip's action will load so using it does not read files
+   * @param chip Chip that was selected
+   */
+  static void PrefetchAssets(const Chip& chip);
 };
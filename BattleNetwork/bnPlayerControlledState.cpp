@@ -97,7 +97,7 @@ void PlayerControlledState::OnUpdate(float _elapsed, Player& player) {
   if (player.state != PLAYER_IDLE)
     return;
 
-  static Direction direction = Direction::NONE;
+  static thread_local Direction direction = Direction::NONE;
   if (player.IsBattleActive()) {
     if (INPUT.Has(EventTypes::PRESSED_MOVE_UP) ||INPUT.Has(EventTypes::HELD_MOVE_UP)) {
       direction = Direction::UP;
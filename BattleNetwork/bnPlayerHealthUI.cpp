@@ -1,27 +1,32 @@
-#include <string>
-using std::to_string;
-
 #include "bnTile.h"
 #include "bnPlayerHealthUI.h"
 #include "bnTextureResourceManager.h"
 #include "bnAudioResourceManager.h"
 
+#define TEXTURE_PATH "resources/ui/img_health.png"
+
 PlayerHealthUI::PlayerHealthUI(Player* _player)
   : player(_player), UIComponent(_player),
-    BattleOverTrigger<Player>(_player, [this](BattleScene& scene, Player& player) { this->isBattleOver = true; }) 
+    BattleOverTrigger<Player>(_player, [this](BattleScene& scene, Player& player) { this->isBattleOver = true; }),
+    // Glyphs are 8x11. First glyph is 0 the last is 9. 1px space between colors
+    glyphs(LOAD_TEXTURE(PLAYER_HP_NUMSET), sf::Vector2i(8, 11), sf::Vector2i(0, 0), sf::Vector2i(8, 0))
 {
   
   // TODO: move this to the preloaded textures      
-  texture = TEXTURES.LoadTextureFromFile("resources/ui/img_health.png");
+  texture = TEXTURES.LoadTextureFromFile(TEXTURE_PATH);
   sprite.setTexture(*texture);
   sprite.setPosition(3.f, 0.0f);
   sprite.setScale(2.f, 2.f);
 
-  glyphs.setTexture(LOAD_TEXTURE(PLAYER_HP_NUMSET));
+  // Right aligned inside the box
   glyphs.setScale(2.f, 2.f);
+  glyphs.setPosition(sprite.getLocalBounds().width*sprite.getScale().x - 8.f, 6.0f);
+  glyphs.SetAlignment(GlyphNumber::Alignment::RIGHT);
 
   lastHP = currHP = startHP = _player->GetHealth();
 
+  glyphs.SetNumber(currHP);
+
   cooldown = 0;
 
   isBattleOver = false;
@@ -29,6 +34,7 @@ PlayerHealthUI::PlayerHealthUI(Player* _player)
 }
 
 PlayerHealthUI::~PlayerHealthUI() {
+  TEXTURES.ReleaseTexture(TEXTURE_PATH);
 }
 
 void PlayerHealthUI::Inject(BattleScene & scene)
@@ -40,42 +46,10 @@ void PlayerHealthUI::draw(sf::RenderTarget& target, sf::RenderStates states) con
   auto this_states = states;
   this_states.transform *= this->getTransform();
 
-  // Glyphs are 8x11
-  // First glyph is 0 the last is 9
-  // 1px space between colors
   target.draw(sprite, this_states);
 
-  const std::string currHPStr = std::to_string(currHP);
-
-  int size = (int)(currHPStr.size());
-  int hp = currHP;
-  float offsetx = -((size)*8.0f)*glyphs.getScale().x;
-  int index = 0;
-  while (index < size) {
-    const char c = currHPStr[index];
-    int number = std::atoi(&c);
-
-    int col = number*8;
-    int row = 0;
-
-    if (color == Color::ORANGE) {
-      row = 11;
-    }
-    else if (color == Color::GREEN) {
-      row = 22;
-    }
-
-    glyphs.setTextureRect(sf::IntRect(col, row, 8, 11));
-    glyphs.setPosition(sf::Vector2f(offsetx-8.f, 6.0f) + sf::Vector2f(sprite.getLocalBounds().width*sprite.getScale().x, 0.f));
-
-    // Draw using transforms from parent so we can attach this to the chip cust
-    target.draw(glyphs, this_states);
-
-    offsetx += 8.0f*glyphs.getScale().x;
-    
-    // Move onto the next number
-    index++;
-  }
+  // Draw using transforms from parent so we can attach this to the chip cust
+  target.draw(glyphs, this_states);
 
   UIComponent::draw(target, states);
 }
@@ -159,5 +133,17 @@ void PlayerHealthUI::OnUpdate(float elapsed) {
     } else if (currHP < player->GetHealth()) {
       color = Color::GREEN;
     }
+
+    int row = 0;
+
+    if (color == Color::ORANGE) {
+      row = 11;
+    }
+    else if (color == Color::GREEN) {
+      row = 22;
+    }
+
+    glyphs.SetNumber(currHP);
+    glyphs.SetZero(sf::Vector2i(0, row));
   }
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "bnBattleOverTrigger.h"
 #include "bnPlayer.h"
 #include "bnUIComponent.h"
+#include "bnGlyphNumber.h"
 
 class Entity;
 class Player;
@@ -67,7 +68,7 @@ private:
   int currHP; /*!< HP of target current frame */
   int startHP; /*!< HP of target when this component was attached */
   Player* player; /*!< target entity of type Player */
-  mutable Sprite glyphs; /*!< bitmap image object to draw */
+  GlyphNumber glyphs; /*!< health digits. Laid out again only when health or color changes */
   Sprite sprite; /*!< the box surrounding the health */
   Texture* texture; /*!< the texture of the box */
 
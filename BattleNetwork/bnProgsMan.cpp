@@ -80,3 +80,13 @@ void ProgsMan::SetAnimation(string _state, std::function<void()> onFinish) {
   animationComponent->SetAnimation(_state, onFinish);
   animationComponent->OnUpdate(0);
 }
+
+void ProgsMan::SaveState(BattleSnapshot& snapshot) const{
+  AI<ProgsMan>::SaveAI(snapshot);
+  Character::SaveState(snapshot);
+}
+
+void ProgsMan::LoadState(BattleSnapshot& snapshot){
+  AI<ProgsMan>::LoadAI(snapshot);
+  Character::LoadState(snapshot);
+}
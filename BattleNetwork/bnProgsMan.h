@@ -81,6 +81,18 @@ public:
    * @return const float
    */
   const float GetHeight() const;
+
+  /**
+   * @brief Saves the AI and then the character
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back the state written by SaveState()
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
 private:
   AnimationComponent* animationComponent; /*!< component animates entities*/
 
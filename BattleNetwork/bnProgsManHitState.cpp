@@ -1,6 +1,7 @@
 #include "bnProgsManHitState.h"
 #include "bnProgsManIdleState.h"
 #include "bnProgsMan.h"
+#include "bnBattleSnapshot.h"
 
 
 ProgsManHitState::ProgsManHitState() : cooldown(0.5f), AIState<ProgsMan>()
@@ -24,4 +25,12 @@ void ProgsManHitState::OnUpdate(float _elapsed, ProgsMan& progs) {
   }
 }
 
-void ProgsManHitState::OnLeave(ProgsMan& progs) {}
\ No newline at end of file
+void ProgsManHitState::OnLeave(ProgsMan& progs) {}
+
+void ProgsManHitState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(cooldown);
+}
+
+void ProgsManHitState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(cooldown);
+}
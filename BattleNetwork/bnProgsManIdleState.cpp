@@ -1,6 +1,7 @@
 #include "bnProgsManIdleState.h"
 #include "bnProgsManMoveState.h"
 #include "bnProgsMan.h"
+#include "bnBattleSnapshot.h"
 
 
 ProgsManIdleState::ProgsManIdleState() : cooldown(0.5f), AIState<ProgsMan>()
@@ -24,4 +25,12 @@ void ProgsManIdleState::OnUpdate(float _elapsed, ProgsMan& progs) {
   }
 }
 
-void ProgsManIdleState::OnLeave(ProgsMan& progs) {}
\ No newline at end of file
+void ProgsManIdleState::OnLeave(ProgsMan& progs) {}
+
+void ProgsManIdleState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(cooldown);
+}
+
+void ProgsManIdleState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(cooldown);
+}
@@ -7,6 +7,8 @@
 #include "bnProgsManPunchState.h"
 #include "bnProgsManThrowState.h"
 #include "bnProgsManShootState.h"
+#include "bnBattleContext.h"
+#include "bnBattleSnapshot.h"
 
 ProgsManMoveState::ProgsManMoveState() : isMoving(false), AIState<ProgsMan>() { ; }
 ProgsManMoveState::~ProgsManMoveState() { ; }
@@ -22,7 +24,7 @@ void ProgsManMoveState::OnUpdate(float _elapsed, ProgsMan& progs) {
   Battle::Tile* temp = progs.GetTile();
   Battle::Tile* next = nullptr;
 
-  int random = rand() % 50;
+  int random = BattleContext::Rand() % 50;
 
   // Always punch obstacles
   Battle::Tile* tile = progs.GetField()->GetAt(progs.GetTile()->GetX() - 1, progs.GetTile()->GetY());
@@ -40,7 +42,7 @@ void ProgsManMoveState::OnUpdate(float _elapsed, ProgsMan& progs) {
           progs.ChangeState<ProgsManPunchState>();
           return;
         }
-        else if (rand() % 50 > 30) {
+        else if (BattleContext::Rand() % 50 > 30) {
           // Throw bombs.
           progs.ChangeState<ProgsManThrowState>();
           return;
@@ -51,7 +53,7 @@ void ProgsManMoveState::OnUpdate(float _elapsed, ProgsMan& progs) {
           return;
         }
       }
-      else if (rand() % 50 > 20) {
+      else if (BattleContext::Rand() % 50 > 20) {
         // Throw bombs.
         progs.ChangeState<ProgsManThrowState>();
         return;
@@ -73,7 +75,7 @@ void ProgsManMoveState::OnUpdate(float _elapsed, ProgsMan& progs) {
   }
 
   // otherwise aimlessly move around 
-  int randDirection = rand() % 4;
+  int randDirection = BattleContext::Rand() % 4;
 
   if (nextDirection == Direction::NONE) {
     nextDirection = static_cast<Direction>(randDirection + 1);
@@ -97,3 +99,12 @@ void ProgsManMoveState::OnLeave(ProgsMan& progs) {
 
 }
 
+void ProgsManMoveState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(nextDirection);
+  snapshot.Write(isMoving);
+}
+
+void ProgsManMoveState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(nextDirection);
+  snapshot.Read(isMoving);
+}
@@ -1,6 +1,7 @@
 #include "bnProgsManThrowState.h"
 #include "bnProgsMan.h"
 #include "bnProgBomb.h"
+#include "bnBattleSnapshot.h"
 
 ProgsManThrowState::ProgsManThrowState() : AIState<ProgsMan>()
 {
@@ -55,4 +56,12 @@ void ProgsManThrowState::OnUpdate(float _elapsed, ProgsMan& progs) {
   if(progs.GetTarget() && progs.GetTarget()->GetTile()) {
     lastTargetPos = progs.GetTarget()->GetTile();
   }
-}
\ No newline at end of file
+}
+
+void ProgsManThrowState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(lastTargetPos);
+}
+
+void ProgsManThrowState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(lastTargetPos);
+}
@@ -10,14 +10,16 @@
 #include "bnSwordEffect.h"
 
 #include "bnChipSummonHandler.h"
+#include "bnBattleContext.h"
 
 #define RESOURCE_PATH "resources/spells/protoman_summon.animation"
+#define TEXTURE_PATH "resources/spells/protoman_summon.png"
 
 ProtoManSummon::ProtoManSummon(ChipSummonHandler* _summons) : Spell(_summons->GetCaller()->GetField(), _summons->GetCaller()->GetTeam())
 {
   summons = _summons;
   SetPassthrough(true);
-  random = rand() % 20 - 20;
+  random = BattleContext::Rand() % 20 - 20;
 
   int lr = (team == Team::RED) ? 1 : -1;
   setScale(2.0f*lr, 2.0f);
@@ -28,37 +30,28 @@ ProtoManSummon::ProtoManSummon(ChipSummonHandler* _summons) : Spell(_summons->Ge
 
   AUDIO.Play(AudioType::APPEAR);
 
-  setTexture(*TEXTURES.LoadTextureFromFile("resources/spells/protoman_summon.png"), true);
+  setTexture(*TEXTURES.LoadTextureFromFile(TEXTURE_PATH), true);
 
   animationComponent = new AnimationComponent(this);
   this->RegisterComponent(animationComponent);
   animationComponent->Setup(RESOURCE_PATH);
   animationComponent->Load();
 
-  Battle::Tile* next = nullptr;
+  field->ForEachTile([this, _summons](Battle::Tile* next) {
+    if (next->ContainsEntityType<Character>() && !next->ContainsEntityType<Obstacle>() && next->GetTeam() != this->GetTeam()) {
+      Battle::Tile* prev = field->GetAt(next->GetX() - 1, next->GetY());
 
-  auto allTiles = field->FindTiles([](Battle::Tile* tile) { return true; });
-  auto iter = allTiles.begin();
+      bool blocked = !prev->IsWalkable();
 
-  while (iter != allTiles.end()) {
-    next = (*iter);
+      prev->ForEachEntity([_summons, &blocked](Entity* in) {
+        blocked = blocked || (_summons->GetCaller() != in && (dynamic_cast<Character*>(in) && in->GetTeam() != Team::UNKNOWN));
+      });
 
-	  if (next->ContainsEntityType<Character>() && !next->ContainsEntityType<Obstacle>() && next->GetTeam() != this->GetTeam()) {
-		Battle::Tile* prev = field->GetAt(next->GetX() - 1, next->GetY());
-
-		auto characters = prev->FindEntities([_summons](Entity* in) {
-			return _summons->GetCaller() != in && (dynamic_cast<Character*>(in)  && in->GetTeam() != Team::UNKNOWN);
-		});
-
-	    bool blocked = (characters.size() > 0) || !prev->IsWalkable();
-
-	    if(!blocked) {
-			targets.push_back(next);
-	    }
-	  }
-
-    iter++;
-  }
+      if (!blocked) {
+        targets.push_back(next);
+      }
+    }
+  });
 
   // TODO: noodely callbacks desgin might be best abstracted by ActionLists
   animationComponent->SetAnimation("APPEAR", [this] {
@@ -76,6 +69,7 @@ ProtoManSummon::ProtoManSummon(ChipSummonHandler* _summons) : Spell(_summons->Ge
 }
 
 ProtoManSummon::~ProtoManSummon() {
+  TEXTURES.ReleaseTexture(TEXTURE_PATH);
 }
 
 void ProtoManSummon::DoAttackStep() {
@@ -18,6 +18,7 @@
 #include "bnStarfishIdleState.h"
 #include "bnUndernetBackground.h"
 #include "bnMetrid.h"
+#include "bnBattleContext.h"
 
 RandomMettaurMob::RandomMettaurMob(Field* field) : MobFactory(field)
 {
@@ -36,7 +37,7 @@ Mob* RandomMettaurMob::Build() {
 
   mob->RegisterRankedReward(3, BattleItem(Chip(82, 154, '*', 0, Element::NONE, "AreaGrab", "Defends and reflects", "Press A to bring up a shield that protects you and reflects damage.", 2)));
 
-  bool AllIce = (rand() % 50 > 45);
+  bool AllIce = (BattleContext::Rand() % 50 > 45);
   bool spawnedGroundEnemy = false;
   int mysterycount = 0;
 
@@ -45,7 +46,7 @@ Mob* RandomMettaurMob::Build() {
       for (int j = 0; j < field->GetHeight(); j++) {
         Battle::Tile* tile = field->GetAt(i + 1, j + 1);
 
-        if (tile->GetTeam() == Team::BLUE && !tile->ContainsEntityType<Character>() && rand() % 10 == 0) {
+        if (tile->GetTeam() == Team::BLUE && !tile->ContainsEntityType<Character>() && BattleContext::Rand() % 10 == 0) {
           mob->Spawn<Rank1<Metrid>>(i + 1, j + 1);
         }
       }
@@ -57,16 +58,16 @@ Mob* RandomMettaurMob::Build() {
 
         Battle::Tile* tile = field->GetAt(i + 1, j + 1);
 
-        if(rand() % 10 > 5 && i !=2 && j != 2) {
-          TileState randState = (TileState)(rand() % 7);
+        if(BattleContext::Rand() % 10 > 5 && i !=2 && j != 2) {
+          TileState randState = (TileState)(BattleContext::Rand() % 7);
           tile->SetState(randState);
         }
 
         if (AllIce) { tile->SetState(TileState::ICE); }
 
         if (tile->GetTeam() == Team::BLUE && !tile->ContainsEntityType<Character>() && !tile->ContainsEntityType<MysteryData>()) {
-          if (rand() % 50 > 30) {
-            if (rand() % 100 > 90 && mysterycount < 3) {
+          if (BattleContext::Rand() % 50 > 30) {
+            if (BattleContext::Rand() % 100 > 90 && mysterycount < 3) {
               MysteryData* mystery = new MysteryData(mob->GetField(), Team::UNKNOWN);
               field->AddEntity(*mystery, tile->GetX(), tile->GetY());
 
@@ -81,8 +82,8 @@ Mob* RandomMettaurMob::Build() {
 
               mysterycount++;
             }
-            else if (rand() % 10 > 2) {
-              if (rand() % 10 > 5) {
+            else if (BattleContext::Rand() % 10 > 2) {
+              if (BattleContext::Rand() % 10 > 5) {
                 mob->Spawn<RankSP<Mettaur>>(i + 1, j + 1);
               }
               else {
@@ -91,19 +92,19 @@ Mob* RandomMettaurMob::Build() {
 
               spawnedGroundEnemy = true;
             }
-            else if (rand() % 10 > 3) {
-              if (rand() % 10 > 0) {
+            else if (BattleContext::Rand() % 10 > 3) {
+              if (BattleContext::Rand() % 10 > 0) {
                 mob->Spawn<Rank1<Starfish>>(i + 1, j + 1);
               }
-              else if (rand() % 10 > 4) {
+              else if (BattleContext::Rand() % 10 > 4) {
                 mob->Spawn<Rank3<Canodumb>>(i + 1, j + 1);
               }
 
               spawnedGroundEnemy = true;
 
             }
-            else if (rand() % 100 < 10) {
-              if (rand() % 10 > 5) {
+            else if (BattleContext::Rand() % 100 < 10) {
+              if (BattleContext::Rand() % 10 > 5) {
                 mob->Spawn<Rank1<ProgsMan>>(i + 1, j + 1);
               }
               else {
@@ -113,7 +114,7 @@ Mob* RandomMettaurMob::Build() {
               spawnedGroundEnemy = true;
 
             }
-            else if (rand() % 10 > 3) {
+            else if (BattleContext::Rand() % 10 > 3) {
               mob->Spawn<ChipsSpawnPolicy<MetalMan>>(i + 1, j + 1);
             }
           }
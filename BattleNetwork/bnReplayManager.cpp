@@ -0,0 +1,336 @@
+#include <Swoosh/ActivityController.h>
+#include "bnReplayManager.h"
+#include "bnBattleScene.h"
+#include "bnNaviRegistration.h"
+#include "bnMobRegistration.h"
+#include "bnChipLibrary.h"
+#include "bnEngine.h"
+#include "bnLogger.h"
+
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <time.h>
+
+namespace {
+  void WriteU32(std::ofstream& out, uint32_t value) {
+    char bytes[4] = { (char)(value & 0xFF), (char)((value >> 8) & 0xFF), (char)((value >> 16) & 0xFF), (char)((value >> 24) & 0xFF) };
+    out.write(bytes, 4);
+  }
+
+  bool ReadU32(std::ifstream& in, uint32_t& value) {
+    unsigned char bytes[4];
+
+    if (!in.read((char*)bytes, 4)) return false;
+
+    value = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    return true;
+  }
+
+  const char REPLAY_MAGIC[4] = { 'O', 'B', 'N', 'R' };
+}
+
+const bool BattleReplay::Save(const std::string& path) const {
+  std::ofstream out(path, std::ios::binary);
+
+  if (!out) return false;
+
+  out.write(REPLAY_MAGIC, 4);
+  WriteU32(out, REPLAY_FILE_VERSION);
+  WriteU32(out, seed);
+  WriteU32(out, (uint32_t)navi);
+  WriteU32(out, (uint32_t)mob);
+
+  WriteU32(out, (uint32_t)folder.size());
+
+  for (auto& chip : folder) {
+    out.put(chip.code);
+    WriteU32(out, (uint32_t)chip.name.size());
+    out.write(chip.name.data(), chip.name.size());
+  }
+
+  WriteU32(out, frameCount);
+  WriteU32(out, (uint32_t)inputs.size());
+
+  for (auto& input : inputs) {
+    WriteU32(out, input.frame);
+    WriteU32(out, input.pressed);
+    WriteU32(out, input.held);
+    WriteU32(out, input.released);
+  }
+
+  return (bool)out;
+}
+
+bool BattleReplay::Load(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+
+  if (!in) return false;
+
+  char magic[4];
+  uint32_t version = 0, value = 0, count = 0;
+
+  if (!in.read(magic, 4) || !std::equal(magic, magic + 4, REPLAY_MAGIC)) return false;
+  if (!ReadU32(in, version) || version != REPLAY_FILE_VERSION) return false;
+
+  if (!ReadU32(in, seed)) return false;
+  if (!ReadU32(in, value)) return false;
+  navi = (int32_t)value;
+  if (!ReadU32(in, value)) return false;
+  mob = (int32_t)value;
+
+  if (!ReadU32(in, count)) return false;
+
+  folder.clear();
+
+  for (uint32_t i = 0; i < count; i++) {
+    ReplayChip chip;
+    uint32_t length = 0;
+
+    if (!in.get(chip.code) || !ReadU32(in, length)) return false;
+
+    chip.name.resize(length);
+
+    if (!in.read(&chip.name[0], length)) return false;
+
+    folder.push_back(chip);
+  }
+
+  if (!ReadU32(in, frameCount)) return false;
+  if (!ReadU32(in, count)) return false;
+
+  inputs.clear();
+  inputs.reserve(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    ReplayInput input;
+
+    if (!ReadU32(in, input.frame) || !ReadU32(in, input.pressed) || !ReadU32(in, input.held) || !ReadU32(in, input.released)) {
+      return false;
+    }
+
+    inputs.push_back(input);
+  }
+
+  return true;
+}
+
+void BattleReplay::MakeFolder(ChipFolder& out) const {
+  for (auto& chip : folder) {
+    out.AddChip(CHIPLIB.GetChipEntry(chip.name, chip.code));
+  }
+}
+
+ReplayManager& ReplayManager::GetInstance() {
+  static ReplayManager instance;
+  return instance;
+}
+
+ReplayManager::ReplayManager() : mode(Mode::NONE), battleFrame(0), cursor(0) {
+}
+
+ReplayManager::~ReplayManager() {
+}
+
+void ReplayManager::EnableRecording(const std::string& dir) {
+  recordDir = dir;
+
+  if (!recordDir.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(recordDir, error);
+  }
+}
+
+const unsigned ReplayManager::SeedBattle() {
+  static unsigned battles = 0;
+
+  unsigned seed = (unsigned)time(nullptr) ^ (++battles * 2654435761u);
+  srand(seed);
+
+  return seed;
+}
+
+void ReplayManager::BeginRecording(unsigned seed, int navi, int mob, ChipFolder& folder) {
+  if (recordDir.empty() || mode == Mode::PLAYBACK) return;
+
+  replay = BattleReplay();
+  replay.seed = seed;
+  replay.navi = navi;
+  replay.mob = mob;
+
+  for (auto iter = folder.Begin(); iter != folder.End(); iter++) {
+    replay.folder.push_back(ReplayChip{ (*iter)->GetShortName(), (*iter)->GetCode() });
+  }
+
+  mode = Mode::RECORD;
+  battleFrame = 0;
+}
+
+void ReplayManager::BeginPlayback(const BattleReplay& replay) {
+  this->replay = replay;
+  mode = Mode::PLAYBACK;
+  battleFrame = 0;
+  cursor = 0;
+}
+
+void ReplayManager::Step() {
+  if (mode == Mode::NONE) return;
+
+  if (battleFrame == 0) {
+    srand(replay.seed);
+  }
+
+  if (mode == Mode::RECORD) {
+    const InputFrame& state = INPUT.GetFrameState();
+
+    ReplayInput input;
+    input.frame = battleFrame;
+    input.pressed = (uint32_t)state.pressed.to_ulong();
+    input.held = (uint32_t)state.held.to_ulong();
+    input.released = (uint32_t)state.released.to_ulong();
+
+    bool changed = replay.inputs.empty();
+
+    if (!changed) {
+      const ReplayInput& last = replay.inputs.back();
+      changed = last.pressed != input.pressed || last.held != input.held || last.released != input.released;
+    }
+
+    if (changed) {
+      replay.inputs.push_back(input);
+    }
+
+    replay.frameCount = battleFrame + 1;
+  }
+  else if (mode == Mode::PLAYBACK) {
+    while (cursor + 1 < replay.inputs.size() && replay.inputs[cursor + 1].frame <= battleFrame) {
+      cursor++;
+    }
+
+    InputFrame state;
+    state.frame = INPUT.GetFrame();
+
+    if (cursor < replay.inputs.size() && replay.inputs[cursor].frame <= battleFrame) {
+      const ReplayInput& input = replay.inputs[cursor];
+      state.pressed = std::bitset<INPUT_ACTION_COUNT>(input.pressed);
+      state.held = std::bitset<INPUT_ACTION_COUNT>(input.held);
+      state.released = std::bitset<INPUT_ACTION_COUNT>(input.released);
+    }
+
+    INPUT.OverrideFrame(state);
+  }
+
+  battleFrame++;
+}
+
+void ReplayManager::EndBattle() {
+  if (mode == Mode::RECORD && replay.frameCount > 0) {
+    std::string path = recordDir + "/replay_" + std::to_string(replay.seed) + REPLAY_FILE_EXTENSION;
+
+    Logger::GetMutex()->lock();
+
+    if (replay.Save(path)) {
+      Logger::Logf("Saved replay %s: %u frames, %u input changes", path.c_str(), replay.frameCount, (unsigned)replay.inputs.size());
+    }
+    else {
+      Logger::Logf("Failed to save replay %s", path.c_str());
+    }
+
+    Logger::GetMutex()->unlock();
+  }
+
+  mode = Mode::NONE;
+}
+
+const bool ReplayManager::IsPlaybackDone() const {
+  return mode != Mode::PLAYBACK || battleFrame >= replay.frameCount;
+}
+
+const bool ReplayManager::IsActive() const {
+  return mode != Mode::NONE;
+}
+
+int ReplayManager::RunBenchmark(const std::string& dir, const sf::Vector2u& virtualWindowSize, double step) {
+  std::vector<std::string> paths;
+  std::error_code error;
+
+  for (auto& entry : std::filesystem::directory_iterator(dir, error)) {
+    if (entry.path().extension() == REPLAY_FILE_EXTENSION) {
+      paths.push_back(entry.path().string());
+    }
+  }
+
+  std::sort(paths.begin(), paths.end());
+
+  int failed = 0;
+
+  sf::RenderTexture surface;
+  surface.create(virtualWindowSize.x, virtualWindowSize.y);
+
+  std::cout << "replay,file,frames,p50_us,p90_us,p99_us,max_us" << std::endl;
+
+  for (auto& path : paths) {
+    BattleReplay battle;
+
+    if (!battle.Load(path) || battle.navi < 0 || battle.navi >= (int)NAVIS.Size() || battle.mob < 0 || battle.mob >= (int)MOBS.Size()) {
+      Logger::Logf("Skipping replay %s: could not load or references missing data", path.c_str());
+      failed++;
+      continue;
+    }
+
+    ChipFolder folder;
+    battle.MakeFolder(folder);
+
+    Player* player = NAVIS.At(battle.navi).GetNavi();
+
+    srand(battle.seed);
+    Mob* mob = MOBS.At(battle.mob).GetMob();
+
+    std::vector<sf::Int64> frameTimes;
+    frameTimes.reserve(battle.frameCount);
+
+    {
+      swoosh::ActivityController app(*ENGINE.GetWindow(), virtualWindowSize);
+
+      BeginPlayback(battle);
+      app.push<BattleScene>(player, mob, &folder);
+
+      sf::Clock clock;
+
+      while (!IsPlaybackDone() && ENGINE.Running()) {
+        // Keep the window responsive. Recorded input replaces whatever was polled.
+        INPUT.Update();
+
+        clock.restart();
+
+        app.update(step);
+        app.draw(surface);
+        surface.display();
+
+        frameTimes.push_back(clock.getElapsedTime().asMicroseconds());
+      }
+
+      EndBattle();
+    }
+
+    delete mob;
+
+    if (frameTimes.empty()) {
+      failed++;
+      continue;
+    }
+
+    std::sort(frameTimes.begin(), frameTimes.end());
+
+    auto percentile = [&frameTimes](double p) {
+      size_t index = (size_t)(p * (double)(frameTimes.size() - 1));
+      return frameTimes[index];
+    };
+
+    std::cout << "replay," << path << "," << frameTimes.size() << ","
+      << percentile(0.50) << "," << percentile(0.90) << "," << percentile(0.99) << "," << frameTimes.back() << std::endl;
+  }
+
+  return failed;
+}
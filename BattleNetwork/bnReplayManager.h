@@ -0,0 +1,157 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "bnInputManager.h"
+#include "bnChipFolder.h"
+
+// File extension for recorded battles
+#define REPLAY_FILE_EXTENSION ".obnr"
+
+// Bump when the binary layout changes
+#define REPLAY_FILE_VERSION 1
+
+/*! \brief Input bits for a run of frames. Only written when the input changes */
+struct ReplayInput {
+  uint32_t frame{ 0 }; /*!< first battle frame this input applies to */
+  uint32_t pressed{ 0 }, held{ 0 }, released{ 0 }; /*!< InputFrame bitsets */
+};
+
+/*! \brief A chip in the folder by library key */
+struct ReplayChip {
+  std::string name;
+  char code{ '*' };
+};
+
+/*! \brief Everything needed to play a battle back the same way */
+struct BattleReplay {
+  uint32_t seed{ 0 }; /*!< passed to srand() before the mob is made and on the first battle frame */
+  int32_t navi{ 0 }; /*!< index into NAVIS */
+  int32_t mob{ 0 }; /*!< index into MOBS */
+  std::vector<ReplayChip> folder; /*!< folder in shuffled order */
+  uint32_t frameCount{ 0 }; /*!< battle frames recorded */
+  std::vector<ReplayInput> inputs; /*!< input changes in frame order */
+
+  /**
+   * @brief Write to a compact little-endian binary file
+   * @return true if the file was written
+   */
+  const bool Save(const std::string& path) const;
+
+  /**
+   * @brief Read a file written by Save()
+   * @return true if the file was valid
+   */
+  bool Load(const std::string& path);
+
+  /**
+   * @brief Build a folder in the recorded order from CHIPLIB entries
+   * @param folder empty folder to fill
+   */
+  void MakeFolder(ChipFolder& folder) const;
+};
+
+/**
+ * @class ReplayManager
+ * @author mav
+ * @date 10/19/20
+ * @brief Records battle input and plays it back frame by frame
+ *
+ * SelectMobScene seeds the RNG and calls BeginRecording() before making the mob.
+ * BattleScene calls Step() at the start of every update. While recording, Step()
+ * stores the InputManager state for that frame. While playing back, it replaces
+ * the InputManager state with the recorded one.
+ *
+ * RunBenchmark() plays a directory of replays with no frame limiter and
+ * reports frame time percentiles for each.
+ */
+class ReplayManager {
+public:
+  /**
+   * @brief If first call, initializes the manager and returns it
+   * @return ReplayManager&
+   */
+  static ReplayManager& GetInstance();
+
+  /**
+   * @brief Write a replay file for every battle into the directory
+   * @param dir folder to write to. Empty disables recording.
+   */
+  void EnableRecording(const std::string& dir);
+
+  /**
+   * @brief Make a seed for the next battle and pass it to srand()
+   * @return seed to hand to BeginRecording()
+   */
+  const unsigned SeedBattle();
+
+  /**
+   * @brief Start recording the next battle. Does nothing if recording is disabled.
+   * @param seed seed returned by SeedBattle()
+   * @param navi index into NAVIS
+   * @param mob index into MOBS
+   * @param folder the shuffled folder handed to BattleScene
+   */
+  void BeginRecording(unsigned seed, int navi, int mob, ChipFolder& folder);
+
+  /**
+   * @brief Play the replay into the next battle
+   * @param replay
+   */
+  void BeginPlayback(const BattleReplay& replay);
+
+  /**
+   * @brief Record or play back one battle frame
+   *
+   * Reseeds the RNG on the first frame so the battle does not depend on
+   * how many frames the scene transition took.
+   */
+  void Step();
+
+  /**
+   * @brief Save the recording, if any, and stop
+   */
+  void EndBattle();
+
+  /**
+   * @brief True if every recorded frame has been played
+   */
+  const bool IsPlaybackDone() const;
+
+  /**
+   * @brief True if recording or playing back
+   */
+  const bool IsActive() const;
+
+  /**
+   * @brief Run every replay in the directory as fast as possible
+   *
+   * Prints one line per replay to stdout:
+   * replay,<file>,<frames>,<p50 us>,<p90 us>,<p99 us>,<max us>
+   * @param dir directory of replay files
+   * @param virtualWindowSize size of the activity controller surface
+   * @param step seconds per frame, the same fixed step the game loop uses
+   * @return number of replays that failed to load
+   */
+  int RunBenchmark(const std::string& dir, const sf::Vector2u& virtualWindowSize, double step);
+
+private:
+  enum class Mode : int {
+    NONE,
+    RECORD,
+    PLAYBACK
+  };
+
+  ReplayManager();
+  ~ReplayManager();
+
+  Mode mode;
+  std::string recordDir; /*!< where recordings go. Empty if disabled. */
+  BattleReplay replay; /*!< battle being recorded or played */
+  uint32_t battleFrame; /*!< frames stepped this battle */
+  size_t cursor; /*!< index into replay.inputs during playback */
+};
+
+/*! \brief Shorthand to get instance of the manager */
+#define REPLAYS ReplayManager::GetInstance()
@@ -10,15 +10,17 @@
 
 #include "bnChipSummonHandler.h"
 #include "bnRollHeart.h"
+#include "bnBattleContext.h"
 
 #define RESOURCE_PATH "resources/spells/spell_roll.animation"
+#define TEXTURE_PATH "resources/spells/spell_roll.png"
 
 RollHeal::RollHeal(ChipSummonHandler* _summons, int _heal) : Spell(_summons->GetCaller()->GetField(), _summons->GetCaller()->GetTeam())
 {
   summons = _summons;
   SetPassthrough(true);
 
-  random = rand() % 20 - 20;
+  random = BattleContext::Rand() % 20 - 20;
 
   heal = _heal;
 
@@ -31,7 +33,7 @@ RollHeal::RollHeal(ChipSummonHandler* _summons, int _heal) : Spell(_summons->Get
 
   AUDIO.Play(AudioType::APPEAR);
 
-  setTexture(*TEXTURES.LoadTextureFromFile("resources/spells/spell_roll.png"), true);
+  setTexture(*TEXTURES.LoadTextureFromFile(TEXTURE_PATH), true);
 
   animationComponent = new AnimationComponent(this);
   this->RegisterComponent(animationComponent);
@@ -62,30 +64,22 @@ RollHeal::RollHeal(ChipSummonHandler* _summons, int _heal) : Spell(_summons->Get
 
       bool found = false;
 
-      Battle::Tile* next = nullptr;
       Battle::Tile* attack = nullptr;
 
-      auto allTiles = field->FindTiles([](Battle::Tile* tile) { return true; });
-      auto iter = allTiles.begin();
+      field->ForEachTile([this, &found, &attack](Battle::Tile* tile) {
+        if (found) return;
 
-      while (iter != allTiles.end()) {
-        Battle::Tile* tile = (*iter);
+        if (tile->ContainsEntityType<Character>() && tile->GetTeam() != this->GetTeam()) {
+          this->GetTile()->RemoveEntityByID(this->GetID());
 
-        if (!found) {
-          if (next->ContainsEntityType<Character>() && next->GetTeam() != this->GetTeam()) {
-            this->GetTile()->RemoveEntityByID(this->GetID());
+          Battle::Tile* prev = field->GetAt(tile->GetX() - 1, tile->GetY());
+          prev->AddEntity(*this);
 
-            Battle::Tile* prev = field->GetAt(next->GetX() - 1, next->GetY());
-            prev->AddEntity(*this);
+          attack = tile;
 
-            attack = next;
-
-            found = true;
-          }
+          found = true;
         }
-
-        iter++;
-      }
+      });
 
       if (found) {
         this->animationComponent->SetAnimation("ROLL_ATTACKING", [this] {
@@ -112,6 +106,7 @@ RollHeal::RollHeal(ChipSummonHandler* _summons, int _heal) : Spell(_summons->Get
 }
 
 RollHeal::~RollHeal() {
+  TEXTURES.ReleaseTexture(TEXTURE_PATH);
 }
 
 void RollHeal::OnUpdate(float _elapsed) {
@@ -133,10 +128,10 @@ void RollHeal::Attack(Character* _entity) {
 
       int i = 1;
 
-      if (rand() % 2 == 0) i = -1;
+      if (BattleContext::Rand() % 2 == 0) i = -1;
 
       if (_entity) {
-        _entity->setPosition(_entity->getPosition().x + (i*(rand() % 4)), _entity->getPosition().y + (i*(rand() % 4)));
+        _entity->setPosition(_entity->getPosition().x + (i*(BattleContext::Rand() % 4)), _entity->getPosition().y + (i*(BattleContext::Rand() % 4)));
       }
 
       AUDIO.Play(AudioType::HURT);
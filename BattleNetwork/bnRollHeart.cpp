@@ -9,6 +9,7 @@
 #include "bnAudioResourceManager.h"
 
 #define RESOURCE_PATH "resources/spells/spell_heart.animation"
+#define TEXTURE_PATH "resources/spells/spell_heart.png"
 
 RollHeart::RollHeart(ChipSummonHandler* _summons, int _heal) : heal(_heal), Spell(_summons->GetCaller()->GetField(), _summons->GetCallerTeam())
 {
@@ -26,7 +27,7 @@ RollHeart::RollHeart(ChipSummonHandler* _summons, int _heal) : heal(_heal), Spel
 
   this->field->AddEntity(*this, _tile->GetX(), _tile->GetY());
 
-  setTexture(*TEXTURES.LoadTextureFromFile("resources/spells/spell_heart.png"), true);
+  setTexture(*TEXTURES.LoadTextureFromFile(TEXTURE_PATH), true);
   animationComponent = new AnimationComponent(this);
   this->RegisterComponent(animationComponent);
   animationComponent->Setup(RESOURCE_PATH);
@@ -38,6 +39,7 @@ RollHeart::RollHeart(ChipSummonHandler* _summons, int _heal) : heal(_heal), Spel
 }
 
 RollHeart::~RollHeart() {
+  TEXTURES.ReleaseTexture(TEXTURE_PATH);
 }
 
 void RollHeart::OnUpdate(float _elapsed) {
@@ -0,0 +1,80 @@
+#pragma once
+#include "bnDirection.h"
+
+// Most commands one script update can queue. Extra commands are dropped.
+#define SCRIPT_COMMAND_CAPACITY 16
+
+/*! \brief Spells a script can spawn */
+enum class ScriptSpell : int {
+  WAVE
+};
+
+enum class ScriptCommandType : int {
+  MOVE,    // Move one tile and play an animation until the move is done
+  ANIMATE, // Play an animation
+  COUNTER, // Make frames of the current animation counterable
+  SPAWN,   // Spawn a spell relative to the character's tile
+  END_TURN // Pass the turn to the next scripted character
+};
+
+struct ScriptCommand {
+  ScriptCommandType type;
+  Direction direction;
+  ScriptSpell spell;
+  int a, b; /*!< animation index, counter frame range or tile offset */
+};
+
+/**
+ * @class ScriptCommandBuffer
+ * @author mav
+ * @date 10/19/20
+ * @brief Commands a script queues during one update. Applied by C++ after the script returns.
+ *
+ * Each scripted entity owns one buffer for its lifetime and hands the same lua object
+ * to every update. Queuing a command is one call into C++ with numbers only and
+ * nothing is allocated.
+ */
+class ScriptCommandBuffer {
+public:
+  void Move(Direction direction, int animation) {
+    Push({ ScriptCommandType::MOVE, direction, ScriptSpell::WAVE, animation, 0 });
+  }
+
+  void Animate(int animation) {
+    Push({ ScriptCommandType::ANIMATE, Direction::NONE, ScriptSpell::WAVE, animation, 0 });
+  }
+
+  void Counter(int first, int last) {
+    Push({ ScriptCommandType::COUNTER, Direction::NONE, ScriptSpell::WAVE, first, last });
+  }
+
+  void Spawn(ScriptSpell spell, int dx, int dy, Direction direction) {
+    Push({ ScriptCommandType::SPAWN, direction, spell, dx, dy });
+  }
+
+  void EndTurn() {
+    Push({ ScriptCommandType::END_TURN, Direction::NONE, ScriptSpell::WAVE, 0, 0 });
+  }
+
+  void Clear() {
+    count = 0;
+  }
+
+  const unsigned GetCount() const {
+    return count;
+  }
+
+  const ScriptCommand& operator[](unsigned index) const {
+    return commands[index];
+  }
+
+private:
+  void Push(const ScriptCommand& command) {
+    if (count < SCRIPT_COMMAND_CAPACITY) {
+      commands[count++] = command;
+    }
+  }
+
+  ScriptCommand commands[SCRIPT_COMMAND_CAPACITY];
+  unsigned count{ 0 };
+};
@@ -3,6 +3,12 @@
 #include "bnScriptedCharacter.h"
 #include "bnElements.h"
 #include "bnScriptedChipAction.h"
+#include "bnVirtualFileSystem.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 
 // Building the c lib on windows failed. 
 // Including the c files directly into source avoids static linking
@@ -41,6 +47,36 @@
 #include <lvm.c>
 #include <lzio.c>
 
+namespace {
+  /*! \brief FNV-1a over the source. Names the cached chunk. */
+  const uint64_t HashSource(const std::string& source) {
+    uint64_t hash = 14695981039346656037ull;
+
+    for (unsigned char c : source) {
+      hash ^= c;
+      hash *= 1099511628211ull;
+    }
+
+    return hash;
+  }
+
+  const std::string CachePath(uint64_t hash) {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+
+    return std::string(SCRIPT_CACHE_PATH) + name + SCRIPT_CACHE_EXTENSION;
+  }
+
+  int WriteChunk(lua_State*, const void* data, size_t size, void* out) {
+    static_cast<std::string*>(out)->append(static_cast<const char*>(data), size);
+    return 0;
+  }
+}
+
+ScriptResourceManager::ScriptResourceManager() : parsed(0) {
+  ConfigureEnvironment();
+}
+
 void ScriptResourceManager::ConfigureEnvironment() {
   luaState.open_libraries(sol::lib::base);
 
@@ -63,6 +99,34 @@ void ScriptResourceManager::ConfigureEnvironment() {
     sol::base_classes, sol::bases<ChipAction>()
     );
 
+  // Queued by on_update hooks. Only numbers cross into C++.
+  auto commands_record = battle_namespace.new_usertype<ScriptCommandBuffer>("Commands",
+    sol::no_constructor,
+    "Move", &ScriptCommandBuffer::Move,
+    "Animate", &ScriptCommandBuffer::Animate,
+    "Counter", &ScriptCommandBuffer::Counter,
+    "Spawn", &ScriptCommandBuffer::Spawn,
+    "EndTurn", &ScriptCommandBuffer::EndTurn
+    );
+
+  battle_namespace.new_enum("Direction",
+    "NONE", Direction::NONE,
+    "UP", Direction::UP,
+    "LEFT", Direction::LEFT,
+    "DOWN", Direction::DOWN,
+    "RIGHT", Direction::RIGHT
+  );
+
+  battle_namespace.new_enum("Team",
+    "UNKNOWN", Team::UNKNOWN,
+    "BLUE", Team::BLUE,
+    "RED", Team::RED
+  );
+
+  battle_namespace.new_enum("Spell",
+    "WAVE", ScriptSpell::WAVE
+  );
+
   auto elements_table = battle_namespace.new_enum("Element");
   elements_table["FIRE"] = Element::FIRE;
   elements_table["AQUA"] = Element::AQUA;
@@ -155,6 +219,166 @@ void ScriptResourceManager::AddToPaths(FileMeta pathInfo)
   paths.push_back(pathInfo);
 }
 
+sol::protected_function ScriptResourceManager::LoadChunk(const std::string& path, const std::string& source) {
+  lua_State* L = luaState.lua_state();
+  const uint64_t hash = HashSource(source);
+  const std::string chunkname = "@" + path;
+
+  auto iter = chunks.find(hash);
+
+  if (iter == chunks.end()) {
+    std::ifstream file(CachePath(hash), std::ios::binary);
+    std::string cached((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (!cached.empty()) {
+      iter = chunks.emplace(hash, std::move(cached)).first;
+    }
+  }
+
+  if (iter != chunks.end()) {
+    if (luaL_loadbufferx(L, iter->second.data(), iter->second.size(), chunkname.c_str(), "b") == LUA_OK) {
+      sol::protected_function chunk(L, -1);
+      lua_pop(L, 1);
+      return chunk;
+    }
+
+    // Written by a different build of lua. Compile the source again.
+    lua_pop(L, 1);
+    chunks.erase(iter);
+  }
+
+  if (luaL_loadbufferx(L, source.data(), source.size(), chunkname.c_str(), "t") != LUA_OK) {
+    Logger::GetMutex()->lock();
+    Logger::Logf("[ScriptResourceManager] Failed to compile %s: %s", path.c_str(), lua_tostring(L, -1));
+    Logger::GetMutex()->unlock();
+
+    lua_pop(L, 1);
+    return sol::protected_function();
+  }
+
+  parsed++;
+
+  // Debug info is kept so errors still report lines
+  std::string bytecode;
+  lua_dump(L, &WriteChunk, &bytecode, 0);
+
+  sol::protected_function chunk(L, -1);
+  lua_pop(L, 1);
+
+  std::error_code error;
+  std::filesystem::create_directories(SCRIPT_CACHE_PATH, error);
+  std::ofstream(CachePath(hash), std::ios::binary).write(bytecode.data(), bytecode.size());
+
+  chunks.emplace(hash, std::move(bytecode));
+
+  return chunk;
+}
+
+const bool ScriptResourceManager::LoadScript(const FileMeta& meta) {
+  std::string source = VFS.ReadString(meta.path);
+
+  std::lock_guard<std::recursive_mutex> lock(stateMutex);
+
+  if (source.empty()) {
+    Logger::GetMutex()->lock();
+    Logger::Logf("[ScriptResourceManager] Could not read script %s", meta.path.c_str());
+    Logger::GetMutex()->unlock();
+    return false;
+  }
+
+  sol::protected_function chunk = LoadChunk(meta.path, source);
+
+  if (!chunk.valid()) return false;
+
+  // New globals go into the script's own table. Reads fall back to the shared globals.
+  sol::environment environment(luaState, sol::create, luaState.globals());
+  sol::set_environment(environment, chunk);
+
+  sol::protected_function_result result = chunk();
+
+  if (!result.valid()) {
+    sol::error err = result;
+
+    Logger::GetMutex()->lock();
+    Logger::Logf("[ScriptResourceManager] Script %s failed to run: %s", meta.path.c_str(), err.what());
+    Logger::GetMutex()->unlock();
+    return false;
+  }
+
+  // The old environment is only replaced once the new one ran
+  environments.insert_or_assign(meta.name, environment);
+  nameToTypeHash[meta.name] = meta.type;
+
+  return true;
+}
+
+const bool ScriptResourceManager::ReloadScript(const std::string& name) {
+  for (const FileMeta& meta : paths) {
+    if (meta.name == name) {
+      return LoadScript(meta);
+    }
+  }
+
+  return false;
+}
+
+ScriptFunction ScriptResourceManager::GetFunction(const std::string& name, const std::string& function) {
+  std::lock_guard<std::recursive_mutex> lock(stateMutex);
+
+  auto iter = environments.find(name);
+
+  if (iter == environments.end()) return ScriptFunction();
+
+  sol::object value = iter->second.raw_get<sol::object>(function);
+
+  if (value.get_type() != sol::type::function) return ScriptFunction();
+
+  return value.as<ScriptFunction>();
+}
+
+sol::table ScriptResourceManager::GetEnvironment(const std::string& name) {
+  std::lock_guard<std::recursive_mutex> lock(stateMutex);
+
+  auto iter = environments.find(name);
+
+  if (iter == environments.end()) return sol::table();
+
+  return iter->second;
+}
+
+sol::state& ScriptResourceManager::GetState() {
+  return luaState;
+}
+
+std::recursive_mutex& ScriptResourceManager::GetStateMutex() {
+  return stateMutex;
+}
+
+void ScriptResourceManager::ClearChunkCache() {
+  chunks.clear();
+
+  std::error_code error;
+  std::filesystem::remove_all(SCRIPT_CACHE_PATH, error);
+}
+
 void ScriptResourceManager::LoadAllSCripts(std::atomic<int>& status)
 {
+  sf::Clock clock;
+  unsigned loaded = 0, fromBytecode = 0;
+
+  for (const FileMeta& meta : paths) {
+    unsigned parsedBefore = parsed;
+
+    if (meta.type != ScriptMetaType::ERROR_STATE && LoadScript(meta)) {
+      loaded++;
+      fromBytecode += (parsed == parsedBefore);
+    }
+
+    status++;
+  }
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Loaded %u of %u scripts (%u from bytecode): %.2f ms",
+    loaded, (unsigned)paths.size(), fromBytecode, clock.getElapsedTime().asMicroseconds() / 1000.0);
+  Logger::GetMutex()->unlock();
 }
@@ -8,11 +8,46 @@
 #include <vector>
 #include <iostream>
 #include <atomic>
+#include <cstdint>
+#include <mutex>
 
+// Argument and stack checks on every call into and out of scripts.
+// Turn off for release builds that only ship trusted scripts.
+#ifndef OBN_SCRIPT_SAFETIES
+#define OBN_SCRIPT_SAFETIES 1
+#endif
+
+#if OBN_SCRIPT_SAFETIES
 #define SOL_ALL_SAFETIES_ON 1
+#endif
 #define SOL_USING_CXX_LUA 1
 #include "sol/sol.hpp"
 
+// Compiled chunks are saved here and named by the hash of their source
+#define SCRIPT_CACHE_PATH "cache/scripts/"
+#define SCRIPT_CACHE_EXTENSION ".luac"
+
+/*! \brief Script hooks are called through pcall only while safeties are on */
+#if OBN_SCRIPT_SAFETIES
+using ScriptFunction = sol::protected_function;
+#else
+using ScriptFunction = sol::unsafe_function;
+#endif
+
+/**
+ * @class ScriptResourceManager
+ * @author mav
+ * @date 10/19/20
+ * @brief Loads mod scripts into one lua state. Each script runs in its own environment.
+ *
+ * Scripts are compiled once and the bytecode is kept in memory and in SCRIPT_CACHE_PATH
+ * under the hash of the source. A script that has not changed since the last run is
+ * loaded from bytecode and never parsed.
+ *
+ * Every script gets an environment table that falls back to the shared globals, so
+ * what one script defines does not leak into another. Reloading one script replaces
+ * its environment and leaves the others alone.
+ */
 class ScriptResourceManager {
 public:
   struct FileMeta {
@@ -34,14 +69,100 @@ public:
 private:
   std::vector<FileMeta> paths; /*!< Scripts to load */
   std::map<std::string, ScriptMetaType> nameToTypeHash; /*!< Script name to type hash */
-  std::map<std::string, sol::table> scriptTableHash; /*!< Script name to sol table hash */
+  std::map<std::string, sol::environment> environments; /*!< Script name to its own globals */
+  std::map<uint64_t, std::string> chunks; /*!< Source hash to compiled bytecode */
+  unsigned parsed; /*!< Scripts compiled from source since startup */
   sol::state luaState; 
+  std::recursive_mutex stateMutex; /*!< held by anything touching luaState */
+
+  ScriptResourceManager();
 
   void ConfigureEnvironment(); 
 
+  /**
+   * @brief Load bytecode for source from memory or disk, or compile and cache it
+   * @param path used in error messages
+   * @param source lua source
+   * @return the main function of the chunk. Invalid if the source does not compile.
+   */
+  sol::protected_function LoadChunk(const std::string& path, const std::string& source);
+
 public:
   void AddToPaths(FileMeta pathInfo);
 
+  /**
+   * @brief Load a script into a new environment. Replaces the environment if it was loaded before.
+   * @param meta script to load
+   * @return false if the script could not be read, compiled or run
+   */
+  const bool LoadScript(const FileMeta& meta);
+
+  /**
+   * @brief Load one script in paths again. No other script is touched.
+   * @param name of the script
+   * @return false if there is no script by that name or it did not load
+   */
+  const bool ReloadScript(const std::string& name);
+
+  /**
+   * @brief Look up a function a script defined
+   * @param name of the script
+   * @param function name of the function in the script's environment
+   * @return the function or an invalid function if it is not there
+   *
+   * Look hooks up once and keep them. Reloading the script does not update kept functions.
+   */
+  ScriptFunction GetFunction(const std::string& name, const std::string& function);
+
+  /**
+   * @brief The table a script's globals live in
+   * @param name of the script
+   * @return the environment or an invalid table if the script is not loaded
+   */
+  sol::table GetEnvironment(const std::string& name);
+
+  /**
+   * @brief The lua state every script shares. Hold GetStateMutex() while using it.
+   */
+  sol::state& GetState();
+
+  /**
+   * @brief Lock for the shared lua state
+   *
+   * The battle server steps battles on many threads and they all share one state.
+   * Lock before reading or writing lua values, calling hooks, or releasing lua
+   * references. Locking again on the same thread is fine.
+   */
+  std::recursive_mutex& GetStateMutex();
+
+  /**
+   * @brief Call a script hook if it is valid. Errors are logged while safeties are on.
+   * @param hook from GetFunction()
+   * @param args passed to the hook
+   */
+  template<typename... Args>
+  static void CallHook(const ScriptFunction& hook, Args&&... args) {
+    if (!hook.valid()) return;
+
+#if OBN_SCRIPT_SAFETIES
+    sol::protected_function_result result = hook(std::forward<Args>(args)...);
+
+    if (!result.valid()) {
+      sol::error err = result;
+      Logger::GetMutex()->lock();
+      Logger::Logf("[ScriptResourceManager] Script hook failed: %s", err.what());
+      Logger::GetMutex()->unlock();
+    }
+#else
+    hook(std::forward<Args>(args)...);
+#endif
+  }
+
+  /**
+   * @brief Forget every compiled chunk in memory and on disk. Scripts are parsed again next load.
+   */
+  void ClearChunkCache();
+
   static ScriptResourceManager& GetInstance() {
     static ScriptResourceManager* instance = new ScriptResourceManager();
 
@@ -49,11 +170,11 @@ public:
   }
 
   /**
- * @brief Loads all scripts
- * @param status Increases the count after each shader loads
- */
+   * @brief Loads all scripts in paths and logs how long it took
+   * @param status Increases the count after each script loads
+   */
   void LoadAllSCripts(std::atomic<int> &status);
 };
 
 /*! \brief Shorthand to get instance of the manager */
-#define SCRIPTS ScriptResourceManager::GetInstance()
\ No newline at end of file
+#define SCRIPTS ScriptResourceManager::GetInstance()
@@ -0,0 +1,238 @@
+#include "bnScriptedCharacter.h"
+#include "bnTextureResourceManager.h"
+#include "bnExplosion.h"
+#include "bnField.h"
+#include "bnTile.h"
+#include "bnWave.h"
+
+ScriptedCharacter::ScriptedCharacter(ScriptedCharacter::Rank rank)
+  : AnimatedCharacter(rank), TurnOrderTrait<ScriptedCharacter>(),
+  explosion(nullptr), height(0), isAnimating(false), isMoving(false), isBlocked(false) {
+  name = "Scripted";
+  FreeTarget();
+}
+
+ScriptedCharacter::~ScriptedCharacter() {
+  RemoveMeFromTurnOrder();
+
+  {
+    // Release lua references while holding the state
+    std::lock_guard<std::recursive_mutex> lock(SCRIPTS.GetStateMutex());
+    onUpdate = ScriptFunction();
+    onDelete = ScriptFunction();
+    view = sol::table();
+    commandsObject = sol::object();
+  }
+
+  if (!texturePath.empty()) {
+    TEXTURES.ReleaseTexture(texturePath);
+  }
+}
+
+void ScriptedCharacter::SetScript(const std::string& name) {
+  std::lock_guard<std::recursive_mutex> lock(SCRIPTS.GetStateMutex());
+
+  onUpdate = SCRIPTS.GetFunction(name, "on_update");
+  onDelete = SCRIPTS.GetFunction(name, "on_delete");
+
+  sol::table script = SCRIPTS.GetEnvironment(name);
+
+  if (!script.valid()) return;
+
+  this->name = script.get_or<std::string>("name", name);
+  height = script.get_or("height", 0.f);
+
+  if (sol::optional<int> health = script["health"]) {
+    SetHealth(*health);
+  }
+
+  animations.clear();
+
+  if (sol::optional<sol::table> list = script["animations"]) {
+    for (size_t i = 1; i <= list->size(); i++) {
+      animations.push_back(list->get<std::string>(i));
+    }
+  }
+
+  std::string path = script.get_or<std::string>("texturePath", "");
+
+  if (!path.empty() && path != texturePath) {
+    if (!texturePath.empty()) {
+      TEXTURES.ReleaseTexture(texturePath);
+    }
+
+    texturePath = path;
+    setTexture(*TEXTURES.LoadTextureFromFile(texturePath));
+    setScale(2.f, 2.f);
+  }
+
+  path = script.get_or<std::string>("animationPath", "");
+
+  if (!path.empty()) {
+    animationComponent->Setup(path);
+    animationComponent->Reload();
+    Play(1);
+    animationComponent->OnUpdate(0);
+  }
+
+  // Made once. Updates only write numbers into them.
+  sol::state& state = SCRIPTS.GetState();
+  view = state.create_table(0, 16);
+  commandsObject = sol::make_object(state.lua_state(), &commands);
+}
+
+const bool ScriptedCharacter::OnHit(const Hit::Properties props) {
+  return true;
+}
+
+const float ScriptedCharacter::GetHeight() const {
+  return height;
+}
+
+void ScriptedCharacter::OnDelete() {
+  RemoveMeFromTurnOrder();
+
+  if (view.valid()) {
+    std::lock_guard<std::recursive_mutex> lock(SCRIPTS.GetStateMutex());
+    ScriptResourceManager::CallHook(onDelete, view);
+  }
+
+  SetPassthrough(true);
+
+  Explosion* boom = new Explosion(GetField(), GetTeam(), 2, 1.0);
+  GetField()->AddEntity(*boom, tile->GetX(), tile->GetY());
+  explosion = boom;
+
+  animationComponent->SetPlaybackSpeed(0);
+  animationComponent->CancelCallbacks();
+}
+
+void ScriptedCharacter::OnUpdate(float elapsed) {
+  setPosition(tile->getPosition().x + tileOffset.x, tile->getPosition().y + tileOffset.y);
+
+  // Frozen until the explosion is done
+  if (explosion) {
+    if (explosion->IsDeleted()) {
+      Delete();
+    }
+
+    return;
+  }
+
+  if (!onUpdate.valid()) {
+    // Nothing to take a turn with
+    if (IsMyTurn()) EndMyTurn();
+    return;
+  }
+
+  {
+    std::lock_guard<std::recursive_mutex> lock(SCRIPTS.GetStateMutex());
+
+    WriteView(elapsed);
+    commands.Clear();
+
+    ScriptResourceManager::CallHook(onUpdate, view, commandsObject);
+  }
+
+  // Commands are plain C++. The state is not needed to apply them.
+  ApplyCommands();
+}
+
+void ScriptedCharacter::WriteView(float elapsed) {
+  Entity* target = GetTarget();
+  Battle::Tile* targetTile = target ? target->GetTile() : nullptr;
+
+  view.raw_set(
+    "x", tile->GetX(),
+    "y", tile->GetY(),
+    "health", GetHealth(),
+    "maxHealth", GetMaxHealth(),
+    "team", (int)GetTeam(),
+    "targetX", targetTile ? targetTile->GetX() : 0,
+    "targetY", targetTile ? targetTile->GetY() : 0,
+    "elapsed", elapsed,
+    "isAnimating", isAnimating,
+    "isMoving", isMoving,
+    "isBlocked", isBlocked,
+    "isMyTurn", IsMyTurn()
+  );
+
+  // Only reported for the frame after the move failed
+  isBlocked = false;
+}
+
+void ScriptedCharacter::ApplyCommands() {
+  for (unsigned i = 0; i < commands.GetCount(); i++) {
+    const ScriptCommand& command = commands[i];
+
+    switch (command.type) {
+    case ScriptCommandType::MOVE:
+      if (isMoving) break;
+
+      if (Move(command.direction)) {
+        AdoptNextTile();
+        isMoving = true;
+        Play(command.a);
+      }
+      else {
+        isBlocked = true;
+      }
+      break;
+    case ScriptCommandType::ANIMATE:
+      // The move animation finishes the move
+      if (!isMoving) Play(command.a);
+      break;
+    case ScriptCommandType::COUNTER:
+      for (int frame = command.a; frame <= command.b; frame++) {
+        SetCounterFrame(frame);
+      }
+      break;
+    case ScriptCommandType::SPAWN:
+      Spawn(command);
+      break;
+    case ScriptCommandType::END_TURN:
+      EndMyTurn();
+      break;
+    }
+  }
+}
+
+void ScriptedCharacter::Play(int animation) {
+  // Scripts count animations from 1
+  if (animation < 1 || animation > (int)animations.size()) return;
+
+  isAnimating = true;
+
+  // Captures only this so no allocation is made for the callback
+  SetAnimation(animations[animation - 1], [this]() {
+    isAnimating = false;
+
+    if (isMoving) {
+      isMoving = false;
+      FinishMove();
+    }
+  });
+}
+
+void ScriptedCharacter::Spawn(const ScriptCommand& command) {
+  Battle::Tile* at = GetField()->GetAt(tile->GetX() + command.a, tile->GetY() + command.b);
+
+  if (!at || !at->IsWalkable()) return;
+
+  Spell* spell = nullptr;
+
+  switch (command.spell) {
+  case ScriptSpell::WAVE:
+    spell = new Wave(GetField(), GetTeam(), GetRank() == Rank::SP ? 1.2 : 1.0);
+    break;
+  }
+
+  if (!spell) return;
+
+  auto props = spell->GetHitboxProperties();
+  props.aggressor = this;
+  spell->SetHitboxProperties(props);
+  spell->SetDirection(command.direction);
+
+  GetField()->AddEntity(*spell, at->GetX(), at->GetY());
+}
@@ -1,28 +1,74 @@
 #pragma once
-#include "bnCharacter.h"
+#include "bnAnimatedCharacter.h"
+#include "bnAgent.h"
+#include "bnTurnOrderTrait.h"
 #include "bnScriptResourceManager.h"
+#include "bnScriptCommandBuffer.h"
 
-class ScriptedCharacter : public Character {
-public:
-  ScriptedCharacter(ScriptedCharacter::Rank rank) : Character(rank) {
-
-  }
+#include <string>
+#include <vector>
 
-  const bool OnHit(const Hit::Properties props) final {
-    // SCRIPTS.callback(character_ID).OnHit(props);
-    return false;
-  }
-
-  const float GetHeight() const final {
-    // SCRIPTS.callback(character_ID).GetHeight(props);
-    return 0;
-  }
+/**
+ * @class ScriptedCharacter
+ * @author mav
+ * @date 10/19/20
+ * @brief A character whose behavior comes from a script
+ *
+ * The script sets these globals, read once by SetScript():
+ *   texturePath, animationPath, health, height
+ *   animations = { "IDLE", "MOVING", ... } animations the commands refer to by index
+ *
+ * and these hooks:
+ *   on_update(view, commands) every frame
+ *   on_delete(view) once when health reaches zero
+ *
+ * view is a table made once per character and written in place before every update:
+ *   x, y, health, maxHealth, team, targetX, targetY, elapsed,
+ *   isAnimating, isMoving, isBlocked (last move failed), isMyTurn
+ *
+ * Keys the script adds to the view are kept between updates, so the view also holds
+ * the script's state for this character.
+ *
+ * commands is this character's ScriptCommandBuffer. Reading the view and queuing
+ * commands does not call back into C++ per field and nothing is allocated per frame.
+ *
+ * Scripted characters take turns with each other like mettaurs do. Characters
+ * without a script pass their turn.
+ *
+ * Every script shares one lua state. Anything touching it holds
+ * ScriptResourceManager::GetStateMutex(), so battles on server threads take turns
+ * running scripts.
+ */
+class ScriptedCharacter : public AnimatedCharacter, public Agent, public TurnOrderTrait<ScriptedCharacter> {
+public:
+  ScriptedCharacter(ScriptedCharacter::Rank rank);
+  ~ScriptedCharacter();
 
-  void OnDelete() final {
+  /**
+   * @brief Drive this character with a loaded script. Hooks are looked up once here.
+   * @param name of the script
+   */
+  void SetScript(const std::string& name);
 
-  }
+  const bool OnHit(const Hit::Properties props) final;
+  const float GetHeight() const final;
+  void OnDelete() final;
+  void OnUpdate(float elapsed) final;
 
-  void OnUpdate(float elapsed) final {
+private:
+  void WriteView(float elapsed);
+  void ApplyCommands();
+  void Play(int animation);
+  void Spawn(const ScriptCommand& command);
 
-  }
-};
\ No newline at end of file
+  ScriptFunction onUpdate; /*!< on_update(view, commands) from the script */
+  ScriptFunction onDelete; /*!< on_delete(view) from the script */
+  sol::table view; /*!< written in place before each update */
+  sol::object commandsObject; /*!< lua reference to commands */
+  ScriptCommandBuffer commands;
+  std::vector<std::string> animations; /*!< animations by index the script uses */
+  std::string texturePath; /*!< texture held from TEXTURES. Empty if none. */
+  Entity* explosion; /*!< deletion explosion. Deleted when it finishes */
+  float height;
+  bool isAnimating, isMoving, isBlocked;
+};
@@ -1,5 +1,6 @@
 #include <Swoosh/ActivityController.h>
 #include "bnSelectMobScene.h"
+#include "bnReplayManager.h"
 #include "Android/bnTouchArea.h"
 
 SelectMobScene::SelectMobScene(swoosh::ActivityController& controller, SelectedNavi navi, ChipFolder& selectedFolder) :
@@ -103,7 +104,7 @@ void SelectMobScene::onResume() {
   ENGINE.SetCamera(camera);
 
   // Re-play music
-  AUDIO.Stream("resources/loops/loop_navi_customizer.ogg", true);
+  AUDIO.Stream("resources/loops/loop_navi_customizer.ogg", true, sf::Music::TimeSpan(), 0.5f);
 
   gotoNextScene = false;
   doOnce = true;
@@ -270,6 +271,11 @@ void SelectMobScene::onUpdate(double elapsed) {
 
     textbox.SetMessage(mobinfo.GetDescriptionString());
 	textbox.Stop();
+
+    // Get this battle's content ready while the player is choosing
+    std::vector<std::string> animationPaths = mobinfo.GetAnimationPaths();
+    animationPaths.push_back(NAVIS.At(selectedNavi).GetBattleAnimationPath());
+    preloader.Start(animationPaths);
 	
     prevSelect = mobSelectionIndex;
   }
@@ -373,7 +379,11 @@ void SelectMobScene::onUpdate(double elapsed) {
 
   // Make a selection
   if (INPUT.Has(EventTypes::PRESSED_CONFIRM) && !gotoNextScene) {
-    
+    BattlePreloader::MarkBattleRequested();
+
+    // Seed before the mob is made so the battle can be replayed
+    unsigned seed = REPLAYS.SeedBattle();
+
     if (MOBS.Size() != 0) {
       this->mob = MOBS.At(mobSelectionIndex).GetMob();
     }
@@ -391,8 +401,8 @@ void SelectMobScene::onUpdate(double elapsed) {
       // Play the pre battle rumble sound
       AUDIO.Play(AudioType::PRE_BATTLE, AudioPriority::HIGH);
 
-      // Stop music and go to battle screen 
-      AUDIO.StopStream();
+      // Fade out music and go to battle screen 
+      AUDIO.StopStream(0.25f);
 
       // Get the navi we selected
       Player* player = NAVIS.At(selectedNavi).GetNavi();
@@ -400,6 +410,8 @@ void SelectMobScene::onUpdate(double elapsed) {
       // Shuffle our folder
       selectedFolder.Shuffle();
 
+      REPLAYS.BeginRecording(seed, selectedNavi, mobSelectionIndex, selectedFolder);
+
       // Queue screen transition to Battle Scene with a white fade effect
       // just like the game
       using segue = swoosh::intent::segue<WhiteWashFade>::to<BattleScene>;
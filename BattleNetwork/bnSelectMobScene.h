@@ -25,6 +25,7 @@
 #include "bnTextureResourceManager.h"
 #include "bnEngine.h"
 #include "bnBattleScene.h"
+#include "bnBattlePreloader.h"
 #include "bnMobFactory.h"
 #include "bnRandomMettaurMob.h"
 #include "bnProgsManBossFight.h"
@@ -108,6 +109,8 @@ private:
 
   TextBox textbox; /*!< textbox message */
 
+  BattlePreloader preloader; /*!< Parses battle content while the player is choosing */
+
 public:
   /**
    * @brief Loads graphics and sets original state of all items
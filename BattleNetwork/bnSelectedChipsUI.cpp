@@ -158,6 +158,7 @@ void SelectedChipsUI::UseNextChip() {
   }
 
   // Broadcast to all subscribed ChipUseListeners
+  // Not posted to the field's event bus: PlayerControlledState executes the action this creates right away
   this->Broadcast(*selectedChips[curr], *player);
 
   curr++;
@@ -1,5 +1,9 @@
 #include "bnShaderResourceManager.h"
 #include "bnShaderType.h"
+#include "bnVirtualFileSystem.h"
+#include "bnTextureResourceManager.h"
+#include "bnPaletteAtlas.h"
+#include "bnEngine.h"
 #include <stdlib.h>
 #include <sstream>
 using std::stringstream;
@@ -17,11 +21,20 @@ void ShaderResourceManager::LoadAllShaders(std::atomic<int> &status) {
     {
         status++;
 
+        sf::Clock clock;
+
         // TODO: Catch failed resources and try again
         sf::Shader* shader = LoadShaderFromFile(paths[static_cast<int>(shaderType)]);
         if (shader)
         {
             shaders.insert(pair<ShaderType, sf::Shader*>(shaderType, shader));
+
+            // SFML compiles and links in the same call
+            timings[shaderType].loadMilliseconds = clock.getElapsedTime().asMicroseconds() / 1000.f;
+
+            Logger::GetMutex()->lock();
+            Logger::Logf("Compiled and linked shader %s: %f ms", paths[static_cast<int>(shaderType)].c_str(), timings[shaderType].loadMilliseconds);
+            Logger::GetMutex()->unlock();
         }
         shaderType = (ShaderType)(static_cast<int>(shaderType) + 1);
     }
@@ -34,13 +47,15 @@ sf::Shader* ShaderResourceManager::LoadShaderFromFile(string _path)
     sf::Shader* shader = new sf::Shader();
     bool result = false;
 
-    if(shader->loadFromFile(_path + ".vert", _path + ".frag"))
+    std::string frag = VFS.ReadString(_path + ".frag");
+
+    if(shader->loadFromMemory(VFS.ReadString(_path + ".vert"), frag))
     {
         result = true;
     }
     else // default vert shader
     {
-        result = shader->loadFromFile(paths[static_cast<int>(ShaderType::DEFAULT)] + ".vert", _path + ".frag");
+        result = shader->loadFromMemory(VFS.ReadString(paths[static_cast<int>(ShaderType::DEFAULT)] + ".vert"), frag);
     }
 
     if (!result)
@@ -53,7 +68,7 @@ sf::Shader* ShaderResourceManager::LoadShaderFromFile(string _path)
     }
 #else 
     sf::Shader* shader = new sf::Shader();
-    if (!shader->loadFromFile(_path + ".frag", sf::Shader::Fragment)) {
+    if (!shader->loadFromMemory(VFS.ReadString(_path + ".frag"), sf::Shader::Fragment)) {
 
       Logger::GetMutex()->lock();
       Logger::Log("Error loading shader: " + _path + ".frag");
@@ -77,6 +92,85 @@ sf::Shader* ShaderResourceManager::GetShader(ShaderType _stype) {
   return shaders.at(_stype);
 }
 
+void ShaderResourceManager::BindWarmUpUniforms(ShaderType _stype, sf::Shader& shader, const sf::Texture& map) {
+  const sf::Vector2f size = ENGINE.GetView().getSize();
+
+  shader.setUniform("texture", sf::Shader::CurrentTexture);
+
+  // Bind the same samplers the game binds so the driver builds the same variant now
+  switch (_stype) {
+  case ShaderType::DISTORTION:
+  case ShaderType::SPOT_DISTORTION:
+    shader.setUniform("currentTexture", sf::Shader::CurrentTexture);
+    shader.setUniform("distortionMapTexture", LOAD_TEXTURE(HEAT_TEXTURE));
+    shader.setUniform("textureSizeIn", sf::Glsl::Vec2(size.x, size.y));
+    break;
+  case ShaderType::SPOT_REFLECTION:
+    shader.setUniform("currentTexture", sf::Shader::CurrentTexture);
+    shader.setUniform("sceneTexture", sf::Shader::CurrentTexture);
+    shader.setUniform("textureSizeIn", sf::Glsl::Vec2(size.x, size.y));
+    break;
+  case ShaderType::TRANSITION:
+    shader.setUniform("map", map);
+    break;
+#ifndef SFML_SYSTEM_ANDROID
+  case ShaderType::PALETTE_SWAP:
+    shader.setUniform("palette", PALETTES.GetTexture());
+    break;
+#endif
+  default:
+    break;
+  }
+}
+
+void ShaderResourceManager::WarmUpShaders(sf::RenderTexture& target) {
+  // Battle sprites come from texture atlases. Draw with one so sampling matches.
+  sf::Texture& texture = LOAD_TEXTURE(HEAT_TEXTURE);
+  sf::Sprite quad(texture, sf::IntRect(0, 0, 16, 16));
+
+  // Sprites draw with alpha blending and counter/flash effects draw additively
+  const sf::BlendMode blendModes[] = { sf::BlendAlpha, sf::BlendAdd };
+
+  for (auto& pair : shaders) {
+    sf::Clock clock;
+
+    BindWarmUpUniforms(pair.first, *pair.second, texture);
+
+    for (auto& mode : blendModes) {
+      sf::RenderStates states;
+      states.shader = pair.second;
+      states.blendMode = mode;
+
+      target.draw(quad, states);
+    }
+
+    target.display();
+
+    // Reading back waits until the GPU has actually run the shader
+    target.getTexture().copyToImage();
+
+    timings[pair.first].warmUpMilliseconds = clock.getElapsedTime().asMicroseconds() / 1000.f;
+
+    Logger::GetMutex()->lock();
+    Logger::Logf("Warmed up shader %s: %f ms", paths[static_cast<int>(pair.first)].c_str(), timings[pair.first].warmUpMilliseconds);
+    Logger::GetMutex()->unlock();
+  }
+
+  // Nothing drawn here should show on screen
+  target.clear();
+  target.display();
+}
+
+const ShaderResourceManager::ShaderTiming ShaderResourceManager::GetShaderTiming(ShaderType _stype) const {
+  auto iter = timings.find(_stype);
+
+  if (iter == timings.end()) {
+    return ShaderTiming();
+  }
+
+  return iter->second;
+}
+
 ShaderResourceManager::ShaderResourceManager(void) {
 
 #ifdef SFML_SYSTEM_ANDROID
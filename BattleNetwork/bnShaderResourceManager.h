@@ -53,11 +53,46 @@ public:
    */
   sf::Shader* GetShader(ShaderType _ttype);
 
+  /**
+   * @brief Draws a quad with every loaded shader and the textures the game binds to it
+   * @param target the surface the game draws to. Cleared when done.
+   *
+   * Some drivers defer linking until a shader is first drawn with, and build
+   * another variant for each set of bound samplers. Call this on the thread
+   * and surface the game draws with, after textures load, so that the first
+   * in-battle use of an effect does not hitch.
+   */
+  void WarmUpShaders(sf::RenderTexture& target);
+
+  /**
+   * @struct ShaderTiming
+   * @brief Startup cost of a shader
+   */
+  struct ShaderTiming {
+    float loadMilliseconds{ 0.f };   /*!< Read, compile, and link */
+    float warmUpMilliseconds{ 0.f }; /*!< First draws until the GPU finished */
+  };
+
+  /**
+   * @brief Get the startup costs recorded for a shader
+   * @param _stype shader type
+   * @return ShaderTiming
+   */
+  const ShaderTiming GetShaderTiming(ShaderType _stype) const;
+
 private:
   ShaderResourceManager();
+
+  /**
+   * @brief Set the samplers and sizes the game sets on a shader before drawing with it
+   * @param map texture for samplers the game fills from a scene's own texture
+   */
+  void BindWarmUpUniforms(ShaderType _stype, sf::Shader& shader, const sf::Texture& map);
+
   ~ShaderResourceManager();
   vector<string> paths;  /*!< Paths to all shaders. Must be in order of ShaderType @see ShaderType */
   map<ShaderType, sf::Shader*> shaders; /*!< cache */
+  map<ShaderType, ShaderTiming> timings; /*!< startup costs per shader */
 };
 
 /*! \brief Shorthand to get instance of the manager */
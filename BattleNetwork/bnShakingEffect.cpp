@@ -1,6 +1,7 @@
 #include "bnShakingEffect.h"
 #include "bnEntity.h"
 #include "bnBattleScene.h"
+#include "bnBattleContext.h"
 
 ShakingEffect::ShakingEffect(Entity * owner) : Component(owner), 
 privOwner(owner),
@@ -24,8 +25,8 @@ void ShakingEffect::OnUpdate(float _elapsed)
     // Drop off to zero by end of shake
     double currStress = stress * (1 - (shakeProgress / shakeDur));
 
-    int randomAngle = int(shakeProgress) * (rand() % 360);
-    randomAngle += (150 + (rand() % 60));
+    int randomAngle = int(shakeProgress) * (BattleContext::Rand() % 360);
+    randomAngle += (150 + (BattleContext::Rand() % 60));
 
     auto shakeOffset = sf::Vector2f(std::sin((float)randomAngle) * float(currStress), std::cos((float)randomAngle) * float(currStress));
     privOwner->setPosition(startPos + shakeOffset);
@@ -1,33 +1,61 @@
 #include "bnSmartShader.h"
 
+  std::map<const sf::Shader*, SmartShader::UniformTable> SmartShader::tables;
+  std::mutex SmartShader::tablesMutex;
+  unsigned SmartShader::uniformUploads = 0;
+
+  bool SmartShader::UniformValue::operator==(const UniformValue& rhs) const {
+    if (type != rhs.type) return false;
+
+    switch (type) {
+    case UniformType::INT:
+      return ivalue == rhs.ivalue;
+    case UniformType::FLOAT:
+      return fvalue == rhs.fvalue;
+    case UniformType::VEC2F:
+      return vfvalue == rhs.vfvalue;
+    }
+
+    return false;
+  }
+
   SmartShader::SmartShader() {
     ref = nullptr;
+    table = nullptr;
   }
 
   SmartShader::SmartShader(const SmartShader& copy) {
-    funiforms = copy.funiforms;
-    iuniforms = copy.iuniforms;
-    vfuniforms = copy.vfuniforms;
+    bindings = copy.bindings;
+    table = copy.table;
     ref = copy.ref;
   }
 
   SmartShader::~SmartShader() {
-    iuniforms.clear();
-    funiforms.clear();
+    bindings.clear();
+    table = nullptr;
     ref = nullptr;
   }
 
   SmartShader::SmartShader(const sf::Shader& rhs) {
-    ref = &const_cast<sf::Shader&>(rhs);
+    ref = nullptr;
+    table = nullptr;
+    Rebind(&const_cast<sf::Shader&>(rhs));
   }
 
+ SmartShader& SmartShader::operator=(const SmartShader& rhs) {
+   bindings = rhs.bindings;
+   table = rhs.table;
+   ref = rhs.ref;
+   return *this;
+ }
+
  SmartShader& SmartShader::operator=(const sf::Shader& rhs) {
-   ref = &const_cast<sf::Shader&>(rhs);
+   Rebind(&const_cast<sf::Shader&>(rhs));
    return *this;
   }
 
  SmartShader& SmartShader::operator=(const sf::Shader* rhs) {
-   ref = const_cast<sf::Shader*>(rhs);
+   Rebind(const_cast<sf::Shader*>(rhs));
    return *this;
  }
 
@@ -35,63 +63,176 @@
    return ref;
  }
 
-  void SmartShader::ApplyUniforms() {
-    iiter iIter = iuniforms.begin();
-    fiter fIter = funiforms.begin();
-    vfiter vfIter = vfuniforms.begin();
+  void SmartShader::Rebind(sf::Shader* shader) {
+    if (shader == ref) return;
 
-    for (; iIter != iuniforms.end(); iIter++) {
-      ref->setUniform(iIter->first, iIter->second);
+    std::lock_guard<std::mutex> lock(tablesMutex);
+
+    // Carry the uniforms over to the new shader by name
+    std::vector<std::pair<std::string, UniformValue>> previous;
+
+    if (table) {
+      for (auto& binding : bindings) {
+        previous.push_back({ (*table)[binding.handle].name, binding.value });
+      }
     }
 
-    for (; fIter != funiforms.end(); fIter++) {
-      ref->setUniform(fIter->first, fIter->second);
+    bindings.clear();
+    ref = shader;
+    table = ref ? &tables[ref] : nullptr;
+
+    for (auto& p : previous) {
+      Handle handle = FindOrAddSlot(p.first);
+
+      if (handle != INVALID_HANDLE) {
+        Bind(handle) = p.second;
+      }
     }
+  }
+
+  SmartShader::Handle SmartShader::GetUniformHandle(const std::string& uniform) {
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    return FindOrAddSlot(uniform);
+  }
+
+  SmartShader::Handle SmartShader::FindOrAddSlot(const std::string& uniform) {
+    if (!table) return INVALID_HANDLE;
 
-    for (; vfIter != vfuniforms.end(); vfIter++) {
-      ref->setUniform(vfIter->first, vfIter->second);
+    for (size_t i = 0; i < table->size(); i++) {
+      if ((*table)[i].name == uniform) {
+        return (Handle)i;
+      }
     }
+
+    UniformSlot slot;
+    slot.name = uniform;
+    table->push_back(slot);
+
+    return (Handle)(table->size() - 1);
   }
 
-  void SmartShader::ResetUniforms() {
-    if (!ref) {
-      return;
+  SmartShader::UniformValue& SmartShader::Bind(Handle handle) {
+    for (auto& binding : bindings) {
+      if (binding.handle == handle) {
+        return binding.value;
+      }
+    }
+
+    bindings.push_back(UniformBinding{ handle, UniformValue() });
+    return bindings.back().value;
+  }
+
+  void SmartShader::Upload(UniformSlot& slot, const UniformValue& value) {
+    switch (value.type) {
+    case UniformType::INT:
+      ref->setUniform(slot.name, value.ivalue);
+      break;
+    case UniformType::FLOAT:
+      ref->setUniform(slot.name, value.fvalue);
+      break;
+    case UniformType::VEC2F:
+      ref->setUniform(slot.name, value.vfvalue);
+      break;
     }
 
-    iiter iIter = iuniforms.begin();
-    fiter fIter = funiforms.begin();
-    vfiter vfIter = vfuniforms.begin();
+    slot.uploaded = value;
+    slot.hasUploaded = true;
+    uniformUploads++;
+  }
+
+  void SmartShader::ApplyUniforms() {
+    if (!ref || !table) return;
+
+    std::lock_guard<std::mutex> lock(tablesMutex);
+
+    for (auto& binding : bindings) {
+      (*table)[binding.handle].pending = &binding.value;
+    }
 
-    for (; iIter != iuniforms.end(); iIter++) {
-      ref->setUniform(iIter->first, 0);
+    for (auto& slot : *table) {
+      if (slot.pending) {
+        if (!slot.hasUploaded || !(slot.uploaded == *slot.pending)) {
+          Upload(slot, *slot.pending);
+        }
+
+        slot.pending = nullptr;
+      }
+      else if (slot.hasUploaded) {
+        // Another user of this shader left a value behind. Zero it like ResetUniforms() would have.
+        UniformValue zero;
+        zero.type = slot.uploaded.type;
+
+        if (!(slot.uploaded == zero)) {
+          Upload(slot, zero);
+        }
+      }
     }
+  }
 
-    for (; fIter != funiforms.end(); fIter++) {
-      ref->setUniform(fIter->first, 0.f);
+  void SmartShader::ResetUniforms() {
+    if (!ref || !table) {
+      bindings.clear();
+      return;
     }
 
-    for (; vfIter != vfuniforms.end(); vfIter++) {
-      ref->setUniform(vfIter->first, 0.f);
+    std::lock_guard<std::mutex> lock(tablesMutex);
+
+    for (auto& binding : bindings) {
+      UniformSlot& slot = (*table)[binding.handle];
+
+      UniformValue zero;
+      zero.type = binding.value.type;
+
+      if (!slot.hasUploaded || !(slot.uploaded == zero)) {
+        Upload(slot, zero);
+      }
     }
 
-    iuniforms.clear();
-    funiforms.clear();
-    vfuniforms.clear();
+    bindings.clear();
+  }
+
+  void SmartShader::SetUniform(const std::string& uniform, float fvalue) {
+    SetUniform(GetUniformHandle(uniform), fvalue);
+  }
+
+  void SmartShader::SetUniform(const std::string& uniform, int ivalue) {
+    SetUniform(GetUniformHandle(uniform), ivalue);
+  }
+
+  void SmartShader::SetUniform(const std::string& uniform, const sf::Vector2f& vfvalue) {
+    SetUniform(GetUniformHandle(uniform), vfvalue);
   }
 
-  void SmartShader::SetUniform(std::string uniform, float fvalue) {
-    funiforms[uniform] = fvalue;
+  void SmartShader::SetUniform(Handle uniform, float fvalue) {
+    if (uniform == INVALID_HANDLE) return;
+
+    UniformValue& value = Bind(uniform);
+    value.type = UniformType::FLOAT;
+    value.fvalue = fvalue;
   }
 
-  void SmartShader::SetUniform(std::string uniform, int ivalue) {
-    iuniforms[uniform] = ivalue;
+  void SmartShader::SetUniform(Handle uniform, int ivalue) {
+    if (uniform == INVALID_HANDLE) return;
+
+    UniformValue& value = Bind(uniform);
+    value.type = UniformType::INT;
+    value.ivalue = ivalue;
   }
 
-  void SmartShader::SetUniform(std::string uniform, const sf::Vector2f& vfvalue) {
-    vfuniforms[uniform] = vfvalue;
+  void SmartShader::SetUniform(Handle uniform, const sf::Vector2f& vfvalue) {
+    if (uniform == INVALID_HANDLE) return;
+
+    UniformValue& value = Bind(uniform);
+    value.type = UniformType::VEC2F;
+    value.vfvalue = vfvalue;
   }
 
   void SmartShader::Reset() {
     this->ResetUniforms();
     this->ref = nullptr;
+    this->table = nullptr;
+  }
+
+  const unsigned SmartShader::GetUniformUploadCount() {
+    return uniformUploads;
   }
@@ -1,102 +1,192 @@
 /*! \brief A shader wrapper that intelligently applies itself during draw calls
- * 
- * Currently supports int, float, double, vector2f uniforms
- * 
+ *
+ * Currently supports int, float, vector2f uniforms
+ *
  * Additional uniforms must be added
+ *
+ * Uniform names are resolved once into handles. Every sf::Shader has one shared
+ * table of the values it was last sent, so ApplyUniforms() only uploads
+ * uniforms whose value actually changed since the last draw with that shader.
+ *
+ * The tables are shared by battles on every thread and are guarded by one lock.
  */
 
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <map>
+#include <mutex>
+#include <vector>
 
 class SmartShader
 {
   friend class Engine;
+public:
+  typedef int Handle; /*!< Pre-resolved uniform location for a shader */
+
+  static const Handle INVALID_HANDLE = -1;
+
 private:
+  enum class UniformType : int {
+    INT,
+    FLOAT,
+    VEC2F
+  };
+
+  struct UniformValue {
+    UniformType type{ UniformType::FLOAT };
+    int ivalue{ 0 };
+    float fvalue{ 0.f };
+    sf::Vector2f vfvalue;
+
+    bool operator==(const UniformValue& rhs) const;
+  };
+
+  /**
+   * @brief Per-shader uniform state shared by every SmartShader using the shader
+   */
+  struct UniformSlot {
+    std::string name;
+    UniformValue uploaded; /*!< What the GPU currently has */
+    bool hasUploaded{ false };
+    const UniformValue* pending{ nullptr }; /*!< Value requested for the next draw */
+  };
+
+  typedef std::vector<UniformSlot> UniformTable;
+
+  struct UniformBinding {
+    Handle handle;
+    UniformValue value;
+  };
+
   sf::Shader* ref; /*!< Pointer to shader object */
-  std::map<std::string, int>    iuniforms; /*!< lookup of integer uniforms */
-  std::map<std::string, float>  funiforms; /*!< lookup of float uniforms */
-  std::map<std::string, double> duniforms; /*!< lookup of double uniforms */
-  std::map<std::string, sf::Vector2f> vfuniforms; /*!< lookup of vector2f uniforms */
+  UniformTable* table; /*!< Uniform slots for ref */
+  std::vector<UniformBinding> bindings; /*!< Values this wrapper wants on the shader */
 
-  typedef std::map<std::string, int>::iterator iiter; 
-  typedef std::map<std::string, float>::iterator fiter;
-  typedef std::map<std::string, sf::Vector2f>::iterator vfiter;
+  static std::map<const sf::Shader*, UniformTable> tables; /*!< One table per shader object */
+  static std::mutex tablesMutex; /*!< Held while reading or changing tables */
+  static unsigned uniformUploads; /*!< Calls to sf::Shader::setUniform() made by ApplyUniforms() */
 
   /**
-   * @brief Applies all registered uniform values before drawing
+   * @brief Applies all registered uniform values that differ from what the shader already has
+   *
+   * Uniforms that were set by a previous user of this shader but not by us are set to 0
    */
   void ApplyUniforms();
-  
+
   /**
    * @brief Clears the shader object of all uniform values
    */
   void ResetUniforms();
 
+  /**
+   * @brief Point to a new shader object and re-resolve existing uniforms against it
+   * @param shader
+   */
+  void Rebind(sf::Shader* shader);
+
+  /**
+   * @brief GetUniformHandle() for callers already holding tablesMutex
+   */
+  Handle FindOrAddSlot(const std::string& uniform);
+
+  /**
+   * @brief Find or add the binding for a handle
+   */
+  UniformValue& Bind(Handle handle);
+
+  /**
+   * @brief Sends a single value to the shader object
+   */
+  void Upload(UniformSlot& slot, const UniformValue& value);
+
 public:
   /**
    * @brief Constructs a smart shader with pointer to sf::Shader ref set to nullptr
    */
   SmartShader();
-  
+
   /**
    * @brief Constructs a smart shader from another smart shader
    */
   SmartShader(const SmartShader&);
-  
+
   /**
    * @brief Frees the reference to the shader object and empties the uniform dictionaries
    */
   ~SmartShader();
-  
+
   /**
    * @brief Assigns shader object ref to rhs
    * @param rhs shader object to assign itself to
    */
   SmartShader(const sf::Shader& rhs);
-  
+
+  SmartShader& operator=(const SmartShader& rhs);
+
   /**
    * @brief Assignment ops assigns ref to a shader object rhs
    * @param rhs
    */
   SmartShader& operator=(const sf::Shader& rhs);
-  
+
   /**
    * @brief Assignment ops assigns ref to a shader object rhs
    * @param rhs
    */
   SmartShader& operator=(const sf::Shader* rhs);
-  
+
+  /**
+   * @brief Resolve a uniform name to a handle for the current shader object
+   *
+   * Handles are only valid until a new shader object is assigned
+   * @param uniform the name of the uniform
+   * @return Handle or INVALID_HANDLE if there is no shader object
+   */
+  Handle GetUniformHandle(const std::string& uniform);
+
   /**
    * @brief Set a float uniform value
    * @param uniform the name of the uniform
    * @param fvalue
    */
-  void SetUniform(std::string uniform, float fvalue);
-  
+  void SetUniform(const std::string& uniform, float fvalue);
+
   /**
    * @brief Set an integer uniform value
    * @param uniform the name of the uniform
    * @param ivalue
    */
-  void SetUniform(std::string uniform, int ivalue);
-  
+  void SetUniform(const std::string& uniform, int ivalue);
+
   /**
    * @brief Set a vector2f uniform values
    * @param uniform the name of the uniform
    * @param vfvalue
    */
-  void SetUniform(std::string uniform, const sf::Vector2f& vfvalue);
-  
+  void SetUniform(const std::string& uniform, const sf::Vector2f& vfvalue);
+
+  /**
+   * @brief Set uniform values by pre-resolved handle
+   * @see GetUniformHandle()
+   */
+  void SetUniform(Handle uniform, float fvalue);
+  void SetUniform(Handle uniform, int ivalue);
+  void SetUniform(Handle uniform, const sf::Vector2f& vfvalue);
+
   /**
    * @brief Sets all pre-existing uniforms to 0, empties the lookups, and frees ref
    */
   void Reset();
-  
+
   /**
    * @brief Fetch the shader object
    * @return sf::Shader*
    */
   sf::Shader* Get();
-};
 
+  /**
+   * @brief Total uniform uploads made by all smart shaders
+   * @see Engine::GetLastFrameStats()
+   */
+  static const unsigned GetUniformUploadCount();
+};
@@ -68,3 +68,13 @@ void Starfish::OnDelete() {
 
   this->ChangeState<ExplodeState<Starfish>>();
 }
+
+void Starfish::SaveState(BattleSnapshot& snapshot) const{
+  AI<Starfish>::SaveAI(snapshot);
+  AnimatedCharacter::SaveState(snapshot);
+}
+
+void Starfish::LoadState(BattleSnapshot& snapshot){
+  AI<Starfish>::LoadAI(snapshot);
+  AnimatedCharacter::LoadState(snapshot);
+}
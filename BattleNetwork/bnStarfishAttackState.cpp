@@ -3,6 +3,7 @@
 #include "bnTile.h"
 #include "bnField.h"
 #include "bnStarfishAttackState.h"
+#include "bnBattleSnapshot.h"
 
 StarfishAttackState::StarfishAttackState(int maxBubbleCount) : bubbleCount(maxBubbleCount), AIState<Starfish>() { 
 	leaveState = false; 
@@ -51,3 +52,13 @@ void StarfishAttackState::DoAttack(Starfish& star) {
 	}, Animator::NoCallback, false);
   }
 }
+
+void StarfishAttackState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(bubbleCount);
+  snapshot.Write(leaveState);
+}
+
+void StarfishAttackState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(bubbleCount);
+  snapshot.Read(leaveState);
+}
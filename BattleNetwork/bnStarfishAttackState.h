@@ -13,7 +13,7 @@ class StarfishAttackState : public AIState<Starfish>
   bool leaveState; /*!< Flag to switch to next state */
 
 public:
-  StarfishAttackState(int maxBubbleCount);
+  StarfishAttackState(int maxBubbleCount = 3);
   ~StarfishAttackState();
 
   /**
@@ -34,6 +34,18 @@ public:
    * @param star
    */
   void OnLeave(Starfish& star);
+
+  /**
+   * @brief Writes the state's timers and flags
+   * @param snapshot
+   */
+  void SaveState(BattleSnapshot& snapshot) const;
+
+  /**
+   * @brief Reads back what SaveState() wrote
+   * @param snapshot
+   */
+  void LoadState(BattleSnapshot& snapshot);
   
   /**
    * @brief Spawns bubbles until count reaches zero then sets to StarfishIdleState
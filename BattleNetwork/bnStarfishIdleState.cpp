@@ -3,6 +3,7 @@
 #include "bnTile.h"
 #include "bnField.h"
 #include "bnStarfishAttackState.h"
+#include "bnBattleSnapshot.h"
 
 StarfishIdleState::StarfishIdleState() : cooldown(3), AIState<Starfish>() { ; }
 StarfishIdleState::~StarfishIdleState() { ; }
@@ -22,3 +23,11 @@ void StarfishIdleState::OnUpdate(float _elapsed, Starfish& star) {
 
 void StarfishIdleState::OnLeave(Starfish& star) {
 }
+
+void StarfishIdleState::SaveState(BattleSnapshot& snapshot) const {
+  snapshot.Write(cooldown);
+}
+
+void StarfishIdleState::LoadState(BattleSnapshot& snapshot) {
+  snapshot.Read(cooldown);
+}
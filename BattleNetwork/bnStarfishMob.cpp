@@ -3,6 +3,7 @@
 #include "bnField.h"
 #include "bnSpawnPolicy.h"
 #include "bnChipsSpawnPolicy.h"
+#include "bnBattleContext.h"
 
 StarfishMob::StarfishMob(Field* field) : MobFactory(field)
 {
@@ -18,12 +19,12 @@ Mob* StarfishMob::Build() {
   mob->RegisterRankedReward(1, BattleItem(Chip(75, 147, 'R', 30, Element::NONE, "Recov30", "Recover 30HP", "", 1)));
   mob->RegisterRankedReward(11, BattleItem(Chip(81, 153, 'R', 300, Element::NONE, "Recov300", "Recover 300HP", "", 5)));
 
-  mob->Spawn<Rank1<Starfish>>(4 + (rand() % 3), 1);
-  mob->Spawn<Rank1<Starfish>>(4 + (rand() % 3), 3);
+  mob->Spawn<Rank1<Starfish>>(4 + (BattleContext::Rand() % 3), 1);
+  mob->Spawn<Rank1<Starfish>>(4 + (BattleContext::Rand() % 3), 3);
 
-  bool allIce = !(rand() % 10);
+  bool allIce = !(BattleContext::Rand() % 10);
 
-  for (auto t : field->FindTiles([](Battle::Tile* t) { return true; })) {
+  field->ForEachTile([allIce](Battle::Tile* t) {
     if (allIce) {
       t->SetState(TileState::ICE);
     }
@@ -34,7 +35,7 @@ Mob* StarfishMob::Build() {
         }
       }
     }
-  }
+  });
 
   return mob;
 }
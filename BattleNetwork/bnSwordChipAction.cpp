@@ -32,11 +32,6 @@ SwordChipAction::SwordChipAction(Character * owner, int damage) : ChipAction(own
   hiltAttachmentAnim.Reload();
   hiltAttachmentAnim.SetAnimation("HILT");
 
-  overlay.setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(PATH));
-  attachmentAnim = Animation(ANIM);
-  attachmentAnim.Reload();
-  attachmentAnim.SetAnimation("DEFAULT");
-
   element = Element::NONE;
 
   this->OverrideAnimationFrames({ FRAMES });
@@ -51,6 +46,8 @@ SwordChipAction::~SwordChipAction()
   if (hiltAttachment) {
     delete hiltAttachment;
   }
+
+  TEXTURES.ReleaseTexture(PATH);
 }
 
 void SwordChipAction::Execute() {
@@ -1,4 +1,5 @@
 #include "bnTextureResourceManager.h"
+#include "bnVirtualFileSystem.h"
 
 #include <stdlib.h>
 #include <atomic>
@@ -26,8 +27,31 @@ void TextureResourceManager::LoadAllTextures(std::atomic<int> &status) {
 }
 
 Texture* TextureResourceManager::LoadTextureFromFile(string _path) {
+  std::shared_ptr<sf::Image> image;
+
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto iter = cache.find(_path);
+
+    if (iter != cache.end()) {
+      iter->second.refs++;
+      stats.hits++;
+      return iter->second.texture;
+    }
+
+    auto prefetched = decoded.find(_path);
+
+    if (prefetched != decoded.end()) {
+      image = prefetched->second;
+      decoded.erase(prefetched);
+    }
+  }
+
+  // Read and upload without holding the lock so other threads are not blocked on disk
   Texture* texture = new Texture();
-  if (!texture->loadFromFile(_path)) {
+  bool loaded = image ? texture->loadFromImage(*image) : VFS.Load(*texture, _path);
+
+  if (!loaded) {
 
     Logger::GetMutex()->lock();
     Logger::Logf("Failed loading texture: %s", _path.c_str());
@@ -40,9 +64,112 @@ Texture* TextureResourceManager::LoadTextureFromFile(string _path) {
     Logger::GetMutex()->unlock();
 
   }
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  auto iter = cache.find(_path);
+
+  if (iter != cache.end()) {
+    // Another thread loaded the same file first
+    delete texture;
+    iter->second.refs++;
+    stats.hits++;
+    return iter->second.texture;
+  }
+
+  CachedTexture& entry = cache[_path];
+  entry.texture = texture;
+  entry.refs = 1;
+  entry.bytes = (size_t)texture->getSize().x * texture->getSize().y * 4;
+
+  stats.misses++;
+  stats.prefetchHits += image ? 1 : 0;
+  stats.resident++;
+  stats.bytesResident += entry.bytes;
+
   return texture;
 }
 
+void TextureResourceManager::ReleaseTexture(const string& _path) {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  auto iter = cache.find(_path);
+
+  if (iter == cache.end() || iter->second.refs == 0) return;
+
+  iter->second.refs--;
+
+  if (stats.bytesResident > TEXTURE_CACHE_BUDGET) {
+    Trim(TEXTURE_CACHE_BUDGET);
+  }
+}
+
+void TextureResourceManager::PrefetchTexture(const string& _path) {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+
+  if (cache.find(_path) != cache.end() || decoded.find(_path) != decoded.end()) return;
+
+  for (const string& queued : prefetchQueue) {
+    if (queued == _path) return;
+  }
+
+  prefetchQueue.push_back(_path);
+
+  if (!prefetchWorker.joinable()) {
+    prefetchWorker = std::thread(&TextureResourceManager::RunPrefetch, this);
+  }
+
+  prefetchSignal.notify_one();
+}
+
+void TextureResourceManager::TrimTextures() {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  Trim(0);
+  decoded.clear();
+}
+
+const TextureCacheStats TextureResourceManager::GetCacheStats() const {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  return stats;
+}
+
+void TextureResourceManager::RunPrefetch() {
+  std::unique_lock<std::mutex> lock(cacheMutex);
+
+  while (true) {
+    prefetchSignal.wait(lock, [this]() { return stopPrefetch || !prefetchQueue.empty(); });
+
+    if (stopPrefetch) return;
+
+    string path = prefetchQueue.front();
+    prefetchQueue.pop_front();
+
+    // Decoding is the slow part. Do it without the lock.
+    lock.unlock();
+    auto image = std::make_shared<sf::Image>();
+    bool loaded = VFS.Load(*image, path);
+    lock.lock();
+
+    if (loaded && cache.find(path) == cache.end()) {
+      decoded[path] = image;
+    }
+  }
+}
+
+void TextureResourceManager::Trim(size_t budget) {
+  auto iter = cache.begin();
+
+  while (iter != cache.end() && stats.bytesResident > budget) {
+    if (iter->second.refs > 0) {
+      iter++;
+      continue;
+    }
+
+    stats.bytesResident -= iter->second.bytes;
+    stats.resident--;
+    delete iter->second.texture;
+    iter = cache.erase(iter);
+  }
+}
+
 Texture* TextureResourceManager::GetTexture(TextureType _ttype) {
   return textures.at(_ttype);
 }
@@ -58,7 +185,8 @@ sf::IntRect TextureResourceManager::GetIconRectFromID(unsigned ID) {
 
 Font* TextureResourceManager::LoadFontFromFile(string _path) {
   Font* font = new Font();
-  if (!font->loadFromFile(_path)) {
+  // Fonts read their data as glyphs are needed. Packed fonts point into the mapped pack.
+  if (!VFS.Load(*font, _path)) {
     Logger::Logf("Failed loading font: %s", _path.c_str());
   } else {
     Logger::Logf("Loaded font: %s", _path.c_str());
@@ -66,7 +194,7 @@ Font* TextureResourceManager::LoadFontFromFile(string _path) {
   return font;
 }
 
-TextureResourceManager::TextureResourceManager(void) {
+TextureResourceManager::TextureResourceManager(void) : stopPrefetch(false) {
   //-Tiles-
   //Blue tile
   paths.push_back("resources/tiles/tile_atlas_blue.png");
@@ -271,7 +399,19 @@ TextureResourceManager::TextureResourceManager(void) {
 }
 
 TextureResourceManager::~TextureResourceManager(void) {
-  for (auto it = textures.begin(); it != textures.end(); ++it) {
-    delete it->second;
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    stopPrefetch = true;
+  }
+
+  prefetchSignal.notify_one();
+
+  if (prefetchWorker.joinable()) {
+    prefetchWorker.join();
+  }
+
+  // Preloaded textures are in the path cache too
+  for (auto it = cache.begin(); it != cache.end(); ++it) {
+    delete it->second.texture;
   }
 }
@@ -21,6 +21,11 @@
 #include <vector>
 #include <iostream>
 #include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+#include <memory>
 
 using std::cerr;
 using std::endl;
@@ -31,6 +36,18 @@ using sf::Texture;
 using sf::Font;
 using std::string;
 
+// Bytes of textures nobody holds that stay resident before ReleaseTexture() frees them
+#define TEXTURE_CACHE_BUDGET (64*1024*1024)
+
+/*! \brief Counters for textures loaded by path */
+struct TextureCacheStats {
+  unsigned hits{ 0 }; /*!< LoadTextureFromFile() calls that found the texture resident */
+  unsigned misses{ 0 }; /*!< LoadTextureFromFile() calls that had to make the texture */
+  unsigned prefetchHits{ 0 }; /*!< misses that only uploaded an image decoded by PrefetchTexture() */
+  unsigned resident{ 0 }; /*!< textures in memory */
+  size_t bytesResident{ 0 }; /*!< 4 bytes per pixel of every resident texture */
+};
+
 class TextureResourceManager {
 public:
   /**
@@ -48,9 +65,39 @@ public:
   /**
    * @brief Given a file path, returns a pointer to the loaded texture
    * @param _path Relative path to the application
-   * @return Texture pointer. Must manually delete.
+   * @return Texture pointer shared by every caller with the same path.
+   * @warning Do not delete! Call ReleaseTexture() with the same path when done.
+   *
+   * The file is only read the first time. Later calls return the same texture.
+   * Safe to call from any thread.
    */
   Texture* LoadTextureFromFile(string _path);
+
+  /**
+   * @brief Give back a texture from LoadTextureFromFile()
+   * @param _path Path the texture was loaded with
+   *
+   * The texture stays resident so the next load is free. Textures nobody holds
+   * are freed once the resident bytes go over TEXTURE_CACHE_BUDGET.
+   */
+  void ReleaseTexture(const string& _path);
+
+  /**
+   * @brief Read and decode a file on a worker so a later LoadTextureFromFile() only uploads it
+   * @param _path Relative path to the application
+   */
+  void PrefetchTexture(const string& _path);
+
+  /**
+   * @brief Free every texture nobody holds and drop prefetched images
+   */
+  void TrimTextures();
+
+  /**
+   * @brief Cache counters
+   * @return TextureCacheStats
+   */
+  const TextureCacheStats GetCacheStats() const;
   
   /**
    * @brief Returns pointer to the pre-loaded texture type
@@ -82,10 +129,36 @@ public:
   Font* LoadFontFromFile(string _path);
 
 private:
+  /*! \brief A texture loaded by path and how many callers hold it */
+  struct CachedTexture {
+    Texture* texture{ nullptr };
+    unsigned refs{ 0 };
+    size_t bytes{ 0 };
+  };
+
   TextureResourceManager();
   ~TextureResourceManager();
+
+  /**
+   * @brief Prefetch worker. Decodes queued paths until stopped.
+   */
+  void RunPrefetch();
+
+  /**
+   * @brief Free textures nobody holds until the resident bytes are at most budget. Caller holds cacheMutex.
+   */
+  void Trim(size_t budget);
+
   vector<string> paths; /**< Paths to all textures. Must be in order of TextureType @see TextureType */
-  map<TextureType, Texture*> textures; /**< Cache */
+  map<TextureType, Texture*> textures; /**< Preloaded textures. Owned by the path cache. */
+  map<string, CachedTexture> cache; /**< Every texture loaded by path */
+  map<string, std::shared_ptr<sf::Image>> decoded; /**< Prefetched images waiting to be uploaded */
+  std::deque<string> prefetchQueue;
+  mutable std::mutex cacheMutex; /**< Guards the cache, prefetch queue and stats */
+  std::condition_variable prefetchSignal;
+  std::thread prefetchWorker; /**< Started by the first PrefetchTexture() */
+  bool stopPrefetch;
+  TextureCacheStats stats;
 };
 
 /*! \brief Shorthand to get instance of the manager */
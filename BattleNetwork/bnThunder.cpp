@@ -57,9 +57,10 @@ void Thunder::OnUpdate(float _elapsed) {
         return (e->GetTeam() != team && dynamic_cast<Character*>(e) && !dynamic_cast<Obstacle*>(e));
     };
 
-    auto list = field->FindEntities(query);
+    // Keep the closest match without collecting them
+    field->ForEachEntity([&](Entity* l) {
+      if (!query(l)) return;
 
-    for (auto l : list) {
       if (!target) { target = l; }
       else {
         // If the distance to one enemy is shorter than the other, target the shortest enemy path
@@ -70,7 +71,7 @@ void Thunder::OnUpdate(float _elapsed) {
           target = l;
         }
       }
-    }
+    });
   }
 
   // If sliding is flagged to false, we know we've ended a move
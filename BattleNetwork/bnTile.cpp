@@ -25,16 +25,11 @@ namespace Battle {
   float Tile::teamCooldownLength = COOLDOWN;
   float Tile::flickerTeamCooldownLength = FLICKER;
 
-  Tile::Tile(int _x, int _y) : animation() {
+  Tile::Tile(int _x, int _y, Team _team) : animation() {
     totalElapsed = 0;
     x = _x;
     y = _y;
-    if (x <= 3) {
-      team = Team::RED;
-    }
-    else {
-      team = Team::BLUE;
-    }
+    team = _team;
 
     state = TileState::NORMAL;
     elapsed = 0;
@@ -49,6 +44,7 @@ namespace Battle {
     brokenCooldown = 0;
     flickerTeamCooldown = teamCooldown = 0;
     red_team_atlas = blue_team_atlas = nullptr; // Set by field
+    field = nullptr; // Set by field
 
     burncycle = 0.12; // milliseconds
     elapsedBurnTime = burncycle;
@@ -60,6 +56,7 @@ namespace Battle {
   {
     x = other.x;
     y = other.y;
+    field = other.field;
 
     totalElapsed = other.totalElapsed;
     team = other.team;
@@ -97,6 +94,7 @@ namespace Battle {
   {
     x = other.x;
     y = other.y;
+    field = other.field;
 
     totalElapsed = other.totalElapsed;
     team = other.team;
@@ -161,9 +159,9 @@ namespace Battle {
   void Tile::SetTeam(Team _team, bool useFlicker) {
     // Check if no characters on the opposing team are on this tile
     if (this->GetTeam() == Team::UNKNOWN || this->GetTeam() != _team) {
-      size_t size = this->FindEntities([this](Entity* in) {
+      size_t size = std::count_if(entities.begin(), entities.end(), [this](Entity* in) {
         return in->GetTeam() == this->GetTeam();
-      }).size();
+      });
 
       if (size == 0 && this->reserved.size() == 0) {
         team = _team;
@@ -252,7 +250,7 @@ namespace Battle {
 
   bool Tile::IsEdgeTile() const
   {
-    return GetX() == 0 || GetX() == 7 || GetY() == 0 || GetY() == 4;
+    return GetX() == 0 || GetX() == field->GetWidth() + 1 || GetY() == 0 || GetY() == field->GetHeight() + 1;
   }
 
   bool Tile::IsHighlighted() const {
@@ -276,6 +274,7 @@ namespace Battle {
   {
     if (!ContainsEntity(&_entity)) {
       characters.push_back(&_entity);
+      field->CountCharacter(x, _entity.GetTeam(), 1);
       this->AddEntity(&_entity);
     }
   }
@@ -351,6 +350,7 @@ namespace Battle {
     }
 
     if (itChar != characters.end()) {
+      field->CountCharacter(x, (*itChar)->GetTeam(), -1);
       characters.erase(itChar);
     }
 
@@ -447,11 +447,14 @@ namespace Battle {
           Character* character = dynamic_cast<Character*>(ptr);
 
           // We only want to know about character deletions since they are the actors in the battle
+          // The event bus frees the character after listeners hear about it
           if (character) {
-            this->field->CharacterDeletePublisher::Broadcast(*character);
+            this->field->GetEventBus().Post(*this->field, *character);
+          }
+          else {
+            this->field->ReleaseEntity(ptr);
           }
 
-          delete ptr;
           continue;
         }
       }
@@ -480,12 +483,16 @@ namespace Battle {
       // Now that spells and characters have updated and moved, they are due to check for attack outcomes
       for (auto ID : queuedSpells) {
         // TODO: REDO THIS LOOP. IT IS HORRIBLE AND COSTLY!
-        auto list = field->FindEntities([ID](Entity* e) {
-          return e->GetID() == ID;
+        Entity* found = nullptr;
+
+        field->ForEachEntity([ID, &found](Entity* e) {
+          if (!found && e->GetID() == ID) {
+            found = e;
+          }
         });
 
-        if (list.size()) {
-          auto spell = dynamic_cast<Spell*>(list[0]);
+        if (found) {
+          auto spell = dynamic_cast<Spell*>(found);
           this->PerformSpellAttack(spell);
         }
       }
@@ -659,7 +666,9 @@ namespace Battle {
 
   std::string Tile::GetAnimState(const TileState state)
   {
-    std::string str = "row_" + std::to_string(4 - GetY()) + "_";
+    // The atlas has art for the top, middle and bottom rows
+    int row = GetY() == 1 ? 3 : (GetY() == field->GetHeight() ? 1 : 2);
+    std::string str = "row_" + std::to_string(row) + "_";
 
     switch (state) {
     case TileState::BROKEN:
@@ -708,7 +717,7 @@ namespace Battle {
       str = str + "normal";
     }
 
-    if (GetX() == 0 || GetX() == 7 || GetY() == 0 || GetY() == 4) {
+    if (IsEdgeTile()) {
       str = "row_1_normal";
     }
 
@@ -49,14 +49,12 @@ namespace Battle {
 
     friend Field::Field(int _width, int _height);
     friend void Field::Update(float _elapsed);
+    friend class ::BattleSnapshot;
 
     /**
-    * \brief Base 1. Creates a tile at column x and row y.
-    * 
-    * If the tile column is <= 3, the tile's team is
-    * automatically RED. Otherwise it is BLUE.
+    * \brief Base 1. Creates a tile at column x and row y that starts on team.
     */
-    Tile(int _x, int _y);
+    Tile(int _x, int _y, Team _team);
     ~Tile();
 
     Tile(const Tile& rhs);
@@ -254,6 +252,17 @@ namespace Battle {
      */
     std::vector<Entity*> FindEntities(std::function<bool(Entity*e)> query);
 
+    /**
+     * @brief Visit every entity occupying this tile. Nothing is allocated.
+     * @param visit called with each Entity*. Must not add or remove entities.
+     */
+    template<typename F>
+    void ForEachEntity(F&& visit) {
+      for (Entity* entity : entities) {
+        visit(entity);
+      }
+    }
+
   private:
     /**
     * @brief Attack all entities occupying this tile with spell
@@ -322,4 +331,51 @@ namespace Battle {
 
     return false;
   }
-}
\ No newline at end of file
+}
+
+template<typename F>
+void Field::ForEachTile(F&& visit) {
+  for (Battle::Tile& tile : tiles) {
+    visit(&tile);
+  }
+}
+
+template<typename F>
+void Field::ForEachEntity(F&& visit) {
+  // Edge tiles are never occupied
+  for (int y = 1; y <= height; y++) {
+    for (int x = 1; x <= width; x++) {
+      At(x, y).ForEachEntity(visit);
+    }
+  }
+}
+
+template<typename F>
+void Field::FindTiles(std::vector<Battle::Tile*>& out, F&& query) {
+  out.clear();
+
+  for (Battle::Tile& tile : tiles) {
+    if (query(&tile)) {
+      out.push_back(&tile);
+    }
+  }
+}
+
+template<typename F>
+void Field::FindEntities(std::vector<Entity*>& out, F&& query) {
+  out.clear();
+
+  ForEachEntity([&out, &query](Entity* entity) {
+    if (query(entity)) {
+      out.push_back(entity);
+    }
+  });
+}
+
+inline Battle::Tile& Field::At(int _x, int _y) {
+  return tiles[(size_t)_y * (width + 2) + _x];
+}
+
+inline const Battle::Tile& Field::At(int _x, int _y) const {
+  return tiles[(size_t)_y * (width + 2) + _x];
+}
@@ -34,6 +34,7 @@ TornadoChipAction::TornadoChipAction(Character * owner, int damage)
 
 TornadoChipAction::~TornadoChipAction()
 {
+  TEXTURES.ReleaseTexture(FAN_PATH);
 }
 
 void TornadoChipAction::Execute() {
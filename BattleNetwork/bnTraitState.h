@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * @class TraitState
+ * @author mav
+ * @date 10/19/20
+ * @brief Resets the per-thread state every trait keeps between instances
+ *
+ * Traits like TurnOrderTrait keep static lists for each type that uses them. The
+ * lists are thread local so battles on different threads do not share them, but a
+ * thread runs many battles one after another. Each trait type registers a reset the
+ * first time it is used on a thread and BattleContext resets them all so no battle
+ * inherits state from the last one.
+ */
+class TraitState {
+public:
+  using Reset = void(*)();
+
+  /**
+   * @brief Remember a reset for this thread
+   * @param reset clears one trait type's state
+   */
+  static void Register(Reset reset) {
+    Resets().push_back(reset);
+  }
+
+  /**
+   * @brief Clear every trait type used on this thread
+   */
+  static void ResetAll() {
+    for (Reset reset : Resets()) {
+      reset();
+    }
+  }
+
+private:
+  static std::vector<Reset>& Resets() {
+    static thread_local std::vector<Reset> resets;
+    return resets;
+  }
+};
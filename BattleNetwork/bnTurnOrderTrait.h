@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include "bnTraitState.h"
 
 using namespace std;
 
@@ -9,6 +11,11 @@ class TurnOrderTrait {
 protected:
 
   TurnOrderTrait() {
+    if (!registered) {
+      registered = true;
+      TraitState::Register(&ResetTurnOrder);
+    }
+
     myTurnID = (long)IDs.size();
     IDs.push_back(myTurnID);
   };
@@ -51,13 +58,22 @@ protected:
   }
 
 private:
-  static vector<long> IDs; /*!< list of types spawned to take turns */
-  static int currIndex; /*!< current active entity ID */
+  static void ResetTurnOrder() {
+    IDs.clear();
+    currIndex = 0;
+  }
+
+  static thread_local vector<long> IDs; /*!< list of types spawned to take turns */
+  static thread_local int currIndex; /*!< current active entity ID */
+  static thread_local bool registered; /*!< reset registered with TraitState on this thread */
   long myTurnID; /*!< This entity's turn ID */
 };
 
-template<typename T> vector<long>
+template<typename T> thread_local vector<long>
 TurnOrderTrait<T>::IDs = vector<long>();
 
-template<typename T> int
-TurnOrderTrait<T>::currIndex = 0;
\ No newline at end of file
+template<typename T> thread_local int
+TurnOrderTrait<T>::currIndex = 0;
+
+template<typename T> thread_local bool
+TurnOrderTrait<T>::registered = false;
@@ -2,6 +2,7 @@
 #include "bnField.h"
 #include "bnSpawnPolicy.h"
 #include "bnChipsSpawnPolicy.h"
+#include "bnBattleContext.h"
 
 TwoMettaurMob::TwoMettaurMob(Field* field) : MobFactory(field)
 {
@@ -27,7 +28,7 @@ Mob* TwoMettaurMob::Build() {
   int count = 2;
 
   // place a hole somewhere
-  field->GetAt( 4 + (rand() % 3), 1 + (rand() % 3))->SetState(TileState::EMPTY);
+  field->GetAt( 4 + (BattleContext::Rand() % 3), 1 + (BattleContext::Rand() % 3))->SetState(TileState::EMPTY);
 
   while (count > 0) {
     for (int i = 0; i < field->GetWidth(); i++) {
@@ -67,7 +68,7 @@ Mob* TwoMettaurMob::Build() {
         }*/
 
         if (tile->IsWalkable() && tile->GetTeam() == Team::BLUE) {
-          if (rand() % 50 > 25 && count-- > 0)
+          if (BattleContext::Rand() % 50 > 25 && count-- > 0)
             mob->Spawn<Rank1<Mettaur>>(i + 1, j + 1);
         }
       }
@@ -10,8 +10,9 @@
 #define COMPONENT_FRAME_COUNT 2
 #define COMPONENT_WIDTH 240
 #define COMPONENT_HEIGHT 160
+#define TEXTURE_PATH "resources/backgrounds/undernet/bg.png"
 UndernetBackground::UndernetBackground(void)
-  : progress(0.0f), Background(*TEXTURES.LoadTextureFromFile("resources/backgrounds/undernet/bg.png"), 240, 180) {
+  : progress(0.0f), Background(TEXTURE_PATH, 240, 180) {
   FillScreen(sf::Vector2u(COMPONENT_WIDTH, COMPONENT_HEIGHT));
   colorIndex = 0;
 
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+
+#include "bnVirtualFileSystem.h"
+#include "bnLogger.h"
+#include <SFML/System/FileInputStream.hpp>
+
+namespace {
+  const char PACK_MAGIC[4] = { 'O', 'B', 'N', 'P' };
+
+  /*
+  Pack layout. Integers are little endian.
+
+  PackHeader
+  PackEntry [entryCount]  sorted by path
+  char      [pathBytes]   every path, not terminated
+  padding                 to RESOURCE_PACK_ALIGNMENT
+  file contents           each one starts on RESOURCE_PACK_ALIGNMENT
+  */
+  struct PackHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t pathBytes;
+  };
+
+  struct PackEntry {
+    std::uint32_t pathOffset, pathLength;
+    std::uint64_t offset, size; /*!< from the start of the pack */
+  };
+
+  static_assert(sizeof(PackHeader) == 16 && sizeof(PackEntry) == 24, "pack records must be packed");
+
+  const size_t Align(size_t value) {
+    return (value + (RESOURCE_PACK_ALIGNMENT - 1)) & ~(size_t)(RESOURCE_PACK_ALIGNMENT - 1);
+  }
+}
+
+VirtualFileSystem& VirtualFileSystem::GetInstance() {
+  static VirtualFileSystem instance;
+  return instance;
+}
+
+VirtualFileSystem::VirtualFileSystem() : index(nullptr), paths(nullptr), entries(0), fileOpens(0), packReads(0), bytesRead(0) {
+}
+
+const bool VirtualFileSystem::Mount(const std::string& path) {
+  if (!pack.Open(path) || pack.GetSize() < sizeof(PackHeader)) {
+    pack.Close();
+    return false;
+  }
+
+  const char* data = pack.GetData();
+  const PackHeader* header = reinterpret_cast<const PackHeader*>(data);
+
+  size_t indexAt = sizeof(PackHeader);
+  size_t pathsAt = indexAt + (sizeof(PackEntry) * (size_t)header->entryCount);
+
+  bool valid = std::memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) == 0
+    && header->version == RESOURCE_PACK_VERSION
+    && pathsAt + header->pathBytes <= pack.GetSize();
+
+  // Every entry must point inside the pack
+  for (std::uint32_t i = 0; valid && i < header->entryCount; i++) {
+    const PackEntry* entry = reinterpret_cast<const PackEntry*>(data + indexAt) + i;
+    valid = (size_t)entry->pathOffset + entry->pathLength <= header->pathBytes
+      && entry->offset + entry->size <= pack.GetSize();
+  }
+
+  if (!valid) {
+    Logger::GetMutex()->lock();
+    Logger::Logf("Resource pack %s is not valid. Using loose files.", path.c_str());
+    Logger::GetMutex()->unlock();
+
+    pack.Close();
+    return false;
+  }
+
+  index = data + indexAt;
+  paths = data + pathsAt;
+  entries = header->entryCount;
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Mounted resource pack %s: %u files", path.c_str(), entries);
+  Logger::GetMutex()->unlock();
+
+  return true;
+}
+
+const bool VirtualFileSystem::IsMounted() const {
+  return index != nullptr;
+}
+
+const bool VirtualFileSystem::Find(const std::string& path, const char*& data, size_t& size) const {
+  if (!index) return false;
+
+  std::string normalized;
+  std::string_view key = path;
+
+  // Packed paths use forward slashes and no leading ./
+  if (key.find('\\') != std::string_view::npos) {
+    normalized = path;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    key = normalized;
+  }
+
+  while (key.compare(0, 2, "./") == 0) {
+    key.remove_prefix(2);
+  }
+
+  const PackEntry* first = reinterpret_cast<const PackEntry*>(index);
+  const PackEntry* last = first + entries;
+
+  const PackEntry* found = std::lower_bound(first, last, key, [this](const PackEntry& entry, std::string_view value) {
+    return std::string_view(paths + entry.pathOffset, entry.pathLength) < value;
+  });
+
+  if (found == last || std::string_view(paths + found->pathOffset, found->pathLength) != key) {
+    return false;
+  }
+
+  data = pack.GetData() + found->offset;
+  size = (size_t)found->size;
+
+  packReads++;
+  bytesRead += size;
+
+  return true;
+}
+
+const bool VirtualFileSystem::Read(const std::string& path, std::vector<char>& out) {
+  const char* data = nullptr;
+  size_t size = 0;
+
+  if (Find(path, data, size)) {
+    out.assign(data, data + size);
+    return size > 0;
+  }
+
+  sf::FileInputStream in;
+
+  if (!in.open(path) || in.getSize() <= 0) {
+    CountOpen(0);
+    out.clear();
+    return false;
+  }
+
+  out.resize((size_t)in.getSize());
+  in.read(out.data(), (sf::Int64)out.size());
+
+  CountOpen(out.size());
+  return true;
+}
+
+std::string VirtualFileSystem::ReadString(const std::string& path) {
+  const char* data = nullptr;
+  size_t size = 0;
+
+  if (Find(path, data, size)) {
+    return std::string(data, size);
+  }
+
+  sf::FileInputStream in;
+
+  if (!in.open(path) || in.getSize() <= 0) {
+    CountOpen(0);
+    return std::string();
+  }
+
+  std::string contents((size_t)in.getSize(), '\0');
+  in.read(&contents[0], (sf::Int64)contents.size());
+
+  CountOpen(contents.size());
+  return contents;
+}
+
+const VirtualFileStats VirtualFileSystem::GetStats() const {
+  VirtualFileStats stats;
+  stats.fileOpens = fileOpens;
+  stats.packReads = packReads;
+  stats.bytesRead = bytesRead;
+  return stats;
+}
+
+void VirtualFileSystem::CountOpen(size_t bytes) {
+  fileOpens++;
+  bytesRead += bytes;
+}
+
+const unsigned VirtualFileSystem::Build(const std::string& root, const std::string& path) {
+  std::vector<std::string> files;
+  std::error_code error;
+
+  for (auto& entry : std::filesystem::recursive_directory_iterator(root, error)) {
+    if (!entry.is_regular_file(error)) continue;
+
+    std::string file = entry.path().generic_string();
+
+    // Do not pack an old pack that lives under root
+    if (std::filesystem::equivalent(entry.path(), path, error)) continue;
+
+    files.push_back(file);
+  }
+
+  if (files.empty()) return 0;
+
+  std::sort(files.begin(), files.end());
+
+  PackHeader header;
+  std::memcpy(header.magic, PACK_MAGIC, sizeof(header.magic));
+  header.version = RESOURCE_PACK_VERSION;
+  header.entryCount = (std::uint32_t)files.size();
+  header.pathBytes = 0;
+
+  std::vector<PackEntry> entries(files.size());
+  std::string pathBytes;
+
+  for (size_t i = 0; i < files.size(); i++) {
+    entries[i].pathOffset = (std::uint32_t)pathBytes.size();
+    entries[i].pathLength = (std::uint32_t)files[i].size();
+    pathBytes += files[i];
+  }
+
+  header.pathBytes = (std::uint32_t)pathBytes.size();
+
+  size_t offset = Align(sizeof(PackHeader) + (sizeof(PackEntry) * entries.size()) + pathBytes.size());
+
+  for (size_t i = 0; i < files.size(); i++) {
+    entries[i].offset = offset;
+    entries[i].size = std::filesystem::file_size(files[i], error);
+
+    if (error) return 0;
+
+    offset = Align(offset + (size_t)entries[i].size);
+  }
+
+  std::FILE* out = std::fopen(path.c_str(), "wb");
+
+  if (!out) return 0;
+
+  std::fwrite(&header, sizeof(header), 1, out);
+  std::fwrite(entries.data(), sizeof(PackEntry), entries.size(), out);
+  std::fwrite(pathBytes.data(), 1, pathBytes.size(), out);
+
+  const char zeros[RESOURCE_PACK_ALIGNMENT] = { 0 };
+  std::vector<char> buffer;
+  bool ok = true;
+
+  for (size_t i = 0; i < files.size() && ok; i++) {
+    long at = std::ftell(out);
+    std::fwrite(zeros, 1, (size_t)(entries[i].offset - (std::uint64_t)at), out);
+
+    std::FILE* in = std::fopen(files[i].c_str(), "rb");
+    ok = in != nullptr;
+
+    if (ok) {
+      buffer.resize((size_t)entries[i].size);
+      ok = std::fread(buffer.data(), 1, buffer.size(), in) == buffer.size();
+      ok = ok && std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+      std::fclose(in);
+    }
+  }
+
+  std::fclose(out);
+
+  return ok ? (unsigned)files.size() : 0;
+}
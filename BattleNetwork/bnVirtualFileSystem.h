@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "bnMappedFile.h"
+
+// File the game looks for next to resources/ at startup
+#define RESOURCE_PACK_PATH "resources.pak"
+#define RESOURCE_PACK_VERSION 1
+
+// Every file in the pack starts on this boundary
+#define RESOURCE_PACK_ALIGNMENT 16
+
+/*! \brief How files were found since startup */
+struct VirtualFileStats {
+  unsigned fileOpens{ 0 }; /*!< files opened on disk */
+  unsigned packReads{ 0 }; /*!< files found in the pack */
+  size_t bytesRead{ 0 }; /*!< bytes handed out from either */
+};
+
+/**
+ * @class VirtualFileSystem
+ * @author mav
+ * @date 10/19/20
+ * @brief Reads game files from one mapped resource pack and falls back to loose files
+ *
+ * A pack is every file under resources/ in one file: a header, an index sorted by
+ * path and the file contents, each aligned to RESOURCE_PACK_ALIGNMENT. Once mounted,
+ * finding a file is a binary search over the index and reading it is a pointer into
+ * the mapped pack. No file is opened and nothing is copied.
+ *
+ * Files that are not in the pack, or every file when no pack is mounted, are read from
+ * disk as before. Rebuild the pack with the BattleNetworkPack tool after changing
+ * resources, or delete it to work from loose files.
+ *
+ * Resources loaded with Load() can keep pointing into the pack, so the pack is
+ * never unmounted while the game runs.
+ */
+class VirtualFileSystem {
+public:
+  /**
+   * @brief If this is the first call, initializes the file system.
+   * @return Returns reference to the virtual file system.
+   */
+  static VirtualFileSystem& GetInstance();
+
+  /**
+   * @brief Map a pack and serve its files from now on
+   * @param path to the pack
+   * @return false if there is no valid pack at path. Loose files are used.
+   */
+  const bool Mount(const std::string& path);
+
+  const bool IsMounted() const;
+
+  /**
+   * @brief Find a file in the pack. Safe from any thread.
+   * @param path relative path from application to file
+   * @param data set to the first byte of the file in the pack
+   * @param size set to the size of the file
+   * @return false if the file is not in the pack
+   */
+  const bool Find(const std::string& path, const char*& data, size_t& size) const;
+
+  /**
+   * @brief Read a whole file from the pack or from disk
+   * @param path relative path from application to file
+   * @param out replaced with the contents of the file
+   * @return false if the file could not be found or is empty
+   */
+  const bool Read(const std::string& path, std::vector<char>& out);
+
+  /**
+   * @brief Read a whole text file from the pack or from disk
+   * @param path relative path from application to file
+   * @return contents or an empty string
+   */
+  std::string ReadString(const std::string& path);
+
+  /**
+   * @brief Load an SFML resource with loadFromMemory() when the file is in the pack
+   * @param resource sf::Texture, sf::Image, sf::SoundBuffer, sf::Font...
+   * @param path relative path from application to file
+   * @return result of the load
+   */
+  template<typename T>
+  const bool Load(T& resource, const std::string& path) {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    if (Find(path, data, size)) {
+      return resource.loadFromMemory(data, size);
+    }
+
+    CountOpen(0);
+    return resource.loadFromFile(path);
+  }
+
+  const VirtualFileStats GetStats() const;
+
+  /**
+   * @brief Write every file under root into a pack
+   * @param root directory to pack. Paths in the pack start with it, e.g. resources/ui/mouse.png
+   * @param path pack to write
+   * @return number of files packed. 0 on failure.
+   */
+  static const unsigned Build(const std::string& root, const std::string& path);
+
+private:
+  VirtualFileSystem();
+  ~VirtualFileSystem() = default;
+
+  void CountOpen(size_t bytes);
+
+  MappedFile pack;
+  const char* index; /*!< first entry in the mapped index */
+  const char* paths; /*!< path bytes in the mapped pack */
+  unsigned entries;
+  mutable std::atomic<unsigned> fileOpens, packReads;
+  mutable std::atomic<size_t> bytesRead;
+};
+
+#define VFS VirtualFileSystem::GetInstance()
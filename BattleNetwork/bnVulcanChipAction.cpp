@@ -30,6 +30,7 @@ VulcanChipAction::VulcanChipAction(Character * owner, int damage) : ChipAction(o
 
 VulcanChipAction::~VulcanChipAction()
 {
+  TEXTURES.ReleaseTexture(PATH);
 }
 
 void VulcanChipAction::Execute() {
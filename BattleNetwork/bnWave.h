@@ -16,7 +16,7 @@ public:
   Wave(Field* _field, Team _team, double speed = 1.0);
   ~Wave();
 
-  static int numOf;
+  static thread_local int numOf;
 
   virtual void OnUpdate(float _elapsed);
   virtual bool Move(Direction _direction);
@@ -31,6 +31,7 @@ YoYoChipAction::YoYoChipAction(Character * owner, int damage) : ChipAction(owner
 
 YoYoChipAction::~YoYoChipAction()
 {
+  TEXTURES.ReleaseTexture(NODE_PATH);
 }
 
 void YoYoChipAction::Execute() {
@@ -28,18 +28,36 @@
 #include "bnAnimator.h"
 #include "bnConfigReader.h"
 #include "bnConfigScene.h"
+#include "bnOverworldLightGrid.h"
+#include "bnReplayManager.h"
+#include "bnBattleSnapshot.h"
+#include "bnBattleServer.h"
+#include "bnVirtualFileSystem.h"
+#include "bnScriptResourceManager.h"
 #include "SFML/System.hpp"
 
 #include <time.h>
 #include <queue>
 #include <atomic>
 #include <cmath>
+#include <cstdlib>
+#include <algorithm>
 #include <Swoosh/ActivityController.h>
 #include <Swoosh/Ease.h>
 
 #define OBN_REGION_JAPAN 0
 #define OBN_ENABLE_PIXELATE_GFX 0
 
+// Keep sfx compressed in memory and decode on first play.
+// Useful for low-RAM cabinets
+#define OBN_ENABLE_SOUND_BANK 0
+
+// Log the cost of lighting a full screen of overworld tiles at startup
+#define OBN_BENCHMARK_OVERWORLD_LIGHTING 0
+
+// Log the cost of saving and restoring a full battle field every frame
+#define OBN_BENCHMARK_BATTLE_SNAPSHOT 0
+
 // Engine addons
 #include "bnQueueNaviRegistration.h"
 #include "bnQueueMobRegistration.h"
@@ -62,6 +80,9 @@ using swoosh::ActivityController;
 // GBA draws 60 frames in one seconds
 #define FIXED_TIME_STEP 1.0f/60.0f
 
+// Wall time since the process started. Startup I/O is reported against it.
+Clock startupClock;
+
 /*! \brief This thread initializes all navis
  * 
  * Uses an std::atomic<int> pointer 
@@ -95,6 +116,10 @@ void RunNaviInit(std::atomic<int>* progress) {
  * against.
  */
 void RunMobInit(std::atomic<int>* progress) {
+  // Mobs may be made of scripted characters. Scripts log their own load time.
+  std::atomic<int> scriptsLoaded{ 0 };
+  SCRIPTS.LoadAllSCripts(scriptsLoaded);
+
   clock_t begin_time = clock();
 
   MOBS.LoadAllMobs(*progress);
@@ -104,6 +129,19 @@ void RunMobInit(std::atomic<int>* progress) {
   Logger::GetMutex()->unlock();
 }
 
+/*! \brief Log what startup read from disk and the resource pack
+ *
+ * Call after every loader thread has been joined so no read is still in flight
+ */
+void LogStartupIO() {
+  const VirtualFileStats io = VFS.GetStats();
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Startup I/O: %u files opened, %u read from the resource pack, %u KiB, %f secs",
+    io.fileOpens, io.packReads, (unsigned)(io.bytesRead / 1024), startupClock.getElapsedTime().asSeconds());
+  Logger::GetMutex()->unlock();
+}
+
 /*! \brief This thread loads textures and shaders
  * 
  * Uses and std::atomic<int> pointer to keep
@@ -171,6 +209,29 @@ void AppLoseFocus() {
 }
 
 int main(int argc, char** argv) {
+  // --record-replays <dir> saves every battle to dir
+  // --replays <dir> plays every replay in dir as fast as possible, prints frame times, and exits
+  // --server <battles> runs that many headless battles on 1 to every core, prints throughput, and exits
+  std::string replayDir;
+  unsigned serverBattles = 0;
+
+  for (int i = 1; i + 1 < argc; i++) {
+    std::string arg = argv[i];
+
+    if (arg == "--record-replays") {
+      REPLAYS.EnableRecording(argv[++i]);
+    }
+    else if (arg == "--replays") {
+      replayDir = argv[++i];
+    }
+    else if (arg == "--server") {
+      serverBattles = (unsigned)std::max(0, std::atoi(argv[++i]));
+    }
+  }
+
+  // Serve resources from the pack when there is one so loaders do not open loose files
+  VFS.Mount(RESOURCE_PACK_PATH);
+
   // Initialize the engine and log the startup time
   const clock_t begin_time = clock();
   ENGINE.Initialize();
@@ -184,6 +245,14 @@ int main(int argc, char** argv) {
   TEXTURES;
   SHADERS;
   AUDIO;
+
+#if OBN_ENABLE_SOUND_BANK
+  AUDIO.EnableSoundBank(true);
+#endif
+
+#if OBN_BENCHMARK_OVERWORLD_LIGHTING
+  Overworld::LightGrid::RunBenchmark(64, 600);
+#endif
   QueuNaviRegistration(); // Queues navis to be loaded later
   QueueMobRegistration(); // Queues mobs to be loaded later
 
@@ -227,11 +296,13 @@ int main(int argc, char** argv) {
 
   // Title screen logo based on region
 #if OBN_REGION_JAPAN
-  sf::Texture* logo = TEXTURES.LoadTextureFromFile("resources/backgrounds/title/tile.png");
+  const std::string logoPath = "resources/backgrounds/title/tile.png";
 #else
-  sf::Texture* logo = TEXTURES.LoadTextureFromFile("resources/backgrounds/title/tile_en.png");
+  const std::string logoPath = "resources/backgrounds/title/tile_en.png";
 #endif
 
+  sf::Texture* logo = TEXTURES.LoadTextureFromFile(logoPath);
+
   SpriteSceneNode logoSprite;
 
   logoSprite.setTexture(*logo);
@@ -367,6 +438,15 @@ int main(int argc, char** argv) {
   RunGraphicsInit(&progress);
   ENGINE.SetShader(nullptr);
 
+  // Draw with every shader now, on the surface and thread the game draws with,
+  // so effects first used mid-battle don't hitch
+  sf::Clock warmUpClock;
+  SHADERS.WarmUpShaders(loadSurface);
+
+  Logger::GetMutex()->lock();
+  Logger::Logf("Warmed up shaders: %f secs", warmUpClock.getElapsedTime().asSeconds());
+  Logger::GetMutex()->unlock();
+
 #ifdef __ANDROID__
   loadSurface.setDefaultShader(&LOAD_SHADER(DEFAULT));
 #endif
@@ -387,6 +467,7 @@ int main(int argc, char** argv) {
   bool inLoadState = true;
   bool ready = false;
   bool loadMobs = false;
+  bool loadersJoined = false;
   bool pressedStart = false;
 
   int selected = 0; // menu options are CONTINUE (0) and CONFIGURE (1)
@@ -604,6 +685,19 @@ int main(int argc, char** argv) {
             ENGINE.Draw(mobLoadedLabel);
           }
         }
+        else if (!loadersJoined) {
+          // Every loader has reported done. Join them all before counting startup I/O.
+          audioLoad.wait();
+          navisLoad.wait();
+          mobsLoad.wait();
+
+          loadersJoined = true;
+          LogStartupIO();
+        }
+        else if (!replayDir.empty() || serverBattles > 0) {
+          // Benchmark mode does not wait for the player
+          inLoadState = false;
+        }
         else {
           // Finally everything is loaded
 
@@ -727,7 +821,7 @@ int main(int argc, char** argv) {
 
   //delete logLabel;
   //delete font;
-  delete logo;
+  TEXTURES.ReleaseTexture(logoPath);
 
   // Stop music and go to menu screen
   AUDIO.StopStream();
@@ -737,6 +831,34 @@ int main(int argc, char** argv) {
   // The activity controller uses a virtual window
   // To draw screen transitions onto
   sf::Vector2u virtualWindowSize(480, 320);
+
+#if OBN_BENCHMARK_BATTLE_SNAPSHOT
+  BattleSnapshot::RunBenchmark(600);
+#endif
+
+  if (!replayDir.empty()) {
+    int failed = REPLAYS.RunBenchmark(replayDir, virtualWindowSize, FIXED_TIME_STEP);
+
+    TEXTURES.ReleaseTexture("resources/ui/mouse.png");
+    delete logLabel;
+    delete font;
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+
+  if (serverBattles > 0) {
+    // Headless battles have nothing to hear
+    AUDIO.EnableAudio(false);
+
+    BattleServer::RunBenchmark(serverBattles);
+
+    TEXTURES.ReleaseTexture("resources/ui/mouse.png");
+    delete logLabel;
+    delete font;
+
+    return EXIT_SUCCESS;
+  }
+
   ActivityController app(*ENGINE.GetWindow(), virtualWindowSize);
 
   // The last screen the player will see is the game over screen
@@ -783,6 +905,9 @@ int main(int argc, char** argv) {
       // Use the activity controller to update and draw scenes
       app.update((float) FIXED_TIME_STEP);
 
+      // Step music crossfades
+      AUDIO.UpdateStream((float) FIXED_TIME_STEP);
+
       sf::Vector2f mousepos = ENGINE.GetWindow()->mapPixelToCoords(sf::Mouse::getPosition(*ENGINE.GetWindow()));
       mouseAlpha -= FIXED_TIME_STEP;
       mouseAlpha = std::max(0.0, mouseAlpha);
@@ -820,7 +945,7 @@ int main(int argc, char** argv) {
       ENGINE.GetWindow()->display();
 
   }
-  delete mouseTexture;
+  TEXTURES.ReleaseTexture("resources/ui/mouse.png");
   delete logLabel;
   delete font;
 
@@ -0,0 +1,42 @@
+/*! \brief Packs every file under resources/ into one resource pack
+ *
+ * Built as the BattleNetworkPack target and run by the ResourcePack target.
+ * Run it from the BattleNetwork directory.
+ *
+ *   BattleNetworkPack [root] [pack]
+ *
+ * root defaults to resources and pack to resources.pak, which the game mounts
+ * at startup. Compile animations first so the pack carries the compiled copies.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "bnVirtualFileSystem.h"
+
+int main(int argc, char** argv) {
+  std::string root = argc > 1 ? argv[1] : "resources";
+  std::string path = argc > 2 ? argv[2] : RESOURCE_PACK_PATH;
+
+  auto start = std::chrono::steady_clock::now();
+
+  unsigned files = VirtualFileSystem::Build(root, path);
+
+  auto end = std::chrono::steady_clock::now();
+
+  if (files == 0) {
+    std::cerr << "failed to pack " << root << " into " << path << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::error_code error;
+
+  std::cout << "packed " << files << " files from " << root << " into " << path
+    << " (" << std::filesystem::file_size(path, error) / 1024 << " KiB) in "
+    << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -1,7 +1,8 @@
 #version 120
 
 uniform sampler2D texture;
-uniform sampler2D palette;
+uniform sampler2D palette; // Every palette, one per row
+uniform float paletteRow;  // Texture coordinate of the row to read colors from
 
 void main()
 {
@@ -9,7 +10,7 @@ void main()
     vec4 color = vec4(0.299*pixel.r,0.587*pixel.g,0.114*pixel.b,pixel.a);
     float lum = color.r+color.g+color.b;
 
-    color = texture2D(palette, vec2(pixel.r,0));
+    color = texture2D(palette, vec2(pixel.r, paletteRow));
     color.a = color.a * gl_Color.a;
     gl_FragColor = color;
-}
\ No newline at end of file
+}